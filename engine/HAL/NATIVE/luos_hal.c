@@ -16,12 +16,52 @@
 pthread_mutex_t mutex_msg_alloc = PTHREAD_MUTEX_INITIALIZER;
 pthread_mutex_t mutex_luos      = PTHREAD_MUTEX_INITIALIZER;
 
+// Event management
+static pthread_mutex_t mutex_event = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond_event   = PTHREAD_COND_INITIALIZER;
+static bool event_pending          = false; // An event occured since the last wait
+static volatile bool event_driven  = false; // The application wait for events by itself
+
+#ifdef LUOS_WORKER_NB
+// Worker management
+typedef struct
+{
+    WORKER_JOB job;
+    void *arg;
+    uint8_t data[LUOS_WORKER_DATA_SIZE];
+} worker_item_t;
+
+typedef struct
+{
+    worker_item_t items[LUOS_WORKER_QUEUE_SIZE];
+    uint16_t head;  // Oldest item of the queue
+    uint16_t nb;    // Number of items in the queue
+    int16_t worker; // Worker pinned to this queue, -1 for any worker
+    bool running;   // A worker is running the oldest item
+} worker_queue_t;
+
+static pthread_mutex_t mutex_worker = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond_worker   = PTHREAD_COND_INITIALIZER; // Something to do for workers
+static pthread_cond_t cond_core     = PTHREAD_COND_INITIALIZER; // Room in the core queue
+static worker_queue_t worker_queue[LUOS_WORKER_QUEUE_NB];
+static worker_queue_t core_queue;
+static uint16_t worker_next_queue   = 0;  // Round robin start of the queue election
+static bool worker_started          = false;
+static __thread int16_t worker_self = -1; // Worker index of the current thread, -1 for others
+#endif
+
 /*******************************************************************************
  * Function
  ******************************************************************************/
 static void LuosHAL_SystickInit(void);
 static void LuosHAL_FlashInit(void);
 static void LuosHAL_FlashEraseLuosMemoryInfo(void);
+static void LuosHAL_EventTimedWait(uint32_t timeout_ms);
+#ifdef LUOS_WORKER_NB
+static void LuosHAL_WorkerInit(void);
+static void *LuosHAL_WorkerThread(void *arg);
+static worker_queue_t *LuosHAL_WorkerElect(int16_t worker_id);
+#endif
 
 /////////////////////////Luos Library Needed function///////////////////////////
 
@@ -41,6 +81,11 @@ void LuosHAL_Init(void)
 
         // start timestamp
         LuosHAL_StartTimestamp();
+
+#ifdef LUOS_WORKER_NB
+        // Start service workers
+        LuosHAL_WorkerInit();
+#endif
     }
 }
 
@@ -88,6 +133,298 @@ uint32_t LuosHAL_GetSystick(void)
     return ms;
 }
 
+/******************************************************************************
+ * @brief Wake up anyone waiting for an event
+ * @param None
+ * @return None
+ ******************************************************************************/
+void LuosHAL_SignalEvent(void)
+{
+    pthread_mutex_lock(&mutex_event);
+    event_pending = true;
+    pthread_cond_signal(&cond_event);
+    pthread_mutex_unlock(&mutex_event);
+}
+
+/******************************************************************************
+ * @brief Sleep until an event occurs or the timeout expires
+ * @param timeout_ms : Maximum time to sleep in ms
+ * @return None
+ ******************************************************************************/
+static void LuosHAL_EventTimedWait(uint32_t timeout_ms)
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (timeout_ms % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+    pthread_mutex_lock(&mutex_event);
+    while (!event_pending)
+    {
+        if (pthread_cond_timedwait(&cond_event, &mutex_event, &deadline) != 0)
+        {
+            // Timeout
+            break;
+        }
+    }
+    event_pending = false;
+    pthread_mutex_unlock(&mutex_event);
+}
+
+/******************************************************************************
+ * @brief Wait for an event, used by Luos_RunUntilEvent
+ * @param timeout_ms : Maximum time to wait in ms
+ * @return None
+ ******************************************************************************/
+void LuosHAL_WaitEvent(uint32_t timeout_ms)
+{
+    event_driven = true;
+    LuosHAL_EventTimedWait(timeout_ms);
+}
+
+/******************************************************************************
+ * @brief Idle sleep of the Luos loop, useless if the application wait for events
+ * @param timeout_ms : Maximum time to sleep in ms
+ * @return None
+ ******************************************************************************/
+void LuosHAL_IdleWait(uint32_t timeout_ms)
+{
+    if (!event_driven)
+    {
+        LuosHAL_EventTimedWait(timeout_ms);
+    }
+}
+
+#ifdef LUOS_WORKER_NB
+/******************************************************************************
+ * @brief Create the worker threads, only once
+ * @param None
+ * @return None
+ ******************************************************************************/
+static void LuosHAL_WorkerInit(void)
+{
+    pthread_t thread_id;
+    if (worker_started)
+    {
+        return;
+    }
+    worker_started = true;
+    for (uint16_t i = 0; i < LUOS_WORKER_QUEUE_NB; i++)
+    {
+        worker_queue[i].worker = -1;
+    }
+    for (intptr_t i = 0; i < LUOS_WORKER_NB; i++)
+    {
+        pthread_create(&thread_id, NULL, LuosHAL_WorkerThread, (void *)i);
+        pthread_detach(thread_id);
+    }
+}
+
+/******************************************************************************
+ * @brief Find a queue this worker can run, mutex_worker must be locked
+ * Items of a queue are run one at a time and in order, different queues are
+ * run in parallel by any worker unless they are pinned.
+ * @param worker_id : Index of the worker looking for something to do
+ * @return Queue to run or NULL
+ ******************************************************************************/
+static worker_queue_t *LuosHAL_WorkerElect(int16_t worker_id)
+{
+    for (uint16_t i = 0; i < LUOS_WORKER_QUEUE_NB; i++)
+    {
+        uint16_t queue_id     = (worker_next_queue + i) % LUOS_WORKER_QUEUE_NB;
+        worker_queue_t *queue = &worker_queue[queue_id];
+        if ((queue->nb > 0) && !queue->running && ((queue->worker < 0) || (queue->worker == worker_id)))
+        {
+            // Start the next election after this queue to be fair
+            worker_next_queue = (queue_id + 1) % LUOS_WORKER_QUEUE_NB;
+            return queue;
+        }
+    }
+    return NULL;
+}
+
+/******************************************************************************
+ * @brief Worker thread, run the queued jobs
+ * @param arg : Index of the worker
+ * @return None
+ ******************************************************************************/
+static void *LuosHAL_WorkerThread(void *arg)
+{
+    worker_self = (int16_t)(intptr_t)arg;
+    pthread_mutex_lock(&mutex_worker);
+    while (true)
+    {
+        worker_queue_t *queue = LuosHAL_WorkerElect(worker_self);
+        if (queue == NULL)
+        {
+            pthread_cond_wait(&cond_worker, &mutex_worker);
+            continue;
+        }
+        // New items are written after the oldest one, run it in place
+        worker_item_t *item = &queue->items[queue->head];
+        queue->running      = true;
+        pthread_mutex_unlock(&mutex_worker);
+        item->job(item->arg, item->data);
+        pthread_mutex_lock(&mutex_worker);
+        queue->head    = (queue->head + 1) % LUOS_WORKER_QUEUE_SIZE;
+        queue->running = false;
+        queue->nb--;
+        if (queue->nb > 0)
+        {
+            // This queue can be run by another worker
+            pthread_cond_broadcast(&cond_worker);
+        }
+    }
+    return NULL;
+}
+
+/******************************************************************************
+ * @brief Queue a job with a copy of its data
+ * @param queue_id : Queue receiving the job, LUOS_WORKER_CORE_QUEUE for Luos_Loop
+ * @param job : Function to run
+ * @param arg : First argument of the job
+ * @param data : Data copied and given as second argument of the job
+ * @param size : Size of the data
+ * @return false if the queue is full, workers wait for room in the core queue
+ ******************************************************************************/
+bool LuosHAL_WorkerPost(uint16_t queue_id, WORKER_JOB job, void *arg, void *data, uint16_t size)
+{
+    worker_queue_t *queue = &core_queue;
+    if (queue_id != LUOS_WORKER_CORE_QUEUE)
+    {
+        if (queue_id >= LUOS_WORKER_QUEUE_NB)
+        {
+            return false;
+        }
+        queue = &worker_queue[queue_id];
+    }
+    if (size > LUOS_WORKER_DATA_SIZE)
+    {
+        return false;
+    }
+    pthread_mutex_lock(&mutex_worker);
+    while (queue->nb >= LUOS_WORKER_QUEUE_SIZE)
+    {
+        if ((queue != &core_queue) || (worker_self < 0))
+        {
+            pthread_mutex_unlock(&mutex_worker);
+            return false;
+        }
+        // Luos_Loop empties the core queue without any worker, wait for it instead of failing
+        pthread_cond_wait(&cond_core, &mutex_worker);
+    }
+    worker_item_t *item = &queue->items[(queue->head + queue->nb) % LUOS_WORKER_QUEUE_SIZE];
+    item->job           = job;
+    item->arg           = arg;
+    memcpy(item->data, data, size);
+    queue->nb++;
+    if (queue == &core_queue)
+    {
+        pthread_mutex_unlock(&mutex_worker);
+        LuosHAL_SignalEvent();
+        return true;
+    }
+    pthread_cond_broadcast(&cond_worker);
+    pthread_mutex_unlock(&mutex_worker);
+    return true;
+}
+
+/******************************************************************************
+ * @brief Check if a queue can't take more jobs
+ * @param queue_id : Queue to check
+ * @return true if the queue is full
+ ******************************************************************************/
+bool LuosHAL_WorkerIsFull(uint16_t queue_id)
+{
+    bool full = true;
+    pthread_mutex_lock(&mutex_worker);
+    if (queue_id == LUOS_WORKER_CORE_QUEUE)
+    {
+        full = (core_queue.nb >= LUOS_WORKER_QUEUE_SIZE);
+    }
+    else if (queue_id < LUOS_WORKER_QUEUE_NB)
+    {
+        full = (worker_queue[queue_id].nb >= LUOS_WORKER_QUEUE_SIZE);
+    }
+    pthread_mutex_unlock(&mutex_worker);
+    return full;
+}
+
+/******************************************************************************
+ * @brief Check if the current thread is not a worker
+ * @param None
+ * @return true if the caller can use Robus
+ ******************************************************************************/
+bool LuosHAL_WorkerIsCore(void)
+{
+    return (worker_self < 0);
+}
+
+/******************************************************************************
+ * @brief Check if some jobs are waiting for Luos_Loop
+ * @param None
+ * @return true if LuosHAL_WorkerRunCore have something to do
+ ******************************************************************************/
+bool LuosHAL_WorkerCorePending(void)
+{
+    pthread_mutex_lock(&mutex_worker);
+    bool pending = (core_queue.nb > 0);
+    pthread_mutex_unlock(&mutex_worker);
+    return pending;
+}
+
+/******************************************************************************
+ * @brief Run the jobs queued by workers for Luos_Loop
+ * Jobs queued during this run are left for the next one. A job not able to
+ * finish stays in the queue with the following ones to keep them in order.
+ * @param None
+ * @return None
+ ******************************************************************************/
+void LuosHAL_WorkerRunCore(void)
+{
+    pthread_mutex_lock(&mutex_worker);
+    uint16_t job_nb = core_queue.nb;
+    while (job_nb--)
+    {
+        worker_item_t *item = &core_queue.items[core_queue.head];
+        pthread_mutex_unlock(&mutex_worker);
+        if (item->job(item->arg, item->data) == false)
+        {
+            // Retry it during the next run
+            return;
+        }
+        pthread_mutex_lock(&mutex_worker);
+        core_queue.head = (core_queue.head + 1) % LUOS_WORKER_QUEUE_SIZE;
+        core_queue.nb--;
+        pthread_cond_broadcast(&cond_core);
+    }
+    pthread_mutex_unlock(&mutex_worker);
+}
+
+/******************************************************************************
+ * @brief Run all the jobs of a queue on a specific worker
+ * @param queue_id : Queue to pin
+ * @param worker_id : Worker running the queue, -1 to let any worker run it
+ * @return false if the queue or the worker doesn't exist
+ ******************************************************************************/
+bool LuosHAL_WorkerPin(uint16_t queue_id, int16_t worker_id)
+{
+    if ((queue_id >= LUOS_WORKER_QUEUE_NB) || (worker_id >= LUOS_WORKER_NB))
+    {
+        return false;
+    }
+    pthread_mutex_lock(&mutex_worker);
+    worker_queue[queue_id].worker = (worker_id < 0) ? -1 : worker_id;
+    pthread_cond_broadcast(&cond_worker);
+    pthread_mutex_unlock(&mutex_worker);
+    return true;
+}
+#endif
+
 /******************************************************************************
  * @brief Luos GetTimestamp
  * @param None
@@ -101,7 +438,7 @@ uint64_t LuosHAL_GetTimestamp(void)
 #else
     clock_gettime(CLOCK_MONOTONIC, &time);
 #endif
-    return time.tv_nsec;
+    return ((uint64_t)time.tv_sec * 1000000000) + time.tv_nsec;
 }
 
 /******************************************************************************
@@ -9,6 +9,7 @@
 #define _LUOSHAL_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <luos_hal_config.h>
 
 /*******************************************************************************
@@ -23,6 +24,12 @@
 #define ADDRESS_ALIASES_FLASH   ADDRESS_LAST_PAGE_FLASH
 #define ADDRESS_BOOT_FLAG_FLASH (ADDRESS_LAST_PAGE_FLASH + PAGE_SIZE) - 4
 
+#ifdef LUOS_WORKER_NB
+    #define LUOS_WORKER_CORE_QUEUE 0xFFFF // Jobs run by the thread calling Luos_Loop
+
+typedef bool (*WORKER_JOB)(void *arg, void *data); // Return false to run it again later, core queue only
+#endif
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -50,6 +57,21 @@ void LuosHAL_EraseMemory(uint32_t, uint16_t);
 void LuosHAL_ProgramFlash(uint32_t, uint16_t, uint8_t *);
 #endif
 
+// event functions
+void LuosHAL_SignalEvent(void);
+void LuosHAL_WaitEvent(uint32_t timeout_ms);
+void LuosHAL_IdleWait(uint32_t timeout_ms);
+
+#ifdef LUOS_WORKER_NB
+// worker functions
+bool LuosHAL_WorkerPost(uint16_t queue_id, WORKER_JOB job, void *arg, void *data, uint16_t size);
+bool LuosHAL_WorkerIsFull(uint16_t queue_id);
+bool LuosHAL_WorkerIsCore(void);
+bool LuosHAL_WorkerCorePending(void);
+void LuosHAL_WorkerRunCore(void);
+bool LuosHAL_WorkerPin(uint16_t queue_id, int16_t worker_id);
+#endif
+
 // timestamp functions
 uint64_t LuosHAL_GetTimestamp(void);
 void LuosHAL_StartTimestamp(void);
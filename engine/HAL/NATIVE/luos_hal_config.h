@@ -46,6 +46,30 @@ extern pthread_mutex_t mutex_luos;
 #ifndef LUOS_MUTEX_UNLOCK
     #define LUOS_MUTEX_UNLOCK pthread_mutex_unlock(&mutex_luos);
 #endif
+
+/*******************************************************************************
+ * DEFINE EVENT WAITING FUNCTION
+ ******************************************************************************/
+#ifndef LUOS_EVENT_WAIT
+    #define LUOS_EVENT_WAIT(timeout_ms) LuosHAL_WaitEvent(timeout_ms);
+#endif
+/*******************************************************************************
+ * DEFINE SERVICE WORKER THREADS
+ ******************************************************************************/
+// Define LUOS_WORKER_NB to run service callbacks on a pool of worker threads
+// instead of running them in Luos_Loop.
+#ifdef LUOS_WORKER_NB
+    #ifndef LUOS_WORKER_QUEUE_NB
+        #define LUOS_WORKER_QUEUE_NB 16 // Number of services able to use workers
+    #endif
+    #ifndef LUOS_WORKER_QUEUE_SIZE
+        #define LUOS_WORKER_QUEUE_SIZE 8 // Messages waiting for each service
+    #endif
+    #ifndef LUOS_WORKER_DATA_SIZE
+        #define LUOS_WORKER_DATA_SIZE 256 // Max size of a message copy
+    #endif
+#endif
+
 /*******************************************************************************
  * FLASH CONFIG
  ******************************************************************************/
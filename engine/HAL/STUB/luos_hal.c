@@ -19,6 +19,11 @@ static void LuosHAL_SystickInit(void);
 static void LuosHAL_FlashInit(void);
 static void LuosHAL_FlashEraseLuosMemoryInfo(void);
 
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint32_t systick_shift = 0; // Time added to the clock by the tests
+
 /////////////////////////Luos Library Needed function///////////////////////////
 
 /******************************************************************************
@@ -66,7 +71,17 @@ static void LuosHAL_SystickInit(void)
 uint32_t LuosHAL_GetSystick(void)
 {
     clock_t tick = clock();
-    return tick; // return  tick
+    return tick + systick_shift; // return  tick
+}
+
+/******************************************************************************
+ * @brief Make the time go forward without waiting, for tests purpose
+ * @param tick : Number of systick to add
+ * @return None
+ ******************************************************************************/
+void LuosHAL_ShiftSystick(uint32_t tick)
+{
+    systick_shift += tick;
 }
 
 /******************************************************************************
@@ -76,7 +91,7 @@ uint32_t LuosHAL_GetSystick(void)
  ******************************************************************************/
 uint64_t LuosHAL_GetTimestamp(void)
 {
-    return (LuosHAL_GetSystick() * 1000);
+    return ((uint64_t)LuosHAL_GetSystick() * 1000);
 }
 
 /******************************************************************************
@@ -18,6 +18,7 @@
  ******************************************************************************/
 
 void Timestamp_EncodeMsg(msg_t *msg, time_luos_t timestamp);
+void Timestamp_EncodeMsgNs(msg_t *msg, int64_t timestamp_ns);
 void Timestamp_ConvertToLatency(msg_t *msg);
 void Timestamp_ConvertToDate(msg_t *msg, uint64_t reception_date);
 
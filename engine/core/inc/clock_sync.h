@@ -0,0 +1,71 @@
+/******************************************************************************
+ * @file clock_sync
+ * @brief Network time shared by all the nodes
+ *
+ *  The node launching the detection is the clock master, its local time is
+ *  the network time. It periodically broadcasts a CLOCK_SYNC frame
+ *  timestamped with the date 0. The transmission converts this date into a
+ *  latency using the network time at the transmission start, and the
+ *  reception converts it back into a date using the network time of the
+ *  receiver at the reception start. The date received is then the error of
+ *  the receiver network time.
+ *  Other nodes keep a model of the network time made of an offset and a
+ *  drift from their local time, corrected by each sync frame. Timestamps are
+ *  converted with this network time so they can be compared across the
+ *  network, whatever the number of hops.
+ *
+ *   network time = local time - (offset + drift * (local time - sync date))
+ *
+ *  The drift is kept as a power of 2 fraction so that the conversion done in
+ *  the interrupts is a multiplication and a shift. Every node periodically
+ *  moves the drift accumulated into the offset to keep this product small.
+ *
+ * @author Luos
+ * @version 0.0.0
+ ******************************************************************************/
+#ifndef CLOCK_SYNC_H
+#define CLOCK_SYNC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "robus_struct.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#ifndef CLOCK_SYNC_PERIOD_MS
+    #define CLOCK_SYNC_PERIOD_MS 1000 // Time between two sync frames of the master
+#endif
+#ifndef CLOCK_SYNC_RESET_NS
+    #define CLOCK_SYNC_RESET_NS 1000000 // Network time error restarting the synchronisation instead of correcting it
+#endif
+
+typedef struct
+{
+    bool master;       // This node gives the network time
+    bool synced;       // The network time is corrected by the master
+    uint16_t sync_nb;  // Sync frames received
+    uint16_t lost_nb;  // Sync frames missed
+    int64_t offset_ns; // Local time - network time, now
+    int32_t drift_ppb; // Drift of the local clock from the master clock
+    int64_t error_ns;  // Network time error corrected by the last sync frame
+    uint64_t age_ns;   // Time elapsed since the last sync frame
+} clock_sync_quality_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Function
+ ******************************************************************************/
+void ClockSync_Init(void);
+void ClockSync_SetMaster(bool master);
+bool ClockSync_IsMaster(void);
+uint16_t ClockSync_NextSequence(void);
+void ClockSync_Receive(uint16_t sequence, int64_t error_ns);
+void ClockSync_Update(void);
+int64_t ClockSync_GetNetworkTime(uint64_t local_ns);
+void ClockSync_GetQuality(clock_sync_quality_t *quality);
+
+#endif /* CLOCK_SYNC_H */
@@ -13,6 +13,10 @@
 #include "luos_od.h"
 #include "streaming.h"
 #include "timestamp.h"
+#include "clock_sync.h"
+#include "timer_wheel.h"
+#include "profiler.h"
+#include "reassembly.h"
 
 /*******************************************************************************
  * Definitions
@@ -20,6 +24,8 @@
 // Initialise package with a macro
 #define LUOS_ADD_PACKAGE(_name) \
     Luos_AddPackage(_name##_Init, _name##_Loop);
+#define LUOS_ADD_PERIODIC_PACKAGE(_name, _period_us, _budget_us) \
+    Luos_AddPeriodicPackage(_name##_Init, _name##_Loop, _period_us, _budget_us);
 
 #define LUOS_RUN() Luos_Run();
 
@@ -39,6 +45,23 @@ typedef struct __attribute__((__packed__))
         uint8_t unmap[sizeof(luos_stats_t) + sizeof(service_stats_t)]; /*!< streamable form. */
     };
 } general_stats_t;
+/******************************************************************************
+ * @struct profile_stats_t
+ * @brief format execution time profile of a service to be sent trough msg
+ ******************************************************************************/
+typedef struct __attribute__((__packed__))
+{
+    union
+    {
+        struct __attribute__((__packed__))
+        {
+            profiler_summary_t service_cb;                                   // Callback of the service
+            profiler_summary_t package_loop;                                 // Loop of the package creating the service
+            profiler_summary_t node[PROFILER_PROBE_NB - PROFILER_LUOS_LOOP]; // Luos_Loop and Robus_Loop phases
+        };
+        uint8_t unmap[PROFILER_PROBE_NB * sizeof(profiler_summary_t)]; /*!< streamable form. */
+    };
+} profile_stats_t;
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -48,6 +71,7 @@ typedef struct __attribute__((__packed__))
  ******************************************************************************/
 void Luos_Init(void);
 void Luos_Loop(void);
+void Luos_RunUntilEvent(uint32_t timeout_ms);
 
 // ***************** Node management *****************
 void Luos_ResetStatistic(void);
@@ -57,13 +81,16 @@ void Luos_SetFilterState(uint8_t state, service_t *service);
 
 // ***************** Package management *****************
 void Luos_AddPackage(void (*Init)(void), void (*Loop)(void));
+void Luos_AddPeriodicPackage(void (*Init)(void), void (*Loop)(void), uint32_t period_us, uint32_t budget_us);
 void Luos_Run(void);
 
 // ***************** Service management *****************
 service_t *Luos_CreateService(SERVICE_CB service_cb, uint8_t type, const char *alias, revision_t revision);
+service_t *Luos_CreateServiceWithPriority(SERVICE_CB service_cb, uint8_t type, const char *alias, revision_t revision, service_priority_t priority);
 error_return_t Luos_UpdateAlias(service_t *service, const char *alias, uint16_t size);
 void Luos_Detect(service_t *service);
 void Luos_ServicesClear(void);
+error_return_t Luos_SetServiceWorker(service_t *service, int16_t worker_id);
 
 // ***************** Messaging management *****************
 void Luos_Flush(void);
@@ -71,9 +98,10 @@ void Luos_Flush(void);
 // *** Send
 error_return_t Luos_SendMsg(service_t *service, msg_t *msg);
 error_return_t Luos_SendTimestampMsg(service_t *service, msg_t *msg, time_luos_t timestamp);
-void Luos_SendData(service_t *service, msg_t *msg, void *bin_data, uint16_t size);
-void Luos_SendStreaming(service_t *service, msg_t *msg, streaming_channel_t *stream);
-void Luos_SendStreamingSize(service_t *service, msg_t *msg, streaming_channel_t *stream, uint32_t max_size);
+void Luos_SendData(service_t *service, msg_t *msg, void *bin_data, uint32_t size);
+uint32_t Luos_SendStreaming(service_t *service, msg_t *msg, streaming_channel_t *stream);
+uint32_t Luos_SendStreamingSize(service_t *service, msg_t *msg, streaming_channel_t *stream, uint32_t max_size);
+error_return_t Luos_SendStreamingCredit(service_t *service, uint16_t target, streaming_channel_t *stream);
 error_return_t Luos_TxComplete(void);
 
 void Luos_SetExternId(service_t *service, target_mode_t target_mode, uint16_t target, uint16_t newid);
@@ -81,8 +109,10 @@ void Luos_SetExternId(service_t *service, target_mode_t target_mode, uint16_t ta
 // *** Receive
 error_return_t Luos_ReadMsg(service_t *service, msg_t **returned_msg);
 error_return_t Luos_ReadFromService(service_t *service, int16_t id, msg_t **returned_msg);
-int Luos_ReceiveData(service_t *service, msg_t *msg, void *bin_data);
+int Luos_ReceiveData(service_t *service, msg_t *msg, void *bin_data, uint32_t size);
+int Luos_ReceiveDataSink(service_t *service, msg_t *msg, DATA_SINK sink, void *context);
 error_return_t Luos_ReceiveStreaming(service_t *service, msg_t *msg, streaming_channel_t *stream);
+error_return_t Luos_ReceiveStreamingCredit(service_t *service, msg_t *msg, streaming_channel_t *stream);
 uint16_t Luos_NbrAvailableMsg(void);
 uint32_t Luos_GetSystick(void);
 error_return_t Luos_TxComplete(void);
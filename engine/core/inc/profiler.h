@@ -0,0 +1,68 @@
+/******************************************************************************
+ * @file profiler
+ * @brief Execution time histograms of service callbacks, package loops and
+ *        network loop phases
+ *
+ *  Each probe keeps a log-scale histogram of its execution times in us,
+ *  bucket n counting the durations in [2^(n-1), 2^n[ us, and its exact min
+ *  and max. The p99 is estimated from the histogram.
+ *
+ * @author Luos
+ * @version 0.0.0
+ ******************************************************************************/
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include "robus_struct.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define PROFILER_BUCKET_NB 16 // The last bucket count durations over 16ms
+
+typedef enum
+{
+    PROFILER_SERVICE_CB,      // Service callbacks, indexed by service
+    PROFILER_PACKAGE_LOOP,    // Package loops, indexed by package
+    PROFILER_LUOS_LOOP,       // Whole Luos_Loop
+    PROFILER_ROBUS_TIMEOUT,   // Robus_Loop network timeout management
+    PROFILER_ROBUS_MSG_ALLOC, // Robus_Loop message allocation tasks
+    PROFILER_ROBUS_INTERPRET, // Robus_Loop received message interpretation
+    PROFILER_ROBUS_HAL,       // Robus_Loop HAL loop
+    PROFILER_PROBE_NB
+} profiler_probe_t;
+
+typedef struct
+{
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t count;
+    uint16_t bucket[PROFILER_BUCKET_NB];
+} profiler_histogram_t;
+
+/* Summary of a probe sent by the LUOS_PROFILE command
+ */
+typedef struct __attribute__((__packed__))
+{
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} profiler_summary_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Function
+ ******************************************************************************/
+void Profiler_Init(void);
+uint64_t Profiler_Start(void);
+void Profiler_Record(profiler_probe_t probe, uint16_t index, uint64_t start_date);
+void Profiler_RecordDuration(profiler_probe_t probe, uint16_t index, uint32_t duration_us);
+void Profiler_GetSummary(profiler_probe_t probe, uint16_t index, profiler_summary_t *summary);
+profiler_histogram_t *Profiler_GetHistogram(profiler_probe_t probe, uint16_t index);
+
+#endif /* PROFILER_H */
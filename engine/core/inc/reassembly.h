@@ -0,0 +1,78 @@
+/******************************************************************************
+ * @file reassembly
+ * @brief Reassembly of data split into several messages
+ *
+ *  Each data in reception have its own session, identified by the source,
+ *  the target and the command of its messages. Sessions allow several
+ *  sources to send data to the same service, or several services to
+ *  receive data at the same time, without corrupting each other.
+ *  The size of each chunk is the size of the data left to receive, a
+ *  session detects missing chunks by checking it. When this size doesn't fit
+ *  in the header the chunk is a bulk one, using the BULK_PROTOCOL and
+ *  carrying it in its data.
+ *  A data is received into a buffer, dropped if it doesn't fit in, or given
+ *  chunk by chunk to a sink so large data can flow through small buffers.
+ *  A data without any chunk received for REASSEMBLY_TIMEOUT_MS is dropped.
+ *
+ * @author Luos
+ * @version 0.0.0
+ ******************************************************************************/
+#ifndef REASSEMBLY_H
+#define REASSEMBLY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "robus_struct.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#ifndef MAX_REASSEMBLY_SESSION
+    #define MAX_REASSEMBLY_SESSION 4 // Data able to be received at the same time
+#endif
+#ifndef REASSEMBLY_TIMEOUT_MS
+    #define REASSEMBLY_TIMEOUT_MS 100 // Time without chunk before dropping a data in reception
+#endif
+
+// Chunks of data bigger than the size field of the header
+#define MAX_HEADER_DATA_SIZE 0xFFFF           // Biggest size left carried by the header, bigger data start in bulk mode
+#define BULK_HEADER_SIZE     sizeof(uint32_t) // 32 bits size left to receive, at the beginning of a bulk chunk data
+
+typedef enum
+{
+    SINK_CHUNK, // Next part of the data, in order
+    SINK_END,   // The data is complete
+    SINK_ABORT  // Chunks are missing, the data given so far is not valid
+} sink_event_t;
+
+/* Receive a data chunk by chunk instead of into a buffer
+ * offset is the position of the chunk in the data, or the size given so far on SINK_END and SINK_ABORT.
+ */
+typedef void (*DATA_SINK)(void *context, sink_event_t event, const void *data, uint16_t size, uint32_t offset);
+
+typedef struct
+{
+    uint16_t source;     // Service sending the data
+    uint16_t target;     // Service receiving the data
+    uint8_t cmd;         // Command of the data messages
+    bool lost;           // Some chunks are missing, drop the end of the data
+    uint32_t total_size; // Size of the whole data
+    uint32_t next_size;  // Size announced by the next chunk, 0 if the session is free
+    uint32_t date;       // Systick of the last chunk received
+    uint8_t *buffer;     // Buffer receiving the data, NULL if a sink receives it
+    DATA_SINK sink;      // Sink receiving the data, NULL if a buffer receives it
+    void *context;       // Argument given to the sink
+} reassembly_session_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Function
+ ******************************************************************************/
+void Reassembly_Reset(void);
+void Reassembly_Loop(void);
+int32_t Reassembly_Receive(uint16_t target, msg_t *msg, void *bin_data, uint32_t size, DATA_SINK sink, void *context);
+
+#endif /* REASSEMBLY_H */
@@ -7,13 +7,22 @@
 #ifndef TABLE
 #define TABLE
 
+#include <stddef.h>
 #include "luos_engine.h"
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
 #ifndef MAX_RTB_ENTRY
-    #define MAX_RTB_ENTRY 40
+    #define MAX_RTB_ENTRY 40 // Number of entries of the default routing table storage
 #endif
+#ifndef MAX_RTB_RESULT
+    #define MAX_RTB_RESULT MAX_RTB_ENTRY // Maximum number of entries in a search result
+#endif
+
+// Number of uint16_t needed to index entry_nb routing table entries
+#define RTB_INDEX_SIZE(entry_nb) (5 * (entry_nb) + 4)
+// Size in bytes of a storage able to contain entry_nb routing table entries and their indexes
+#define RTB_STORAGE_SIZE(entry_nb) ((((entry_nb) * sizeof(routing_table_t) + 1) & ~1) + RTB_INDEX_SIZE(entry_nb) * sizeof(uint16_t))
 
 typedef enum
 {
@@ -62,39 +71,86 @@ typedef struct __attribute__((__packed__))
 /******************************************************************************
  * @struct search_result_t
  * @brief allow user to get back result of routing table filtering
+ * The entry indexes are kept in result_table, or in a table given to
+ * RTFilter_ResetTable for results bigger than MAX_RTB_RESULT.
  ******************************************************************************/
 typedef struct
 {
     uint16_t result_nbr;
-    routing_table_t *result_table[MAX_RTB_ENTRY];
+    uint32_t generation;                   // Routing table generation this result have been computed with
+    bool truncated;                        // More services than the result capacity, only the first ones are kept
+    uint16_t capacity;                     // Size of table
+    uint16_t *table;                       // Table given to RTFilter_ResetTable, NULL to use result_table
+    uint16_t result_table[MAX_RTB_RESULT]; // Routing table entry indexes, use RTFilter_GetEntry to access them
 } search_result_t;
 
+// realloc compatible callback allowing the routing table storage to grow
+typedef void *(*RTB_STORAGE_CB)(void *storage, size_t size);
+
+/******************************************************************************
+ * @struct rt_filter_t
+ * @brief allow user to apply multiple filtering criteria in one sweep
+ ******************************************************************************/
+typedef enum
+{
+    FILTER_ID    = 1 << 0, // Keep services with the given id
+    FILTER_TYPE  = 1 << 1, // Keep services with the given type
+    FILTER_NODE  = 1 << 2, // Keep services of the given node
+    FILTER_ALIAS = 1 << 3, // Keep services with an alias containing the given one
+} rt_filter_criteria_t;
+
+typedef struct
+{
+    uint8_t criteria; // rt_filter_criteria_t flags to check
+    uint16_t id;
+    luos_type_t type;
+    uint16_t node_id;
+    const char *alias;
+} rt_filter_t;
+
 /*******************************************************************************
  * Function
  ******************************************************************************/
 // ********************* routing_table search tools ************************
+uint16_t RoutingTB_IDFromAlias(char *alias);
+char *RoutingTB_AliasFromId(uint16_t id);
 uint16_t RoutingTB_NodeIDFromID(uint16_t id);
 
 // ********************* routing_table management tools ************************
 void RoutingTB_ComputeRoutingTableEntryNB(void);
 void RoutingTB_DetectServices(service_t *service);
+uint16_t RoutingTB_EncodeFrame(msg_t *msg, const routing_table_t *table, uint16_t first_entry, uint16_t end_entry, uint16_t entry_nb);
+void RoutingTB_SendEntries(service_t *service, msg_t *msg, const routing_table_t *table, uint16_t entry_nb);
+void RoutingTB_ReceiveEntries(msg_t *msg);
+void RoutingTB_ReceiveChunk(msg_t *msg);
+void RoutingTB_SendMissingChunks(service_t *service, msg_t *msg);
+void RoutingTB_ReceiveMissingChunks(msg_t *msg);
 void RoutingTB_ConvertNodeToRoutingTable(routing_table_t *entry, node_t *node);
 void RoutingTB_ConvertServiceToRoutingTable(routing_table_t *entry, service_t *service);
 void RoutingTB_RemoveNode(uint16_t nodeid);
 void RoutingTB_RemoveOnRoutingTable(uint16_t id);
 void RoutingTB_Erase(void);
 routing_table_t *RoutingTB_Get(void);
+error_return_t RoutingTB_SetStorage(void *storage, uint32_t size, RTB_STORAGE_CB storage_cb);
+error_return_t RoutingTB_Reserve(uint32_t entry_nb);
 uint16_t RoutingTB_GetLastService(void);
 uint16_t *RoutingTB_GetLastNode(void);
 uint16_t RoutingTB_GetLastEntry(void);
+uint16_t RoutingTB_BigestNodeID(void);
+uint32_t RoutingTB_GetGeneration(void);
 
 // ********************* routing table  filtering ********************************
 error_return_t RTFilter_InitCheck(search_result_t *result);
 search_result_t *RTFilter_Reset(search_result_t *result);
+search_result_t *RTFilter_ResetTable(search_result_t *result, uint16_t *table, uint16_t capacity);
+bool RTFilter_IsUpToDate(search_result_t *result);
+search_result_t *RTFilter_Refresh(search_result_t *result, const rt_filter_t *filter);
+routing_table_t *RTFilter_GetEntry(search_result_t *result, uint16_t result_index);
 search_result_t *RTFilter_ID(search_result_t *result, uint16_t id);
 search_result_t *RTFilter_Type(search_result_t *result, luos_type_t type);
 search_result_t *RTFilter_Node(search_result_t *result, uint16_t node_id);
 search_result_t *RTFilter_Alias(search_result_t *result, char *alias);
 search_result_t *RTFilter_Service(search_result_t *result, service_t *service);
+search_result_t *RTFilter_Match(search_result_t *result, const rt_filter_t *filter);
 
 #endif /* TABLE */
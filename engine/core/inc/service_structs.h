@@ -24,8 +24,9 @@ typedef struct __attribute__((__packed__))
         {
             memory_stats_t memory;
             uint8_t max_loop_time_ms;
+            uint8_t package_deadline_miss;
         };
-        uint8_t unmap[sizeof(memory_stats_t) + 1]; /*!< streamable form. */
+        uint8_t unmap[sizeof(memory_stats_t) + 2]; /*!< streamable form. */
     };
 } luos_stats_t;
 /* This structure is used to create services version
@@ -64,11 +65,24 @@ typedef struct __attribute__((__packed__)) service_stats_t
  */
 typedef struct __attribute__((__packed__)) timed_update_t
 {
-    uint32_t last_update;
-    uint16_t time_ms;
-    uint16_t target;
+    uint32_t period_us; // 0 if there is no subscriber
+    uint16_t target;    // Subscriber
+    uint16_t topic;     // Topic the subscriber listen to get this update, 0 if it get it directly
 } timed_update_t;
 
+#define UPDATE_TOPIC_REFUSED 0xFFFF // The subscriber can't get its update by topic
+
+/* Priority of the messages of a service in Luos_Loop
+ * please refer to the documentation
+ */
+typedef enum
+{
+    LOW_PRIORITY,      // Telemetry, logs and other bulk traffic
+    NORMAL_PRIORITY,   // Default priority of the services
+    HIGH_PRIORITY,     // Control services needing a bounded latency
+    CRITICAL_PRIORITY  // Safety services
+} service_priority_t;
+
 /* This structure is used to manage read or write access
  * please refer to the documentation
  */
@@ -87,6 +101,9 @@ typedef struct
 {
     void (*Init)(void);
     void (*Loop)(void);
+    uint32_t period_us; // Period of the loop, 0 to run it on each Luos_Run
+    uint32_t budget_us; // Maximum execution time of the loop, 0 if unlimited
+    uint64_t next_date; // Date of the next loop in us
 } package_t;
 
 /* This structure is used to manage services
@@ -98,14 +115,15 @@ typedef struct __attribute__((__packed__)) service_t
     // Callback
     void (*service_cb)(struct service_t *service, msg_t *msg);
     // Variables
-    uint8_t default_alias[MAX_ALIAS_SIZE]; /*!< service default alias. */
-    uint8_t alias[MAX_ALIAS_SIZE];         /*!< service alias. */
-    timed_update_t auto_refresh;           /*!< service auto refresh context. */
-    revision_t revision;                   /*!< service firmware version. */
-    luos_stats_t *node_statistics;         /*!< Node level statistics. */
-    service_stats_t statistics;            /*!< service level statistics. */
-    access_t access;                       /*!< service read write access. */
-    void *profile_context;                 /*!< Pointer to the profile context. */
+    uint8_t default_alias[MAX_ALIAS_SIZE];              /*!< service default alias. */
+    uint8_t alias[MAX_ALIAS_SIZE];                      /*!< service alias. */
+    timed_update_t auto_refresh[MAX_UPDATE_SUBSCRIBER]; /*!< service auto refresh subscribers. */
+    revision_t revision;                                /*!< service firmware version. */
+    luos_stats_t *node_statistics;                      /*!< Node level statistics. */
+    service_stats_t statistics;                         /*!< service level statistics. */
+    access_t access;                                    /*!< service read write access. */
+    void *profile_context;                              /*!< Pointer to the profile context. */
+    service_priority_t priority;                        /*!< Priority of the service messages. */
 } service_t;
 
 typedef void (*SERVICE_CB)(service_t *service, msg_t *msg);
@@ -114,7 +132,7 @@ typedef enum
 {
     // Luos specific registers
     LOCAL_RTB = ROBUS_PROTOCOL_NB, // Ask(size == 0), generate(size == 2) a local routing_table.
-    RTB,                           // Receive a routing_table.
+    RTB,                           // Receive a routing_table frame.
     WRITE_ALIAS,                   // Get and save a new given alias.
     UPDATE_PUB,                    // Ask to update a sensor value each time duration to the sender
     ASK_DETECTION,                 // Ask Luos to launch a detection
@@ -131,6 +149,23 @@ typedef enum
     // Verbose command
     VERBOSE,
 
+    // Routing table broadcast distribution
+    RTB_CHUNK,  // Receive a shared routing_table frame.
+    RTB_STATUS, // Ask for the routing_table entries we missed.
+    RTB_NACK,   // List of the missing routing_table entry ranges (empty if complete).
+
+    // Auto update fan-out
+    UPDATE_TOPIC, // Topic to listen to get auto updates (0 to stop), empty to refuse it.
+
+    // Profiling
+    LUOS_PROFILE, // service sends its execution time profile.
+
+    // Streaming flow control
+    STREAMING_CREDIT, // Sample count a streaming receiver accepts since its creation (uint32_t).
+
+    // Network time
+    CLOCK_SYNC, // Timestamped sync frame of the clock master (uint16_t sequence).
+
     // compatibility area
     LUOS_LAST_RESERVED_CMD = 42
 } reserved_luos_cmd_t;
@@ -10,6 +10,50 @@
  *   ^                 ^               ^                         ^
  * ring_buffer    sample_ptr       data_ptr               end_ring_buffer
  *
+ *  A streaming channel can be timed by giving it a sample period and the
+ *  date of the samples put in it. The date of the oldest sample follows the
+ *  samples taken out of the channel, allowing to get the date of any
+ *  available sample without storing it.
+ *
+ *  A streaming channel can be flow controlled by credits. The receiver counts
+ *  the samples it received and advertises to the sender the sample count it
+ *  accepts, which is this count plus its free samples. The sender counts the
+ *  samples it sent and stops sending when it reaches this credit. Counting
+ *  samples since the channel creation keep the credits right even when some
+ *  samples are still on their way while the receiver advertises.
+ *
+ *  A streaming channel in overwrite mode never overflow, samples put in a
+ *  full channel replace the oldest ones. The producer never moves sample_ptr,
+ *  it only counts the samples it replaced. The consumer skips them itself
+ *  before taking samples out and counts them as overwritten until
+ *  Luos_SendStreaming reports them. Samples replaced while the consumer reads
+ *  them may be a mix of old and new values, they are taken out once and
+ *  counted as overwritten.
+ *
+ *  Lock free streaming channel
+ *  This structure manage a ring buffer shared by a single producer and a
+ *  single consumer, running in an interrupt and the main loop or in two
+ *  threads, without masking interrupts. The producer only modify head and the
+ *  consumer only modify tail. Both count samples since the channel creation
+ *  and wrap naturally, the ring buffer size being a power of 2.
+ *
+ *   |--------------------- ring_buffer_size --------------------|
+ *   |.........|*****************************|...................|
+ *   ^         ^                             ^
+ * ring_buffer (tail & mask)             (head & mask)
+ *
+ *  Broadcast streaming channel
+ *  This structure manage a ring buffer written by a single producer and read
+ *  by several registered readers sharing the same samples. Each reader have
+ *  its own tail. A blocking reader stops the producer when it doesn't read
+ *  fast enough, an overrun reader lose its oldest samples instead and count
+ *  them. The producer and the readers have to run in the same context.
+ *
+ *   |--------------------- ring_buffer_size --------------------|
+ *   |.....|*************************************|...............|
+ *   ^     ^           ^            ^            ^
+ * ring_buffer  reader[0]->tail  reader[1]->tail (head & mask)
+ *
  * @author Luos
  * @version 0.0.0
  ******************************************************************************/
@@ -17,17 +61,66 @@
 #define STREAMING_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "luos_utils.h"
+#include "luos_list.h"
+#include "od_time.h"
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
+#ifndef MAX_STREAM_READER
+    #define MAX_STREAM_READER 4 // Readers of a broadcast streaming channel
+#endif
+
 typedef struct
 {
-    void *ring_buffer;     // Begin ring buffer pointer
-    void *end_ring_buffer; // End of the ring buffer
-    void *sample_ptr;      // Current sample pointer (pointer always point a fresh data)
-    void *data_ptr;        // Current pointer of data
-    uint8_t data_size;     // Size granularity of the data contained on the ring buffer
+    void *ring_buffer;         // Begin ring buffer pointer
+    void *end_ring_buffer;     // End of the ring buffer
+    void *sample_ptr;          // Current sample pointer (pointer always point a fresh data)
+    void *data_ptr;            // Current pointer of data
+    uint8_t data_size;         // Size granularity of the data contained on the ring buffer
+    int64_t period_ns;         // Time between two samples in ns, 0 if the samples are not timed
+    int64_t date_ns;           // Date of the sample pointed by sample_ptr in ns
+    uint32_t sample_nb;        // Samples sent or received since the creation
+    uint32_t credit;           // Sample count accepted by the receiver, sender side
+    bool flow_control;         // Samples are sent only up to the receiver credit
+    bool overwrite;            // New samples replace the oldest ones when the ring buffer is full
+    volatile uint32_t dropped; // Oldest samples replaced since the creation, modified by the producer only
+    uint32_t skipped;          // Replaced samples skipped since the creation, modified by the consumer only
+    uint32_t overwritten;      // Replaced samples skipped since the last report, modified by the consumer only
 } streaming_channel_t;
+
+typedef struct
+{
+    uint8_t *ring_buffer;   // Begin ring buffer pointer
+    uint32_t mask;          // Number of samples of the ring buffer - 1
+    volatile uint32_t head; // Samples written since the creation, modified by the producer only
+    volatile uint32_t tail; // Samples read since the creation, modified by the consumer only
+    uint8_t data_size;      // Size granularity of the data contained on the ring buffer
+} spsc_channel_t;
+
+typedef enum
+{
+    STREAM_READER_BLOCK,  // The producer waits for this reader
+    STREAM_READER_OVERRUN // The producer overwrite the oldest samples of this reader
+} stream_reader_policy_t;
+
+typedef struct
+{
+    uint32_t tail;                 // Samples read since the channel creation
+    uint32_t overrun_nb;           // Samples lost by this reader
+    stream_reader_policy_t policy; // Behavior when this reader is late
+} stream_reader_t;
+
+typedef struct
+{
+    uint8_t *ring_buffer;                       // Begin ring buffer pointer
+    uint32_t mask;                              // Number of samples of the ring buffer - 1
+    uint32_t head;                              // Samples written since the creation
+    stream_reader_t *reader[MAX_STREAM_READER]; // Registered readers
+    uint8_t reader_nb;                          // Number of registered readers
+    uint8_t data_size;                          // Size granularity of the data contained on the ring buffer
+} broadcast_channel_t;
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -43,5 +136,34 @@ uint16_t Stream_GetAvailableSampleNB(streaming_channel_t *stream);
 uint16_t Stream_GetAvailableSampleNBUntilEndBuffer(streaming_channel_t *stream);
 uint16_t Stream_AddAvailableSampleNB(streaming_channel_t *stream, uint16_t size);
 uint16_t Stream_RmvAvailableSampleNB(streaming_channel_t *stream, uint16_t size);
+uint16_t Stream_GetFreeSampleNB(streaming_channel_t *stream);
+uint16_t Stream_GetCreditSampleNB(streaming_channel_t *stream);
+void Stream_SetOverwriteMode(streaming_channel_t *stream, bool overwrite);
+uint32_t Stream_GetOverwrittenSampleNB(streaming_channel_t *stream);
+void Stream_SetSamplePeriod(streaming_channel_t *stream, time_luos_t period);
+uint16_t Stream_PutTimestampSample(streaming_channel_t *stream, const void *data, uint16_t size, time_luos_t date);
+uint16_t Stream_PutTimestampSampleNs(streaming_channel_t *stream, const void *data, uint16_t size, int64_t date_ns);
+time_luos_t Stream_GetSampleDate(streaming_channel_t *stream, uint16_t index);
+
+spsc_channel_t Stream_CreateSpscChannel(const void *ring_buffer, uint16_t ring_buffer_size, uint8_t data_size);
+void Stream_ResetSpscChannel(spsc_channel_t *stream);
+uint16_t Stream_SpscPutSample(spsc_channel_t *stream, const void *data, uint16_t size);
+uint16_t Stream_SpscGetSample(spsc_channel_t *stream, void *data, uint16_t size);
+uint16_t Stream_SpscGetAvailableSampleNB(spsc_channel_t *stream);
+uint16_t Stream_SpscGetFreeSampleNB(spsc_channel_t *stream);
+uint16_t Stream_SpscGetAvailableSampleNBUntilEndBuffer(spsc_channel_t *stream);
+uint16_t Stream_SpscGetFreeSampleNBUntilEndBuffer(spsc_channel_t *stream);
+void *Stream_SpscGetSamplePtr(spsc_channel_t *stream);
+void *Stream_SpscGetDataPtr(spsc_channel_t *stream);
+uint16_t Stream_SpscAddAvailableSampleNB(spsc_channel_t *stream, uint16_t size);
+uint16_t Stream_SpscRmvAvailableSampleNB(spsc_channel_t *stream, uint16_t size);
+
+broadcast_channel_t Stream_CreateBroadcastChannel(const void *ring_buffer, uint16_t ring_buffer_size, uint8_t data_size);
+error_return_t Stream_AddBroadcastReader(broadcast_channel_t *stream, stream_reader_t *reader, stream_reader_policy_t policy);
+error_return_t Stream_RemoveBroadcastReader(broadcast_channel_t *stream, stream_reader_t *reader);
+uint16_t Stream_BroadcastPutSample(broadcast_channel_t *stream, const void *data, uint16_t size);
+uint16_t Stream_BroadcastGetSample(broadcast_channel_t *stream, stream_reader_t *reader, void *data, uint16_t size);
+uint16_t Stream_BroadcastGetAvailableSampleNB(broadcast_channel_t *stream, stream_reader_t *reader);
+uint16_t Stream_BroadcastGetFreeSampleNB(broadcast_channel_t *stream);
 
 #endif /* LUOS_H */
@@ -0,0 +1,56 @@
+/******************************************************************************
+ * @file timer_wheel
+ * @brief Hierarchical timer wheel scheduling periodic jobs with a microsecond
+ *        resolution
+ *
+ *  Timers are allocated by their users and linked in the slots of the wheel,
+ *  starting, stopping and expiring a timer is done in constant time whatever
+ *  the number of running timers.
+ *  The wheel is run by Luos_Loop, timer callbacks are called from there.
+ *
+ * @author Luos
+ * @version 0.0.0
+ ******************************************************************************/
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "robus_struct.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define TIMER_WHEEL_NO_EVENT 0xFFFFFFFFFFFFFFFF
+
+typedef void (*TIMER_CB)(void *arg);
+
+typedef struct luos_timer_t
+{
+    struct luos_timer_t *next;  // Next timer of the same slot
+    struct luos_timer_t **prev; // Pointer to the link pointing on this timer
+    uint64_t expiry;            // Next expiration date in us
+    uint32_t period;            // Reload period in us, 0 for a one shot timer
+    TIMER_CB callback;          // Function called on expiration
+    void *arg;                  // Argument given to the callback
+    uint8_t level;              // Level of the wheel containing this timer
+    uint8_t slot;               // Slot of the level containing this timer
+} luos_timer_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Function
+ ******************************************************************************/
+void TimerWheel_Init(void);
+void TimerWheel_Loop(void);
+uint64_t TimerWheel_NextEvent(void);
+uint64_t TimerWheel_Now(void);
+
+error_return_t TimerWheel_Start(luos_timer_t *timer, uint32_t delay_us, uint32_t period_us, TIMER_CB callback, void *arg);
+void TimerWheel_Stop(luos_timer_t *timer);
+bool TimerWheel_IsRunning(luos_timer_t *timer);
+
+#endif /* TIMER_WHEEL_H */
@@ -13,6 +13,11 @@
 #include "string.h"
 #include "od_time.h"
 
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define TIMESTAMP_SIZE sizeof(int64_t) // Timestamp at the end of a message, in ns
+
 /*******************************************************************************
  * Function
  ******************************************************************************/
@@ -20,5 +25,6 @@
 time_luos_t Timestamp_now(void);
 bool Timestamp_IsTimestampMsg(msg_t *msg);
 time_luos_t Timestamp_GetTimestamp(msg_t *msg);
+int64_t Timestamp_GetTimestampNs(msg_t *msg);
 
 #endif /* _TIMESTAMP_H_ */
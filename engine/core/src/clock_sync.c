@@ -0,0 +1,196 @@
+/******************************************************************************
+ * @file clock_sync
+ * @brief Network time shared by all the nodes
+ * @author Luos
+ * @version 0.0.0
+ ******************************************************************************/
+#include <string.h>
+#include "clock_sync.h"
+#include "luos_hal.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define CLOCK_SYNC_PPB         1000000000 // Drift unit reported
+#define CLOCK_SYNC_DRIFT_SHIFT 30         // Drift unit used to convert the dates, 2^-30 ~ 0.93ppb
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static clock_sync_quality_t clock_sync;
+static uint64_t sync_date     = 0; // Local date of the last sync frame
+static uint16_t sync_sequence = 0; // Sequence of the last sync frame, sent or received
+static uint64_t model_date    = 0; // Local date of the offset
+static int64_t model_offset   = 0; // Local time - network time at model_date
+static int32_t model_drift    = 0; // Drift of the local clock in 2^-CLOCK_SYNC_DRIFT_SHIFT
+
+/*******************************************************************************
+ * Function
+ ******************************************************************************/
+_CRITICAL static int64_t ClockSync_GetOffset(uint64_t local_ns);
+
+/******************************************************************************
+ * @brief Forget the network time, the local time is used until the next sync
+ * @param None
+ * @return None
+ ******************************************************************************/
+void ClockSync_Init(void)
+{
+    // The model is read by the timestamp conversions in interrupts, don't let them see it half written
+    LuosHAL_SetIrqState(false);
+    memset(&clock_sync, 0, sizeof(clock_sync_quality_t));
+    sync_date     = 0;
+    sync_sequence = 0;
+    model_date    = 0;
+    model_offset  = 0;
+    model_drift   = 0;
+    LuosHAL_SetIrqState(true);
+}
+
+/******************************************************************************
+ * @brief Make this node the one giving the network time
+ * @param master : true if this node is the clock master
+ * @return None
+ ******************************************************************************/
+void ClockSync_SetMaster(bool master)
+{
+    ClockSync_Init();
+    LuosHAL_SetIrqState(false);
+    clock_sync.master = master;
+    clock_sync.synced = master;
+    LuosHAL_SetIrqState(true);
+}
+
+/******************************************************************************
+ * @brief Check if this node gives the network time
+ * @param None
+ * @return true if this node is the clock master
+ ******************************************************************************/
+bool ClockSync_IsMaster(void)
+{
+    return clock_sync.master;
+}
+
+/******************************************************************************
+ * @brief Get the sequence of the next sync frame to send
+ * @param None
+ * @return Sequence number
+ ******************************************************************************/
+uint16_t ClockSync_NextSequence(void)
+{
+    return ++sync_sequence;
+}
+
+/******************************************************************************
+ * @brief Correct the network time with a sync frame
+ * A broadcast frame is given to each service of the node, only the first one
+ * is used.
+ * @param sequence : Sequence number of the sync frame
+ * @param error_ns : Network time error, the date of the sync frame
+ * @return None
+ ******************************************************************************/
+void ClockSync_Receive(uint16_t sequence, int64_t error_ns)
+{
+    uint64_t now   = LuosHAL_GetTimestamp();
+    int64_t offset = 0;
+    int64_t delay  = 0;
+    int32_t drift  = model_drift;
+
+    if (clock_sync.master || (clock_sync.synced && (sequence == sync_sequence)))
+    {
+        // This node gives the time or already used this frame
+        return;
+    }
+    offset = ClockSync_GetOffset(now) + error_ns;
+    if ((clock_sync.synced == false) || (error_ns > CLOCK_SYNC_RESET_NS) || (error_ns < -CLOCK_SYNC_RESET_NS))
+    {
+        // The network time is unknown, take it as is
+        drift              = 0;
+        clock_sync.lost_nb = 0;
+    }
+    else
+    {
+        // The error accumulated since the previous sync comes from the drift estimation, half correct it to filter the jitter
+        delay = (int64_t)(now - sync_date);
+        if (delay > 0)
+        {
+            drift += (int32_t)(((error_ns * ((int64_t)1 << CLOCK_SYNC_DRIFT_SHIFT)) / delay) / 2);
+        }
+        clock_sync.lost_nb += (uint16_t)(sequence - sync_sequence - 1);
+    }
+    clock_sync.error_ns = error_ns;
+    clock_sync.sync_nb++;
+    // The model is read by the timestamp conversions in interrupts, don't let them see it half written
+    LuosHAL_SetIrqState(false);
+    clock_sync.synced = true;
+    model_drift       = drift;
+    model_offset      = offset;
+    model_date        = now;
+    LuosHAL_SetIrqState(true);
+    sync_date     = now;
+    sync_sequence = sequence;
+}
+
+/******************************************************************************
+ * @brief Move the drift accumulated since the last update into the offset
+ * Called periodically out of the interrupts to keep the conversion of the
+ * dates short.
+ * @param None
+ * @return None
+ ******************************************************************************/
+void ClockSync_Update(void)
+{
+    uint64_t now   = LuosHAL_GetTimestamp();
+    int64_t offset = 0;
+
+    if ((clock_sync.master == false) && clock_sync.synced)
+    {
+        offset = ClockSync_GetOffset(now);
+        // The model is read by the timestamp conversions in interrupts, don't let them see it half written
+        LuosHAL_SetIrqState(false);
+        model_offset = offset;
+        model_date   = now;
+        LuosHAL_SetIrqState(true);
+    }
+}
+
+/******************************************************************************
+ * @brief Convert a local date into the network time
+ * Called by the timestamp conversions in the reception and transmission
+ * interrupts, no division is done here.
+ * @param local_ns : Local date in ns, given by LuosHAL_GetTimestamp
+ * @return Network date in ns
+ ******************************************************************************/
+_CRITICAL int64_t ClockSync_GetNetworkTime(uint64_t local_ns)
+{
+    return (int64_t)local_ns - ClockSync_GetOffset(local_ns);
+}
+
+/******************************************************************************
+ * @brief Get the state of the network time
+ * @param quality : State to fill
+ * @return None
+ ******************************************************************************/
+void ClockSync_GetQuality(clock_sync_quality_t *quality)
+{
+    uint64_t now = LuosHAL_GetTimestamp();
+
+    memcpy(quality, &clock_sync, sizeof(clock_sync_quality_t));
+    quality->offset_ns = ClockSync_GetOffset(now);
+    quality->drift_ppb = (int32_t)(((int64_t)model_drift * CLOCK_SYNC_PPB) >> CLOCK_SYNC_DRIFT_SHIFT);
+    quality->age_ns    = (clock_sync.synced && !clock_sync.master) ? (now - sync_date) : 0;
+}
+
+/******************************************************************************
+ * @brief Compute the offset between the local time and the network time
+ * @param local_ns : Local date in ns
+ * @return Local time - network time in ns
+ ******************************************************************************/
+_CRITICAL static int64_t ClockSync_GetOffset(uint64_t local_ns)
+{
+    if (clock_sync.synced == false)
+    {
+        return 0;
+    }
+    return model_offset + (((int64_t)(local_ns - model_date) * model_drift) >> CLOCK_SYNC_DRIFT_SHIFT);
+}
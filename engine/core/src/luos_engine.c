@@ -18,12 +18,24 @@
  ******************************************************************************/
 #define BOOT_TIMEOUT 1000
 
+#ifndef LUOS_EVENT_WAIT
+    // This HAL can't sleep until an event, Luos_RunUntilEvent will poll
+    #define LUOS_EVENT_WAIT(timeout_ms)
+#endif
+
 typedef enum
 {
     NODE_INIT,
     NODE_RUN
 } node_state_t;
 
+typedef struct
+{
+    uint16_t service_index; // Local service listening
+    uint16_t source;        // Service publishing the updates
+    uint16_t topic;         // Topic used by the source, 0 if this entry is free
+} update_topic_source_t;
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -37,6 +49,17 @@ uint8_t Flag_DetectServices = 0;
 
 luos_stats_t luos_stats;
 general_stats_t general_stats;
+static uint16_t service_package[MAX_SERVICE_NUMBER]; // Package creating each service
+static uint16_t package_running = 0xFFFF;            // Package running its Init, 0xFFFF if none
+static luos_timer_t auto_refresh_timer[MAX_SERVICE_NUMBER][MAX_UPDATE_SUBSCRIBER];
+static volatile uint16_t auto_refresh_publishing[MAX_SERVICE_NUMBER]; // Topic of the update a service is answering, 0 if none
+static update_topic_source_t update_topic_source[MAX_UPDATE_TOPIC_SOURCE];
+static uint8_t priority_bypass             = 0;            // Messages dispatched ahead of the oldest one in a row
+static service_priority_t highest_priority = LOW_PRIORITY; // Highest priority of the services created
+static luos_timer_t clock_sync_timer;
+#ifdef LUOS_WORKER_NB
+static bool worker_late[MAX_SERVICE_NUMBER]; // Services with a full worker queue during this loop
+#endif
 
 /*******************************************************************************
  * Function
@@ -45,11 +68,37 @@ static error_return_t Luos_MsgHandler(service_t *service, msg_t *input);
 static service_t *Luos_GetService(ll_service_t *ll_service);
 static uint16_t Luos_GetServiceIndex(service_t *service);
 static void Luos_TransmitLocalRoutingTable(service_t *service, msg_t *routeTB_msg);
-static void Luos_AutoUpdateManager(void);
+static void Luos_AutoUpdateSubscribe(service_t *service, uint16_t target, uint32_t period_us);
+static void Luos_AutoUpdateRemove(service_t *service, uint8_t subscriber);
+static void Luos_AutoUpdateGroup(service_t *service, uint32_t period_us);
+static uint16_t Luos_AutoUpdateAllocTopic(service_t *service);
+static void Luos_AutoUpdateTimer(void *arg);
+static void Luos_AutoUpdatePublish(service_t *service, uint16_t source, uint16_t topic);
+static void Luos_AutoUpdateCallback(service_t *service, msg_t *msg);
+static inline void Luos_AutoUpdateTarget(service_t *service, msg_t *msg);
+static void Luos_AutoUpdateClear(service_t *service);
+static void Luos_AutoUpdateStop(void);
+static void Luos_ClockSyncTimer(void *arg);
+static void Luos_UpdateTopicSend(service_t *service, uint16_t target, uint16_t topic);
+static void Luos_UpdateTopicListen(service_t *service, uint16_t source, uint16_t topic);
+static bool Luos_UpdateTopicIsFiltered(service_t *service, msg_t *msg);
+static inline bool Luos_IsIdle(void);
+static bool Luos_HasCallbackTask(void);
 static error_return_t Luos_IsALuosCmd(service_t *service, uint8_t cmd, uint16_t size);
+static error_return_t Luos_NextLuosTask(uint16_t *luos_task_id);
+static error_return_t Luos_SendMsgPayload(service_t *service, msg_t *msg, uint8_t *payload, uint16_t payload_size);
 static inline void Luos_EmptyNode(void);
 static inline void Luos_PackageInit(void);
 static inline void Luos_PackageLoop(void);
+static inline void Luos_PackageDeadlineMiss(void);
+static inline void Luos_ServiceCallback(service_t *service, msg_t *msg);
+static inline void Luos_RunCallback(service_t *service, msg_t *msg);
+#ifdef LUOS_WORKER_NB
+static uint16_t Luos_MsgCopySize(msg_t *msg);
+static bool Luos_WorkerServiceJob(void *arg, void *data);
+static bool Luos_WorkerSendJob(void *arg, void *data);
+static bool Luos_WorkerUpdateJob(void *arg, void *data);
+#endif
 
 /******************************************************************************
  * @brief Luos init must be call in project init
@@ -61,6 +110,9 @@ void Luos_Init(void)
     service_number = 0;
     memset(&luos_stats.unmap[0], 0, sizeof(luos_stats_t));
     LuosHAL_Init();
+    TimerWheel_Init();
+    ClockSync_Init();
+    Profiler_Init();
     Robus_Init(&luos_stats.memory);
 
 #ifdef WITH_BOOTLOADER
@@ -81,9 +133,13 @@ void Luos_Init(void)
 void Luos_Loop(void)
 {
     static uint32_t last_loop_date;
-    uint16_t remaining_msg_number   = 0;
+    uint64_t loop_start_date        = Profiler_Start();
+    uint16_t luos_task_id           = 0;
     ll_service_t *oldest_ll_service = NULL;
     msg_t *returned_msg             = NULL;
+#ifdef LUOS_WORKER_NB
+    memset(worker_late, 0, sizeof(worker_late));
+#endif
 
 #ifdef WITH_BOOTLOADER
     // After 3 Luos_Loop, consider this application as safe and write a flag to let the booloader know it can jump to the application safely.
@@ -107,27 +163,30 @@ void Luos_Loop(void)
     {
         // We receive a reset detection
         // Reset the data reception context
-        Luos_ReceiveData(NULL, NULL, NULL);
+        Luos_ReceiveData(NULL, NULL, NULL, 0);
+        // Services ids are lost, stop the auto updates
+        Luos_AutoUpdateStop();
+        // The clock master may change, restart the synchronisation
+        TimerWheel_Stop(&clock_sync_timer);
+        ClockSync_Init();
     }
     Robus_Loop();
     // look at all received messages
     LUOS_MUTEX_LOCK
-    while (MsgAlloc_LookAtLuosTask(remaining_msg_number, &oldest_ll_service) != FAILED)
+    uint8_t cmd   = 0;
+    uint16_t size = 0;
+    // There is a possibility to receive in IT a START_DETECTION so the task is checked in one shot before doing any treatement
+    // Messages of higher priority services are managed first
+    while (Luos_NextLuosTask(&luos_task_id) != FAILED)
     {
         // There is a message available find the service linked to it
+        MsgAlloc_PeekLuosTask(luos_task_id, &oldest_ll_service, &cmd, &size);
         service_t *service = Luos_GetService(oldest_ll_service);
-        // check if this is a Luos Command
-        uint8_t cmd   = 0;
-        uint16_t size = 0;
-        // There is a possibility to receive in IT a START_DETECTION so check task before doing any treatement
-        if ((MsgAlloc_GetLuosTaskCmd(remaining_msg_number, &cmd) != SUCCEED) || (MsgAlloc_GetLuosTaskSize(remaining_msg_number, &size) != SUCCEED))
-        {
-            break;
-        }
+        LUOS_ASSERT(service != 0);
         // check if this msg cmd should be consumed by Luos_MsgHandler
         if (Luos_IsALuosCmd(service, cmd, size) == SUCCEED)
         {
-            if (MsgAlloc_PullMsgFromLuosTask(remaining_msg_number, &returned_msg) == SUCCEED)
+            if (MsgAlloc_PullMsgFromLuosTask(luos_task_id, &returned_msg) == SUCCEED)
             {
                 // be sure the content of this message need to be managed by Luos and do it if it is.
                 if (Luos_MsgHandler((service_t *)service, returned_msg) == SUCCEED)
@@ -141,50 +200,290 @@ void Luos_Loop(void)
                     // Here we should not have polling services.
                     LUOS_ASSERT(service->service_cb != 0);
                     // This message is for the user, pass it to the user.
-                    service->service_cb(service, returned_msg);
+                    Luos_ServiceCallback(service, returned_msg);
                 }
             }
         }
-        else
+        else if (service->service_cb != 0)
         {
-            // This message is for a service
-            // check if this service have a callback?
-            if (service->service_cb != 0)
+            // This message is for a service with a callback pull the message
+            // Drop the updates published on a shared topic by sources this service didn't subscribe to
+            if ((MsgAlloc_PullMsgFromLuosTask(luos_task_id, &returned_msg) == SUCCEED) && (Luos_UpdateTopicIsFiltered(service, returned_msg) == false))
             {
-                // This service have a callback pull the message
-                if (MsgAlloc_PullMsgFromLuosTask(remaining_msg_number, &returned_msg) == SUCCEED)
-                {
-                    // This message is for the user, pass it to the user.
-                    service->service_cb(service, returned_msg);
-                }
+                // This message is for the user, pass it to the user.
+                Luos_ServiceCallback(service, returned_msg);
             }
-            else
-            {
+        }
 #ifdef BOOTLOADER
-                if (MsgAlloc_PullMsgFromLuosTask(remaining_msg_number, &returned_msg) == SUCCEED)
-                {
-                    LuosBootloader_MsgHandler(returned_msg);
-                }
-#else
-                remaining_msg_number++;
-#endif
+        else
+        {
+            if (MsgAlloc_PullMsgFromLuosTask(luos_task_id, &returned_msg) == SUCCEED)
+            {
+                LuosBootloader_MsgHandler(returned_msg);
             }
         }
+#endif
     }
     LUOS_MUTEX_UNLOCK
+#ifdef LUOS_WORKER_NB
+    // Send messages from services running on workers
+    LuosHAL_WorkerRunCore();
+#endif
     // finish msg used
     MsgAlloc_UsedMsgEnd();
-    // manage timed auto update
-    Luos_AutoUpdateManager();
+    // manage timed auto update and application timers
+    TimerWheel_Loop();
+    // drop the data receptions which stopped
+    Reassembly_Loop();
+    Profiler_Record(PROFILER_LUOS_LOOP, 0, loop_start_date);
     // save loop date
     last_loop_date = LuosHAL_GetSystick();
 
     if (Flag_DetectServices == 1)
     {
         Flag_DetectServices++;
+        Luos_AutoUpdateStop();
         RoutingTB_DetectServices(detection_service);
         Flag_DetectServices = 0;
+        // The detector gives the network time to the other nodes
+        ClockSync_SetMaster(true);
+        if (RoutingTB_BigestNodeID() > 1)
+        {
+            TimerWheel_Start(&clock_sync_timer, 0, CLOCK_SYNC_PERIOD_MS * 1000, Luos_ClockSyncTimer, NULL);
+        }
+    }
+}
+/******************************************************************************
+ * @brief Wait for something to do then run Luos_Loop
+ * Message reception, message transmission and timed auto updates end the wait.
+ * @param timeout_ms : Maximum time to wait in ms
+ * @return None
+ ******************************************************************************/
+void Luos_RunUntilEvent(uint32_t timeout_ms)
+{
+    uint32_t start_date = LuosHAL_GetSystick();
+    uint32_t elapsed_ms = 0;
+    uint32_t wait_ms    = 0;
+    uint64_t next_us    = 0;
+
+    while (Luos_IsIdle() && (elapsed_ms < timeout_ms))
+    {
+        // Don't sleep after the next timer expiration
+        next_us = TimerWheel_NextEvent();
+        if (next_us < 1000)
+        {
+            // Less than a ms to wait, we can't sleep that short
+            break;
+        }
+        wait_ms = ((next_us / 1000) > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)(next_us / 1000);
+        if (wait_ms > (timeout_ms - elapsed_ms))
+        {
+            wait_ms = timeout_ms - elapsed_ms;
+        }
+        LUOS_EVENT_WAIT(wait_ms)
+        elapsed_ms = LuosHAL_GetSystick() - start_date;
+    }
+    Luos_Loop();
+}
+/******************************************************************************
+ * @brief Check if Luos have nothing to do
+ * Messages waiting for a polling service don't need Luos_Loop, they are left
+ * for the application.
+ * @param None
+ * @return true if there is no message to manage, no detection and no timer due
+ ******************************************************************************/
+static inline bool Luos_IsIdle(void)
+{
+#ifdef LUOS_WORKER_NB
+    if (LuosHAL_WorkerCorePending())
+    {
+        return false;
+    }
+#endif
+    return ((MsgAlloc_MsgToInterpretNbr() == 0) && (Flag_DetectServices == 0) && (TimerWheel_NextEvent() != 0) && (Luos_HasCallbackTask() == false));
+}
+/******************************************************************************
+ * @brief Check if a luos task needs Luos_Loop to be managed
+ * @param None
+ * @return true if a message is for a service callback or for Luos
+ ******************************************************************************/
+static bool Luos_HasCallbackTask(void)
+{
+    ll_service_t *ll_service;
+    uint8_t cmd;
+    uint16_t size;
+
+    for (uint16_t i = 0; MsgAlloc_PeekLuosTask(i, &ll_service, &cmd, &size) != FAILED; i++)
+    {
+        service_t *service = Luos_GetService(ll_service);
+        LUOS_ASSERT(service != 0);
+        if ((service->service_cb != 0) || (Luos_IsALuosCmd(service, cmd, size) == SUCCEED))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+/******************************************************************************
+ * @brief Give a message to the service callback
+ * With workers the callback runs later on a worker thread with a copy of the
+ * message because the message memory is released at the end of Luos_Loop.
+ * @param service : Service receiving the message
+ * @param msg : Message to give
+ * @return None
+ ******************************************************************************/
+static inline void Luos_ServiceCallback(service_t *service, msg_t *msg)
+{
+#ifdef LUOS_WORKER_NB
+    // Luos_Loop made sure there is room for it
+#ifdef LUOS_ASSERTION
+    LUOS_ASSERT(LuosHAL_WorkerPost(Luos_GetServiceIndex(service), Luos_WorkerServiceJob, (void *)service, (void *)msg, Luos_MsgCopySize(msg)));
+#else
+    LuosHAL_WorkerPost(Luos_GetServiceIndex(service), Luos_WorkerServiceJob, (void *)service, (void *)msg, Luos_MsgCopySize(msg));
+#endif
+#else
+    Luos_RunCallback(service, msg);
+#endif
+}
+/******************************************************************************
+ * @brief Call the service callback and measure its execution time
+ * @param service : Service receiving the message
+ * @param msg : Message to give
+ * @return None
+ ******************************************************************************/
+static inline void Luos_RunCallback(service_t *service, msg_t *msg)
+{
+    uint64_t start_date = Profiler_Start();
+    service->service_cb(service, msg);
+    Profiler_Record(PROFILER_SERVICE_CB, Luos_GetServiceIndex(service), start_date);
+}
+#ifdef LUOS_WORKER_NB
+/******************************************************************************
+ * @brief Compute the size of a message in memory
+ * @param msg : Message to measure
+ * @return Size of the header, the data and the timestamp
+ ******************************************************************************/
+static uint16_t Luos_MsgCopySize(msg_t *msg)
+{
+    uint16_t size = sizeof(header_t) + ((msg->header.size > MAX_DATA_MSG_SIZE) ? MAX_DATA_MSG_SIZE : msg->header.size);
+    if (Timestamp_IsTimestampMsg(msg))
+    {
+        size += TIMESTAMP_SIZE;
+    }
+    return size;
+}
+/******************************************************************************
+ * @brief Run a service callback on a worker thread
+ * @param arg : Service receiving the message
+ * @param data : Copy of the message
+ * @return true, the job is done
+ ******************************************************************************/
+static bool Luos_WorkerServiceJob(void *arg, void *data)
+{
+    Luos_RunCallback((service_t *)arg, (msg_t *)data);
+    return true;
+}
+/******************************************************************************
+ * @brief Send a message queued by a worker, run by Luos_Loop
+ * The message is already formatted, send it as is to keep its protocol
+ * (timestamp, bulk...).
+ * @param arg : Service sending the message
+ * @param data : Copy of the message
+ * @return false if the TX buffer is full, the message is sent by the next loop
+ ******************************************************************************/
+static bool Luos_WorkerSendJob(void *arg, void *data)
+{
+    return (Robus_SendMsg(((service_t *)arg)->ll_service, (msg_t *)data) != FAILED);
+}
+/******************************************************************************
+ * @brief Run a service callback with an auto update message on a worker thread
+ * @param arg : Service to update
+ * @param data : Copy of the update message
+ * @return true, the job is done
+ ******************************************************************************/
+static bool Luos_WorkerUpdateJob(void *arg, void *data)
+{
+    Luos_AutoUpdateCallback((service_t *)arg, (msg_t *)data);
+    return true;
+}
+#endif
+/******************************************************************************
+ * @brief Find the next message Luos_Loop have to manage
+ * The oldest message of the highest priority service is chosen, but after
+ * PRIORITY_STARVATION_LIMIT messages in a row dispatched ahead of the oldest
+ * one, the oldest one is chosen to bound the latency of low priority services.
+ * Messages waiting for a polling service or a late worker are left in place.
+ * The scan stops on the first task of the highest priority service created,
+ * so the tasks are only all looked at when a more urgent one may be pending.
+ * @param luos_task_id : Index of the luos task to manage
+ * @return SUCCEED if there is a message to manage
+ ******************************************************************************/
+static error_return_t Luos_NextLuosTask(uint16_t *luos_task_id)
+{
+    uint16_t oldest_task_id = 0xFFFF;
+    int16_t best_priority   = -1;
+    ll_service_t *ll_service;
+    uint8_t cmd;
+    uint16_t size;
+
+    for (uint16_t i = 0; MsgAlloc_PeekLuosTask(i, &ll_service, &cmd, &size) != FAILED; i++)
+    {
+        service_t *service = Luos_GetService(ll_service);
+        LUOS_ASSERT(service != 0);
+#ifdef LUOS_WORKER_NB
+        if (service->service_cb != 0)
+        {
+            uint16_t index = Luos_GetServiceIndex(service);
+            if (worker_late[index] || LuosHAL_WorkerIsFull(index))
+            {
+                // The worker of this service is late, keep its messages in order for the next loop
+                worker_late[index] = true;
+                continue;
+            }
+        }
+#endif
+#ifndef BOOTLOADER
+        if ((service->service_cb == 0) && (Luos_IsALuosCmd(service, cmd, size) == FAILED))
+        {
+            // This message is for a polling service, it will pull it itself
+            continue;
+        }
+#endif
+        if (oldest_task_id == 0xFFFF)
+        {
+            oldest_task_id = i;
+        }
+        if ((int16_t)service->priority > best_priority)
+        {
+            *luos_task_id = i;
+            best_priority = (int16_t)service->priority;
+            if (best_priority == (int16_t)highest_priority)
+            {
+                // No service is more urgent, stop the scan. When all the services share
+                // the same priority this is the first task to dispatch.
+                break;
+            }
+        }
+    }
+    if (oldest_task_id == 0xFFFF)
+    {
+        return FAILED;
+    }
+    if (*luos_task_id == oldest_task_id)
+    {
+        priority_bypass = 0;
     }
+    else if (priority_bypass >= PRIORITY_STARVATION_LIMIT)
+    {
+        // Lower priority messages waited long enough
+        *luos_task_id   = oldest_task_id;
+        priority_bypass = 0;
+    }
+    else
+    {
+        priority_bypass++;
+    }
+    return SUCCEED;
 }
 /******************************************************************************
  * @brief Check if this command concern luos
@@ -224,6 +523,7 @@ static error_return_t Luos_IsALuosCmd(service_t *service, uint8_t cmd, uint16_t
         case REVISION:
         case LUOS_REVISION:
         case LUOS_STATISTICS:
+        case LUOS_PROFILE:
             if (size == 0)
             {
                 return SUCCEED;
@@ -236,6 +536,11 @@ static error_return_t Luos_IsALuosCmd(service_t *service, uint8_t cmd, uint16_t
             }
             break;
         case BOOTLOADER_CMD:
+        case RTB_CHUNK:
+        case RTB_STATUS:
+        case RTB_NACK:
+        case UPDATE_TOPIC:
+        case CLOCK_SYNC:
             return SUCCEED;
             break;
         default:
@@ -254,7 +559,6 @@ static error_return_t Luos_MsgHandler(service_t *service, msg_t *input)
 {
     error_return_t consume = FAILED;
     msg_t output_msg;
-    routing_table_t *route_tab = &RoutingTB_Get()[RoutingTB_GetLastEntry()];
     time_luos_t time;
     uint16_t base_id = 0;
 
@@ -316,14 +620,20 @@ static error_return_t Luos_MsgHandler(service_t *service, msg_t *input)
             consume = SUCCEED;
             break;
         case RTB:
-            // Check routing table overflow
-            LUOS_ASSERT(((uintptr_t)route_tab + input->header.size) <= ((uintptr_t)RoutingTB_Get() + (sizeof(routing_table_t) * MAX_RTB_ENTRY)));
-            if (Luos_ReceiveData(service, input, (void *)route_tab) > 0)
-            {
-                // route table section reception complete
-                RoutingTB_ComputeRoutingTableEntryNB();
-                Luos_ResetStatistic();
-            }
+            // Decode and append this local routing table frame
+            RoutingTB_ReceiveEntries(input);
+            consume = SUCCEED;
+            break;
+        case RTB_CHUNK:
+            RoutingTB_ReceiveChunk(input);
+            consume = SUCCEED;
+            break;
+        case RTB_STATUS:
+            RoutingTB_SendMissingChunks(service, input);
+            consume = SUCCEED;
+            break;
+        case RTB_NACK:
+            RoutingTB_ReceiveMissingChunks(input);
             consume = SUCCEED;
             break;
 
@@ -378,6 +688,39 @@ static error_return_t Luos_MsgHandler(service_t *service, msg_t *input)
                 consume = SUCCEED;
             }
             break;
+        case LUOS_PROFILE:
+            if (input->header.size == 0)
+            {
+                profile_stats_t profile;
+                msg_t output;
+                output.header.cmd         = LUOS_PROFILE;
+                output.header.target_mode = SERVICEID;
+                output.header.size        = sizeof(profile_stats_t);
+                output.header.target      = input->header.source;
+                Profiler_GetSummary(PROFILER_SERVICE_CB, Luos_GetServiceIndex(service), &profile.service_cb);
+                Profiler_GetSummary(PROFILER_PACKAGE_LOOP, service_package[Luos_GetServiceIndex(service)], &profile.package_loop);
+                for (uint8_t i = 0; i < (PROFILER_PROBE_NB - PROFILER_LUOS_LOOP); i++)
+                {
+                    Profiler_GetSummary(PROFILER_LUOS_LOOP + i, 0, &profile.node[i]);
+                }
+                memcpy(output.data, profile.unmap, sizeof(profile_stats_t));
+                Luos_SendMsg(service, &output);
+                consume = SUCCEED;
+            }
+            break;
+        case CLOCK_SYNC:
+            if (input->header.size == sizeof(uint16_t))
+            {
+                uint16_t sequence = 0;
+                memcpy(&sequence, input->data, sizeof(uint16_t));
+                ClockSync_Receive(sequence, Timestamp_GetTimestampNs(input));
+                if (TimerWheel_IsRunning(&clock_sync_timer) == false)
+                {
+                    TimerWheel_Start(&clock_sync_timer, CLOCK_SYNC_PERIOD_MS * 1000, CLOCK_SYNC_PERIOD_MS * 1000, Luos_ClockSyncTimer, NULL);
+                }
+            }
+            consume = SUCCEED;
+            break;
         case WRITE_ALIAS:
             // Save this alias into the service
             Luos_UpdateAlias(service, (const char *)input->data, input->header.size);
@@ -387,10 +730,31 @@ static error_return_t Luos_MsgHandler(service_t *service, msg_t *input)
         case UPDATE_PUB:
             // this service need to be auto updated
             TimeOD_TimeFromMsg(&time, input);
-            service->auto_refresh.target      = input->header.source;
-            service->auto_refresh.time_ms     = (uint16_t)TimeOD_TimeTo_ms(time);
-            service->auto_refresh.last_update = LuosHAL_GetSystick();
-            consume                           = SUCCEED;
+            Luos_AutoUpdateSubscribe(service, input->header.source, (uint32_t)(TimeOD_TimeTo_us(time) + 0.5));
+            consume = SUCCEED;
+            break;
+        case UPDATE_TOPIC:
+            if (input->header.size == 0)
+            {
+                // This subscriber can't listen to our topic, update it directly
+                for (uint8_t i = 0; i < MAX_UPDATE_SUBSCRIBER; i++)
+                {
+                    if ((service->auto_refresh[i].period_us != 0) && (service->auto_refresh[i].target == input->header.source))
+                    {
+                        service->auto_refresh[i].topic = UPDATE_TOPIC_REFUSED;
+                        Luos_AutoUpdateGroup(service, service->auto_refresh[i].period_us);
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                // The source of our updates tell us where to find them
+                uint16_t topic;
+                memcpy(&topic, input->data, sizeof(uint16_t));
+                Luos_UpdateTopicListen(service, input->header.source, topic);
+            }
+            consume = SUCCEED;
             break;
         case VERBOSE:
             // this node should send messages to all the network
@@ -412,112 +776,516 @@ static error_return_t Luos_MsgHandler(service_t *service, msg_t *input)
  * @param ll_service : low level service
  * @return Service from list
  ******************************************************************************/
-static service_t *Luos_GetService(ll_service_t *ll_service)
+static service_t *Luos_GetService(ll_service_t *ll_service)
+{
+    return (service_t *)ll_service->upper_service;
+}
+/******************************************************************************
+ * @brief Get this index of the service
+ * @param Service
+ * @return Service from list
+ ******************************************************************************/
+static uint16_t Luos_GetServiceIndex(service_t *service)
+{
+    // Don't dereference the service before being sure it is one of ours
+    uintptr_t offset = (uintptr_t)service - (uintptr_t)&service_table[0];
+    if ((offset < (uintptr_t)service_number * sizeof(service_t)) && ((offset % sizeof(service_t)) == 0))
+    {
+        return (uint16_t)(offset / sizeof(service_t));
+    }
+    return 0xFFFF;
+}
+/******************************************************************************
+ * @brief Transmit local RTB to network
+ * @param service
+ * @param routeTB_msg : Loca RTB message to transmit
+ * @return none
+ ******************************************************************************/
+static void Luos_TransmitLocalRoutingTable(service_t *service, msg_t *routeTB_msg)
+{
+    uint16_t entry_nb = 0;
+    routing_table_t local_routing_table[service_number + 1];
+
+    // start by saving node entry
+    RoutingTB_ConvertNodeToRoutingTable(&local_routing_table[entry_nb], Robus_GetNode());
+    entry_nb++;
+    // save services entry
+    for (uint16_t i = 0; i < service_number; i++)
+    {
+        RoutingTB_ConvertServiceToRoutingTable((routing_table_t *)&local_routing_table[entry_nb++], &service_table[i]);
+    }
+    RoutingTB_SendEntries(service, routeTB_msg, local_routing_table, entry_nb);
+}
+/******************************************************************************
+ * @brief Add, change or remove (null period) an auto update subscriber
+ * @param service : Service to update
+ * @param target : Subscriber
+ * @param period_us : Update period in us
+ * @return none
+ ******************************************************************************/
+static void Luos_AutoUpdateSubscribe(service_t *service, uint16_t target, uint32_t period_us)
+{
+    uint8_t subscriber = MAX_UPDATE_SUBSCRIBER;
+
+    for (uint8_t i = 0; i < MAX_UPDATE_SUBSCRIBER; i++)
+    {
+        if (service->auto_refresh[i].period_us == 0)
+        {
+            if (subscriber == MAX_UPDATE_SUBSCRIBER)
+            {
+                // Keep the first free place
+                subscriber = i;
+            }
+        }
+        else if (service->auto_refresh[i].target == target)
+        {
+            if (service->auto_refresh[i].period_us == period_us)
+            {
+                // Nothing change
+                return;
+            }
+            // Remove it from its previous group
+            Luos_AutoUpdateRemove(service, i);
+            subscriber = i;
+            break;
+        }
+    }
+    if ((period_us == 0) || (subscriber == MAX_UPDATE_SUBSCRIBER))
+    {
+        // Nothing more to do or no more room for a new subscriber
+        return;
+    }
+    service->auto_refresh[subscriber].target    = target;
+    service->auto_refresh[subscriber].period_us = period_us;
+    service->auto_refresh[subscriber].topic     = 0;
+    Luos_AutoUpdateGroup(service, period_us);
+}
+/******************************************************************************
+ * @brief Remove an auto update subscriber
+ * @param service : Service to update
+ * @param subscriber : Index of the subscriber
+ * @return none
+ ******************************************************************************/
+static void Luos_AutoUpdateRemove(service_t *service, uint8_t subscriber)
+{
+    uint32_t period_us = service->auto_refresh[subscriber].period_us;
+
+    TimerWheel_Stop(&auto_refresh_timer[Luos_GetServiceIndex(service)][subscriber]);
+    if ((service->auto_refresh[subscriber].topic != 0) && (service->auto_refresh[subscriber].topic != UPDATE_TOPIC_REFUSED))
+    {
+        // This subscriber don't need to listen to the topic anymore
+        Luos_UpdateTopicSend(service, service->auto_refresh[subscriber].target, 0);
+    }
+    service->auto_refresh[subscriber].target    = 0;
+    service->auto_refresh[subscriber].period_us = 0;
+    service->auto_refresh[subscriber].topic     = 0;
+    Luos_AutoUpdateGroup(service, period_us);
+}
+/******************************************************************************
+ * @brief Organize the subscribers sharing the same period
+ * Only the timer of the first subscriber of the group runs. If at least 2
+ * subscribers of the group are able to listen to a topic, the update is
+ * published once on a topic instead of being sent to each of them.
+ * @param service : Service to update
+ * @param period_us : Period of the group
+ * @return none
+ ******************************************************************************/
+static void Luos_AutoUpdateGroup(service_t *service, uint32_t period_us)
+{
+    uint16_t index     = Luos_GetServiceIndex(service);
+    uint8_t leader     = MAX_UPDATE_SUBSCRIBER;
+    uint8_t listener   = 0;
+    uint16_t topic     = 0;
+    uint64_t next_date = 0;
+    uint64_t now       = TimerWheel_Now();
+
+    if (period_us == 0)
+    {
+        return;
+    }
+    for (uint8_t i = 0; i < MAX_UPDATE_SUBSCRIBER; i++)
+    {
+        if (service->auto_refresh[i].period_us != period_us)
+        {
+            continue;
+        }
+        if (leader == MAX_UPDATE_SUBSCRIBER)
+        {
+            leader = i;
+        }
+        if (TimerWheel_IsRunning(&auto_refresh_timer[index][i]))
+        {
+            // Keep the phase of the group
+            next_date = auto_refresh_timer[index][i].expiry;
+            TimerWheel_Stop(&auto_refresh_timer[index][i]);
+        }
+        if (service->auto_refresh[i].topic != UPDATE_TOPIC_REFUSED)
+        {
+            listener++;
+            if (service->auto_refresh[i].topic != 0)
+            {
+                topic = service->auto_refresh[i].topic;
+            }
+        }
+    }
+    if (leader == MAX_UPDATE_SUBSCRIBER)
+    {
+        // This group is empty
+        return;
+    }
+    if ((listener < 2) || (service->service_cb == 0))
+    {
+        // Polling services answer whenever they want, we can't redirect them to a topic
+        topic = 0;
+    }
+    else if (topic == 0)
+    {
+        topic = Luos_AutoUpdateAllocTopic(service);
+    }
+    // Tell the subscribers where to get the update
+    for (uint8_t i = 0; i < MAX_UPDATE_SUBSCRIBER; i++)
+    {
+        if ((service->auto_refresh[i].period_us == period_us) && (service->auto_refresh[i].topic != UPDATE_TOPIC_REFUSED) && (service->auto_refresh[i].topic != topic))
+        {
+            Luos_UpdateTopicSend(service, service->auto_refresh[i].target, topic);
+            service->auto_refresh[i].topic = topic;
+        }
+    }
+    TimerWheel_Start(&auto_refresh_timer[index][leader], (next_date > now) ? (uint32_t)(next_date - now) : period_us, period_us, Luos_AutoUpdateTimer, (void *)&auto_refresh_timer[index][leader]);
+}
+/******************************************************************************
+ * @brief Find a topic not used by the other groups of a service
+ * @param service : Service to update
+ * @return Topic, 0 if there is no topic available
+ ******************************************************************************/
+static uint16_t Luos_AutoUpdateAllocTopic(service_t *service)
+{
+    uint16_t topic;
+    bool used;
+
+    // Start from a different topic for each service to limit the sharing of topics between nodes
+    for (uint16_t offset = 0; offset < UPDATE_TOPIC_NB; offset++)
+    {
+        topic = FIRST_UPDATE_TOPIC + ((service->ll_service->id + offset) % UPDATE_TOPIC_NB);
+        used  = false;
+        for (uint8_t i = 0; i < MAX_UPDATE_SUBSCRIBER; i++)
+        {
+            if ((service->auto_refresh[i].period_us) && (service->auto_refresh[i].topic == topic))
+            {
+                used = true;
+                break;
+            }
+        }
+        if (used == false)
+        {
+            return topic;
+        }
+    }
+    return 0;
+}
+/******************************************************************************
+ * @brief Auto update publication for a group of subscribers, called by the timer wheel
+ * @param arg : Timer of the first subscriber of the group
+ * @return none
+ ******************************************************************************/
+static void Luos_AutoUpdateTimer(void *arg)
+{
+    uint16_t timer_index = (luos_timer_t *)arg - &auto_refresh_timer[0][0];
+    service_t *service   = &service_table[timer_index / MAX_UPDATE_SUBSCRIBER];
+    uint32_t period_us   = service->auto_refresh[timer_index % MAX_UPDATE_SUBSCRIBER].period_us;
+    uint16_t topic       = 0;
+
+    // check if services have an actual ID. If not, we are in detection mode and should reset the auto refresh
+    if (service->ll_service->id == DEFAULTID)
+    {
+        Luos_AutoUpdateClear(service);
+        return;
+    }
+    // Stop updating a dead target
+    for (uint8_t i = 0; i < MAX_UPDATE_SUBSCRIBER; i++)
+    {
+        if ((service->auto_refresh[i].period_us == period_us) && (service->ll_service->dead_service_spotted == service->auto_refresh[i].target))
+        {
+            // The group changed, the next publication will be done by the new group
+            Luos_AutoUpdateRemove(service, i);
+            return;
+        }
+    }
+    for (uint8_t i = 0; i < MAX_UPDATE_SUBSCRIBER; i++)
+    {
+        if (service->auto_refresh[i].period_us != period_us)
+        {
+            continue;
+        }
+        if ((service->auto_refresh[i].topic == 0) || (service->auto_refresh[i].topic == UPDATE_TOPIC_REFUSED))
+        {
+            Luos_AutoUpdatePublish(service, service->auto_refresh[i].target, 0);
+        }
+        else
+        {
+            // All the listeners of the group share the same publication
+            topic = service->auto_refresh[i].topic;
+        }
+    }
+    if (topic != 0)
+    {
+        Luos_AutoUpdatePublish(service, topic, topic);
+    }
+}
+/******************************************************************************
+ * @brief Ask a service to publish its data
+ * @param service : Service to update
+ * @param source : Subscriber asking for the update, or the topic
+ * @param topic : Topic to publish on, 0 to answer to the subscriber
+ * @return none
+ ******************************************************************************/
+static void Luos_AutoUpdatePublish(service_t *service, uint16_t source, uint16_t topic)
+{
+    // This service need to send an update
+    // Create a fake message for it from the service asking for update
+    msg_t updt_msg;
+    updt_msg.header.config      = BASE_PROTOCOL;
+    updt_msg.header.target      = service->ll_service->id;
+    updt_msg.header.source      = source;
+    updt_msg.header.target_mode = (topic != 0) ? TOPIC : SERVICEIDACK;
+    updt_msg.header.cmd         = GET_CMD;
+    updt_msg.header.size        = 0;
+    if ((service->service_cb != 0))
+    {
+#ifdef LUOS_WORKER_NB
+        if (LuosHAL_WorkerIsFull(Luos_GetServiceIndex(service)))
+        {
+            // The service is late, skip this update
+            return;
+        }
+        LuosHAL_WorkerPost(Luos_GetServiceIndex(service), Luos_WorkerUpdateJob, (void *)service, (void *)&updt_msg, Luos_MsgCopySize(&updt_msg));
+#else
+        Luos_AutoUpdateCallback(service, &updt_msg);
+#endif
+    }
+    else
+    {
+        if (Robus_IsNodeDetected() == DETECTION_OK)
+        {
+            // directly transmit the message in Localhost
+            Robus_SetTxTask(service->ll_service, &updt_msg);
+        }
+    }
+}
+/******************************************************************************
+ * @brief Give an auto update message to the service callback
+ * @param service : Service to update
+ * @param msg : Update message
+ * @return none
+ ******************************************************************************/
+static void Luos_AutoUpdateCallback(service_t *service, msg_t *msg)
+{
+    uint16_t index = Luos_GetServiceIndex(service);
+
+    // Let Luos_SendMsg publish the answer on the topic whatever the target mode used by the service
+    auto_refresh_publishing[index] = (msg->header.target_mode == TOPIC) ? msg->header.source : 0;
+    Luos_RunCallback(service, msg);
+    auto_refresh_publishing[index] = 0;
+}
+/******************************************************************************
+ * @brief Publish on the topic the answer of a service to a grouped auto update
+ * @param service : Service sending
+ * @param msg : Message to send
+ * @return none
+ ******************************************************************************/
+static inline void Luos_AutoUpdateTarget(service_t *service, msg_t *msg)
+{
+    uint16_t index = Luos_GetServiceIndex(service);
+
+#ifdef LUOS_WORKER_NB
+    if (LuosHAL_WorkerIsCore())
+    {
+        // Callbacks run on workers, messages sent by Luos_Loop have already been redirected
+        return;
+    }
+#endif
+    if ((index < MAX_SERVICE_NUMBER) && (auto_refresh_publishing[index] != 0) && (msg->header.target == auto_refresh_publishing[index]))
+    {
+        msg->header.target_mode = TOPIC;
+    }
+}
+/******************************************************************************
+ * @brief Remove all the auto update subscribers of a service
+ * @param service : Service to clear
+ * @return none
+ ******************************************************************************/
+static void Luos_AutoUpdateClear(service_t *service)
 {
-    for (uint16_t i = 0; i < service_number; i++)
+    uint16_t index = Luos_GetServiceIndex(service);
+
+    for (uint8_t i = 0; i < MAX_UPDATE_SUBSCRIBER; i++)
     {
-        if (ll_service == service_table[i].ll_service)
-        {
-            return &service_table[i];
-        }
+        TimerWheel_Stop(&auto_refresh_timer[index][i]);
+        service->auto_refresh[i].target    = 0;
+        service->auto_refresh[i].period_us = 0;
+        service->auto_refresh[i].topic     = 0;
     }
-    return 0;
 }
 /******************************************************************************
- * @brief Get this index of the service
- * @param Service
- * @return Service from list
+ * @brief Stop the auto updates of all services, ids are not valid anymore
+ * @param none
+ * @return none
  ******************************************************************************/
-static uint16_t Luos_GetServiceIndex(service_t *service)
+static void Luos_AutoUpdateStop(void)
 {
     for (uint16_t i = 0; i < service_number; i++)
     {
-        if (service == &service_table[i])
+        Luos_AutoUpdateClear(&service_table[i]);
+    }
+    // Stop listening to the updates of other services
+    for (uint16_t i = 0; i < MAX_UPDATE_TOPIC_SOURCE; i++)
+    {
+        if ((update_topic_source[i].topic != 0) && (update_topic_source[i].service_index < service_number))
         {
-            return i;
+            Robus_TopicUnsubscribe(service_table[update_topic_source[i].service_index].ll_service, update_topic_source[i].topic);
         }
+        update_topic_source[i].topic = 0;
     }
-    return 0xFFFF;
 }
 /******************************************************************************
- * @brief Transmit local RTB to network
- * @param service
- * @param routeTB_msg : Loca RTB message to transmit
- * @return none
+ * @brief Keep the network time, broadcast a sync frame on the master side
+ * The frame is timestamped with the date 0, the transmission converts it
+ * into the network time at the transmission start. Other nodes update their
+ * network time model out of the interrupts.
+ * @param arg : Unused
+ * @return None
  ******************************************************************************/
-static void Luos_TransmitLocalRoutingTable(service_t *service, msg_t *routeTB_msg)
+static void Luos_ClockSyncTimer(void *arg)
 {
-    uint16_t entry_nb = 0;
-    routing_table_t local_routing_table[service_number + 1];
+    msg_t sync_msg;
+    uint16_t sequence = 0;
 
-    // start by saving node entry
-    RoutingTB_ConvertNodeToRoutingTable(&local_routing_table[entry_nb], Robus_GetNode());
-    entry_nb++;
-    // save services entry
-    for (uint16_t i = 0; i < service_number; i++)
+    (void)arg;
+    if (ClockSync_IsMaster() == false)
     {
-        RoutingTB_ConvertServiceToRoutingTable((routing_table_t *)&local_routing_table[entry_nb++], &service_table[i]);
+        ClockSync_Update();
+        return;
     }
-    Luos_SendData(service, routeTB_msg, (void *)local_routing_table, (entry_nb * sizeof(routing_table_t)));
+    sequence = ClockSync_NextSequence();
+    sync_msg.header.target_mode = BROADCAST;
+    sync_msg.header.target      = BROADCAST_VAL;
+    sync_msg.header.cmd         = CLOCK_SYNC;
+    sync_msg.header.size        = sizeof(uint16_t);
+    memcpy(sync_msg.data, &sequence, sizeof(uint16_t));
+    Luos_SendTimestampMsg(detection_service, &sync_msg, TimeOD_TimeFrom_ns(0.0));
 }
 /******************************************************************************
- * @brief Auto update publication for service
- * @param none
+ * @brief Tell a subscriber the topic to listen to get its updates
+ * @param service : Service sending the updates
+ * @param target : Subscriber
+ * @param topic : Topic to listen, 0 to stop listening
  * @return none
  ******************************************************************************/
-static void Luos_AutoUpdateManager(void)
+static void Luos_UpdateTopicSend(service_t *service, uint16_t target, uint16_t topic)
 {
-    // check all services timed_update_t contexts
-    for (uint16_t i = 0; i < service_number; i++)
+    msg_t msg;
+    msg.header.target      = target;
+    msg.header.target_mode = SERVICEIDACK;
+    msg.header.cmd         = UPDATE_TOPIC;
+    msg.header.size        = sizeof(uint16_t);
+    memcpy(msg.data, &topic, sizeof(uint16_t));
+    Luos_SendMsg(service, &msg);
+}
+/******************************************************************************
+ * @brief Listen to the topic used by a source to publish the updates we asked for
+ * @param service : Subscriber
+ * @param source : Service sending the updates
+ * @param topic : Topic to listen, 0 to stop listening
+ * @return none
+ ******************************************************************************/
+static void Luos_UpdateTopicListen(service_t *service, uint16_t source, uint16_t topic)
+{
+    uint16_t index     = Luos_GetServiceIndex(service);
+    uint16_t place     = MAX_UPDATE_TOPIC_SOURCE;
+    uint16_t old_topic = 0;
+    msg_t msg;
+
+    for (uint16_t i = 0; i < MAX_UPDATE_TOPIC_SOURCE; i++)
     {
-        // check if services have an actual ID. If not, we are in detection mode and should reset the auto refresh
-        if (service_table[i].ll_service->id == DEFAULTID)
+        if (update_topic_source[i].topic == 0)
         {
-            // this service have not been detected or is in detection mode. remove auto_refresh parameters
-            service_table[i].auto_refresh.target      = 0;
-            service_table[i].auto_refresh.time_ms     = 0;
-            service_table[i].auto_refresh.last_update = 0;
+            if (place == MAX_UPDATE_TOPIC_SOURCE)
+            {
+                place = i;
+            }
         }
-        else
+        else if ((update_topic_source[i].service_index == index) && (update_topic_source[i].source == source))
+        {
+            old_topic                    = update_topic_source[i].topic;
+            update_topic_source[i].topic = 0;
+            place                        = i;
+            break;
+        }
+    }
+    if (old_topic != 0)
+    {
+        // Stop listening to the previous topic if no other source use it
+        for (uint16_t i = 0; i < MAX_UPDATE_TOPIC_SOURCE; i++)
         {
-            // check if there is a timed update setted and if it's time to update it.
-            if (service_table[i].auto_refresh.time_ms)
+            if ((update_topic_source[i].service_index == index) && (update_topic_source[i].topic == old_topic))
             {
-                if (service_table[i].ll_service->dead_service_spotted == service_table[i].auto_refresh.target)
-                {
-                    service_table[i].auto_refresh.target      = 0;
-                    service_table[i].auto_refresh.time_ms     = 0;
-                    service_table[i].auto_refresh.last_update = 0;
-                    continue;
-                }
-                if ((LuosHAL_GetSystick() - service_table[i].auto_refresh.last_update) >= service_table[i].auto_refresh.time_ms)
-                {
-                    // This service need to send an update
-                    // Create a fake message for it from the service asking for update
-                    msg_t updt_msg;
-                    updt_msg.header.config      = BASE_PROTOCOL;
-                    updt_msg.header.target      = service_table[i].ll_service->id;
-                    updt_msg.header.source      = service_table[i].auto_refresh.target;
-                    updt_msg.header.target_mode = SERVICEIDACK;
-                    updt_msg.header.cmd         = GET_CMD;
-                    updt_msg.header.size        = 0;
-                    if ((service_table[i].service_cb != 0))
-                    {
-                        service_table[i].service_cb(&service_table[i], &updt_msg);
-                    }
-                    else
-                    {
-                        if (Robus_IsNodeDetected() == DETECTION_OK)
-                        {
-                            // directly transmit the message in Localhost
-                            Robus_SetTxTask(service_table[i].ll_service, &updt_msg);
-                        }
-                    }
-                    service_table[i].auto_refresh.last_update = LuosHAL_GetSystick();
-                }
+                old_topic = 0;
+                break;
+            }
+        }
+        if (old_topic != 0)
+        {
+            Robus_TopicUnsubscribe(service->ll_service, old_topic);
+        }
+    }
+    if (topic == 0)
+    {
+        return;
+    }
+    if ((topic < FIRST_UPDATE_TOPIC) || (topic > LAST_TOPIC) || (place == MAX_UPDATE_TOPIC_SOURCE))
+    {
+        // We can't listen to it, ask the source to update us directly
+        msg.header.target      = source;
+        msg.header.target_mode = SERVICEIDACK;
+        msg.header.cmd         = UPDATE_TOPIC;
+        msg.header.size        = 0;
+        Luos_SendMsg(service, &msg);
+        return;
+    }
+    update_topic_source[place].service_index = index;
+    update_topic_source[place].source        = source;
+    update_topic_source[place].topic         = topic;
+    Robus_TopicSubscribe(service->ll_service, topic);
+}
+/******************************************************************************
+ * @brief Check if a message is an update published on a topic by a source we didn't subscribe to
+ * Several services can share the same update topic, we only give to a service the updates it asked for.
+ * @param service : Service receiving the message
+ * @param msg : Message received
+ * @return true if the message have to be dropped
+ ******************************************************************************/
+static bool Luos_UpdateTopicIsFiltered(service_t *service, msg_t *msg)
+{
+    uint16_t index = 0;
+    bool listening = false;
+
+    if ((msg->header.target_mode != TOPIC) || (msg->header.target < FIRST_UPDATE_TOPIC) || (msg->header.target > LAST_TOPIC))
+    {
+        return false;
+    }
+    index = Luos_GetServiceIndex(service);
+    for (uint16_t i = 0; i < MAX_UPDATE_TOPIC_SOURCE; i++)
+    {
+        if ((update_topic_source[i].topic == msg->header.target) && (update_topic_source[i].service_index == index))
+        {
+            if (update_topic_source[i].source == msg->header.source)
+            {
+                return false;
             }
+            listening = true;
         }
     }
+    return listening;
 }
 /******************************************************************************
  * @brief Clear list of service
@@ -526,7 +1294,9 @@ static void Luos_AutoUpdateManager(void)
  ******************************************************************************/
 void Luos_ServicesClear(void)
 {
-    service_number = 0;
+    Luos_AutoUpdateStop();
+    service_number   = 0;
+    highest_priority = LOW_PRIORITY;
     Robus_ServicesClear();
 }
 /******************************************************************************
@@ -538,6 +1308,19 @@ void Luos_ServicesClear(void)
  * @return Service object pointer.
  ******************************************************************************/
 service_t *Luos_CreateService(SERVICE_CB service_cb, uint8_t type, const char *alias, revision_t revision)
+{
+    return Luos_CreateServiceWithPriority(service_cb, type, alias, revision, NORMAL_PRIORITY);
+}
+/******************************************************************************
+ * @brief API to Create a service managing its messages with a given priority
+ * @param service_cb : Callback msg handler for the service
+ * @param type of service corresponding to object dictionnary
+ * @param alias for the service string (15 caracters max).
+ * @param version FW for the service (tab[MajorVersion,MinorVersion,Patch])
+ * @param priority : Priority of the service messages in Luos_Loop
+ * @return Service object pointer.
+ ******************************************************************************/
+service_t *Luos_CreateServiceWithPriority(SERVICE_CB service_cb, uint8_t type, const char *alias, revision_t revision, service_priority_t priority)
 {
     uint8_t i           = 0;
     service_t *service  = &service_table[service_number];
@@ -545,6 +1328,11 @@ service_t *Luos_CreateService(SERVICE_CB service_cb, uint8_t type, const char *a
 
     // Link the service to his callback
     service->service_cb = service_cb;
+    service->priority   = priority;
+    if (priority > highest_priority)
+    {
+        highest_priority = priority;
+    }
 
     // Initialise the service aliases to 0
     memset((void *)service->default_alias, 0, MAX_ALIAS_SIZE);
@@ -572,6 +1360,15 @@ service_t *Luos_CreateService(SERVICE_CB service_cb, uint8_t type, const char *a
     service->node_statistics               = &luos_stats;
     service->ll_service->ll_stat.max_retry = &service->statistics.max_retry;
 
+    // Link the low level service back to this one for constant time dispatching
+    service->ll_service->upper_service = (void *)service;
+    // Profile the service with the loop of the package creating it
+    service_package[service_number] = package_running;
+#ifdef LUOS_WORKER_NB
+    // Each service have its own worker queue
+    LUOS_ASSERT(service_number < LUOS_WORKER_QUEUE_NB);
+#endif
+
     service_number++;
     LUOS_ASSERT(service_number <= MAX_SERVICE_NUMBER);
     return service;
@@ -586,7 +1383,20 @@ error_return_t Luos_SendMsg(service_t *service, msg_t *msg)
 {
     // set protocol version
     msg->header.config = BASE_PROTOCOL;
-
+    return Luos_SendMsgPayload(service, msg, msg->data, msg->header.size);
+}
+/******************************************************************************
+ * @brief Send msg through network with a payload stored outside of it
+ * The payload is copied once, directly into the message buffer, the data
+ * following it (timestamp...) are taken from the message.
+ * @param Service : Who send
+ * @param Message : Header to send
+ * @param payload : Data to send
+ * @param payload_size : Number of bytes of the payload, the first ones of the data
+ * @return SUCCEED : If the message is sent, else FAILED or PROHIBITED
+ ******************************************************************************/
+static error_return_t Luos_SendMsgPayload(service_t *service, msg_t *msg, uint8_t *payload, uint16_t payload_size)
+{
     if (service == 0)
     {
         // There is no service specified here, take the first one
@@ -598,7 +1408,19 @@ error_return_t Luos_SendMsg(service_t *service, msg_t *msg)
         // We can't send it
         return PROHIBITED;
     }
-    return Robus_SendMsg(service->ll_service, msg);
+    Luos_AutoUpdateTarget(service, msg);
+#ifdef LUOS_WORKER_NB
+    if (!LuosHAL_WorkerIsCore())
+    {
+        // Robus belongs to the Luos_Loop thread, let it send a copy of this message
+        if (payload != msg->data)
+        {
+            memcpy(msg->data, payload, (payload_size > MAX_DATA_MSG_SIZE) ? MAX_DATA_MSG_SIZE : payload_size);
+        }
+        return LuosHAL_WorkerPost(LUOS_WORKER_CORE_QUEUE, Luos_WorkerSendJob, (void *)service, (void *)msg, Luos_MsgCopySize(msg)) ? SUCCEED : FAILED;
+    }
+#endif
+    return Robus_SendMsgPayload(service->ll_service, msg, payload, payload_size);
 }
 
 /******************************************************************************
@@ -612,22 +1434,7 @@ error_return_t Luos_SendTimestampMsg(service_t *service, msg_t *msg, time_luos_t
 {
     // set timestamp in message
     Timestamp_EncodeMsg(msg, timestamp);
-    if (service == 0)
-    {
-        // There is no service specified here, take the first one
-        service = &service_table[0];
-    }
-    if ((service->ll_service->id == 0) && (msg->header.cmd >= LUOS_LAST_RESERVED_CMD))
-    {
-        // We are in detection mode and this command come from user
-        // We can't send it
-        return PROHIBITED;
-    }
-    if (Robus_SendMsg(service->ll_service, msg) == FAILED)
-    {
-        return FAILED;
-    }
-    return SUCCEED;
+    return Luos_SendMsgPayload(service, msg, msg->data, msg->header.size);
 }
 
 /******************************************************************************
@@ -648,6 +1455,11 @@ error_return_t Luos_ReadMsg(service_t *service, msg_t **returned_msg)
         {
             if (Luos_MsgHandler(service, *returned_msg) == FAILED)
             {
+                if (Luos_UpdateTopicIsFiltered(service, *returned_msg))
+                {
+                    // Drop the updates published on a shared topic by sources this service didn't subscribe to
+                    continue;
+                }
                 LUOS_MUTEX_UNLOCK
                 // This message is for the user, pass it to the user.
                 return SUCCEED;
@@ -690,6 +1502,11 @@ error_return_t Luos_ReadFromService(service_t *service, short id, msg_t **return
                 // check if the content of this message need to be managed by Luos and do it if it is.
                 if ((Luos_MsgHandler(service, *returned_msg) == FAILED) & (error == SUCCEED))
                 {
+                    if (Luos_UpdateTopicIsFiltered(service, *returned_msg))
+                    {
+                        // Drop the updates published on a shared topic by sources this service didn't subscribe to
+                        continue;
+                    }
                     // This message is for the user, pass it to the user.
                     LUOS_MUTEX_UNLOCK
                     return SUCCEED;
@@ -711,44 +1528,47 @@ error_return_t Luos_ReadFromService(service_t *service, short id, msg_t **return
 }
 /******************************************************************************
  * @brief Send large among of data and formating to send into multiple msg
+ * Each message size is the size of the data left to send. Data bigger than
+ * the message size field start in bulk mode: their messages use the
+ * BULK_PROTOCOL and begin with the 32 bits size left to send.
  * @param service : Who send
  * @param message : Message to send
  * @param bin_data : Pointer to the message data table
  * @param size : Size of the data to transmit
  * @return None
  ******************************************************************************/
-void Luos_SendData(service_t *service, msg_t *msg, void *bin_data, uint16_t size)
+void Luos_SendData(service_t *service, msg_t *msg, void *bin_data, uint32_t size)
 {
-    // Compute number of message needed to send this data
-    uint16_t msg_number = 1;
-    uint16_t sent_size  = 0;
-    if (size > MAX_DATA_MSG_SIZE)
-    {
-        msg_number = (size / MAX_DATA_MSG_SIZE);
-        msg_number += (msg_number * MAX_DATA_MSG_SIZE < size);
-    }
+    uint32_t sent_size  = 0;
+    uint32_t left_size  = 0;
+    uint16_t chunk_size = 0;
 
     // Send messages one by one
-    for (uint16_t chunk = 0; chunk < msg_number; chunk++)
+    do
     {
-        // Compute chunk size
-        uint16_t chunk_size = 0;
-        if ((size - sent_size) > MAX_DATA_MSG_SIZE)
+        left_size = size - sent_size;
+        if (left_size > MAX_HEADER_DATA_SIZE)
         {
-            chunk_size = MAX_DATA_MSG_SIZE;
+            // The size left doesn't fit in the header, put it in the data
+            chunk_size = MAX_DATA_MSG_SIZE - BULK_HEADER_SIZE;
+            memcpy(msg->data, &left_size, BULK_HEADER_SIZE);
+            memcpy(&msg->data[BULK_HEADER_SIZE], (uint8_t *)bin_data + sent_size, chunk_size);
+            msg->header.config = BULK_PROTOCOL;
+            msg->header.size   = MAX_DATA_MSG_SIZE;
         }
         else
         {
-            chunk_size = size - sent_size;
+            // Compute chunk size
+            chunk_size = (left_size > MAX_DATA_MSG_SIZE) ? MAX_DATA_MSG_SIZE : left_size;
+            // Copy data into message
+            memcpy(msg->data, (uint8_t *)bin_data + sent_size, chunk_size);
+            msg->header.config = BASE_PROTOCOL;
+            msg->header.size   = left_size;
         }
 
-        // Copy data into message
-        memcpy(msg->data, (uint8_t *)bin_data + sent_size, chunk_size);
-        msg->header.size = size - sent_size;
-
         // Send message
         uint32_t tickstart = Luos_GetSystick();
-        while (Luos_SendMsg(service, msg) == FAILED)
+        while (Luos_SendMsgPayload(service, msg, msg->data, msg->header.size) == FAILED)
         {
             // No more memory space available
             // 500ms of timeout after start trying to load our data in memory. Perhaps the buffer is full of RX messages try to increate the buffer size.
@@ -757,193 +1577,242 @@ void Luos_SendData(service_t *service, msg_t *msg, void *bin_data, uint16_t size
 
         // Save current state
         sent_size = sent_size + chunk_size;
-    }
+    } while (sent_size < size);
 }
 /******************************************************************************
  * @brief Receive a multi msg data
+ * Data from different sources, or to different services, are received in
+ * separate sessions. The buffer given with the first message of a data
+ * receives the whole data.
  * @param service : who receive
  * @param msg : Message chunk received
  * @param bin_data : Pointer to data
+ * @param size : Size of bin_data, a bigger data is dropped
  * @return Valid data received (negative values are errors)
  ******************************************************************************/
-int Luos_ReceiveData(service_t *service, msg_t *msg, void *bin_data)
+int Luos_ReceiveData(service_t *service, msg_t *msg, void *bin_data, uint32_t size)
 {
-    // Manage buffer session (one per service)
-    static uint32_t data_size[MAX_SERVICE_NUMBER]       = {0};
-    static uint32_t total_data_size[MAX_SERVICE_NUMBER] = {0};
-    static uint16_t last_msg_size                       = 0;
-
     // When this function receive a data from a NULL service it is an error and we should reinit the reception state
     if (service == NULL)
     {
-        memset(data_size, 0, sizeof(data_size));
-        memset(total_data_size, 0, sizeof(total_data_size));
-        last_msg_size = 0;
+        Reassembly_Reset();
         return -1;
     }
 
     LUOS_ASSERT(msg != 0);
     LUOS_ASSERT(bin_data != 0);
 
-    uint16_t id = Luos_GetServiceIndex(service);
     // check good service index
-    if (id == 0xFFFF)
+    if (Luos_GetServiceIndex(service) == 0xFFFF)
     {
         return -1;
     }
+    return Reassembly_Receive(service->ll_service->id, msg, bin_data, size, NULL, NULL);
+}
+/******************************************************************************
+ * @brief Receive a multi msg data chunk by chunk
+ * Each chunk is given in order to the sink, followed by SINK_END when the data
+ * is complete or SINK_ABORT if some chunks are missing.
+ * @param service : who receive
+ * @param msg : Message chunk received
+ * @param sink : Function receiving the chunks
+ * @param context : Argument given to the sink
+ * @return Size of the data if complete, 0 if not complete (negative values are errors)
+ ******************************************************************************/
+int Luos_ReceiveDataSink(service_t *service, msg_t *msg, DATA_SINK sink, void *context)
+{
+    LUOS_ASSERT(msg != 0);
+    LUOS_ASSERT(sink != 0);
 
-    // store total size of a msg
-    if (total_data_size[id] == 0)
-    {
-        total_data_size[id] = msg->header.size;
-    }
-
-    LUOS_ASSERT(msg->header.size <= total_data_size[id]);
-
-    // check message integrity
-    if ((last_msg_size > 0) && (last_msg_size - MAX_DATA_MSG_SIZE > msg->header.size))
+    // check good service index
+    if (Luos_GetServiceIndex(service) == 0xFFFF)
     {
-        // we miss a message (a part of the data),
-        // reset session and return an error.
-        data_size[id] = 0;
-        last_msg_size = 0;
         return -1;
     }
-
-    // Get chunk size
-    uint16_t chunk_size = 0;
-    if (msg->header.size > MAX_DATA_MSG_SIZE)
-    {
-        chunk_size = MAX_DATA_MSG_SIZE;
-    }
-    else
-    {
-        chunk_size = msg->header.size;
-    }
-
-    // Copy data into buffer
-    memcpy(bin_data + data_size[id], msg->data, chunk_size);
-
-    // Save buffer session
-    data_size[id] = data_size[id] + chunk_size;
-    last_msg_size = msg->header.size;
-
-    // check
-    LUOS_ASSERT(data_size[id] <= total_data_size[id]);
-
-    // Check end of data
-    if (msg->header.size <= MAX_DATA_MSG_SIZE)
-    {
-        // Data collection finished, reset buffer session state
-        data_size[id]       = 0;
-        last_msg_size       = 0;
-        uint32_t backup     = total_data_size[id];
-        total_data_size[id] = 0;
-        return backup;
-    }
-    return 0;
+    return Reassembly_Receive(service->ll_service->id, msg, NULL, 0, sink, context);
 }
 /******************************************************************************
  * @brief Send datas of a streaming channel
  * @param Service : Who send
  * @param msg : Message to send
  * @param stram: Streaming channel pointer
- * @return None
+ * @return Number of samples overwritten since the previous send
  ******************************************************************************/
-void Luos_SendStreaming(service_t *service, msg_t *msg, streaming_channel_t *stream)
+uint32_t Luos_SendStreaming(service_t *service, msg_t *msg, streaming_channel_t *stream)
 {
     // Compute number of message needed to send available datas on ring buffer
-    Luos_SendStreamingSize(service, msg, stream, Stream_GetAvailableSampleNB(stream));
+    return Luos_SendStreamingSize(service, msg, stream, Stream_GetAvailableSampleNB(stream));
 }
 /******************************************************************************
  * @brief Send a number of datas of a streaming channel
+ * Samples are sent directly from the ring buffer, contiguous part by
+ * contiguous part, and removed from it once their message is accepted.
+ * Samples of a timed channel are sent in standalone timestamped chunks
+ * followed by the sample period in ns, the timestamp being the date of their
+ * first sample.
+ * Samples of a flow controlled channel are sent up to the receiver credit,
+ * the other ones stay in the ring buffer until the next credit.
  * @param service : Who send
  * @param msg : Message to send
  * @param stream : Streaming channel pointer
  * @param max_size : Maximum sample to send
- * @return None
+ * @return Number of samples overwritten since the previous send, the gap before the samples sent
  ******************************************************************************/
-void Luos_SendStreamingSize(service_t *service, msg_t *msg, streaming_channel_t *stream, uint32_t max_size)
+uint32_t Luos_SendStreamingSize(service_t *service, msg_t *msg, streaming_channel_t *stream, uint32_t max_size)
 {
-    // Compute number of message needed to send available datas on ring buffer
-    int msg_number = 1;
-    int data_size  = Stream_GetAvailableSampleNB(stream);
+    const bool timed                 = (stream->period_ns > 0);
+    const uint16_t max_data_msg_size = timed ? ((MAX_DATA_MSG_SIZE - sizeof(int64_t) - TIMESTAMP_SIZE) / stream->data_size) : (MAX_DATA_MSG_SIZE / stream->data_size);
+    uint32_t overwritten             = Stream_GetOverwrittenSampleNB(stream);
+    uint32_t data_size               = Stream_GetAvailableSampleNB(stream);
+    uint16_t slice_size              = 0;
+    uint16_t chunk_size              = 0;
+
     if (data_size > max_size)
     {
         data_size = max_size;
     }
-    const int max_data_msg_size = (MAX_DATA_MSG_SIZE / stream->data_size);
-    if (data_size > max_data_msg_size)
-    {
-        msg_number = (data_size / max_data_msg_size);
-        msg_number += ((msg_number * max_data_msg_size) < data_size);
-    }
-
-    // Send messages one by one
-    for (volatile uint16_t chunk = 0; chunk < msg_number; chunk++)
+    if (stream->flow_control)
     {
-        // compute chunk size
-        uint16_t chunk_size = 0;
-        if (data_size > max_data_msg_size)
-        {
-            chunk_size = max_data_msg_size;
-        }
-        else
+        if (data_size > Stream_GetCreditSampleNB(stream))
         {
-            chunk_size = data_size;
+            data_size = Stream_GetCreditSampleNB(stream);
         }
-
-        // Copy data into message
-        Stream_GetSample(stream, msg->data, chunk_size);
-        msg->header.size = data_size;
-
-        // Send message
-        uint32_t tickstart = Luos_GetSystick();
-        while (Luos_SendMsg(service, msg) == FAILED)
+        if (data_size == 0)
         {
-            // No more memory space available
-            // 500ms of timeout after start trying to load our data in memory. Perhaps the buffer is full of RX messages try to increate the buffer size.
-            LUOS_ASSERT(((volatile uint32_t)Luos_GetSystick() - tickstart) < 500);
+            // The receiver can't take anything for now
+            return overwritten;
         }
-
-        // check end of data
-        if (data_size > max_data_msg_size)
+    }
+    msg->header.config = BASE_PROTOCOL;
+    do
+    {
+        // Send the samples until the end of the ring buffer, then the ones from its beginning
+        slice_size = Stream_GetAvailableSampleNBUntilEndBuffer(stream);
+        if (slice_size > data_size)
         {
-            data_size -= max_data_msg_size;
+            slice_size = data_size;
         }
-        else
+        data_size -= slice_size;
+        // Send messages one by one, each size is the size left to send in this slice
+        do
         {
-            data_size = 0;
-        }
-    }
+            chunk_size = (slice_size > max_data_msg_size) ? max_data_msg_size : slice_size;
+            if (timed)
+            {
+                // The samples are sent from the ring buffer, the period and the timestamp follow them
+                msg->header.size = (chunk_size * stream->data_size) + sizeof(int64_t);
+                memcpy(&msg->data[chunk_size * stream->data_size], &stream->period_ns, sizeof(int64_t));
+                Timestamp_EncodeMsgNs(msg, stream->date_ns);
+            }
+            else
+            {
+                msg->header.size = slice_size * stream->data_size;
+            }
+
+            // Send message
+            uint32_t tickstart = Luos_GetSystick();
+            while (Luos_SendMsgPayload(service, msg, (uint8_t *)stream->sample_ptr, chunk_size * stream->data_size) == FAILED)
+            {
+                // No more memory space available
+                // 500ms of timeout after start trying to load our data in memory. Perhaps the buffer is full of RX messages try to increate the buffer size.
+                LUOS_ASSERT(((volatile uint32_t)Luos_GetSystick() - tickstart) < 500);
+            }
+            // The samples are in the message buffer, release them
+            Stream_RmvAvailableSampleNB(stream, chunk_size);
+            stream->sample_nb += chunk_size;
+            slice_size -= chunk_size;
+        } while (slice_size > 0);
+    } while (data_size > 0);
+    return overwritten;
 }
 /******************************************************************************
  * @brief Receive a streaming channel datas
  * @param service : Who send
  * @param msg : Message to send
  * @param stream : Streaming channel pointer
- * @return error
+ * @return SUCCEED : If the samples are all received, FAILED if more are coming, PROHIBITED if the message is not a streaming chunk
  ******************************************************************************/
 error_return_t Luos_ReceiveStreaming(service_t *service, msg_t *msg, streaming_channel_t *stream)
 {
-    // Get chunk size
-    unsigned short chunk_size = 0;
-    if (msg->header.size > MAX_DATA_MSG_SIZE)
-        chunk_size = MAX_DATA_MSG_SIZE;
-    else
+    (void)service;
+    if (Timestamp_IsTimestampMsg(msg))
+    {
+        // This chunk is standalone, take its time base and date its samples
+        uint16_t sample_nb = 0;
+        if (msg->header.size < sizeof(int64_t))
+        {
+            // There is no period, this is not a timed chunk
+            return PROHIBITED;
+        }
+        sample_nb = (msg->header.size - sizeof(int64_t)) / stream->data_size;
+        memcpy(&stream->period_ns, &msg->data[msg->header.size - sizeof(int64_t)], sizeof(int64_t));
+        Stream_PutTimestampSampleNs(stream, msg->data, sample_nb, Timestamp_GetTimestampNs(msg));
+        stream->sample_nb += sample_nb;
+        return SUCCEED;
+    }
+    // Get chunk size, senders only put entire samples in a message
+    unsigned short chunk_size = (MAX_DATA_MSG_SIZE / stream->data_size) * stream->data_size;
+    if (msg->header.size < chunk_size)
         chunk_size = msg->header.size;
 
     // Copy data into buffer
     Stream_PutSample(stream, msg->data, (chunk_size / stream->data_size));
+    stream->sample_nb += chunk_size / stream->data_size;
 
     // Check end of data
-    if ((msg->header.size <= MAX_DATA_MSG_SIZE))
+    if (msg->header.size == chunk_size)
     {
         // Chunk collection finished
         return SUCCEED;
     }
     return FAILED;
 }
+/******************************************************************************
+ * @brief Advertise the samples a streaming channel accepts to its sender
+ * Call it when the receiver is ready and each time samples are taken out.
+ * @param service : Who receives the samples
+ * @param target : Service sending the samples
+ * @param stream : Streaming channel receiving the samples
+ * @return SUCCEED : If the credit is sent, else FAILED or PROHIBITED
+ ******************************************************************************/
+error_return_t Luos_SendStreamingCredit(service_t *service, uint16_t target, streaming_channel_t *stream)
+{
+    msg_t msg;
+    uint32_t credit = stream->sample_nb + Stream_GetFreeSampleNB(stream);
+
+    msg.header.target_mode = SERVICEIDACK;
+    msg.header.target      = target;
+    msg.header.cmd         = STREAMING_CREDIT;
+    msg.header.size        = sizeof(uint32_t);
+    memcpy(msg.data, &credit, sizeof(uint32_t));
+    return Luos_SendMsg(service, &msg);
+}
+/******************************************************************************
+ * @brief Receive a streaming channel credit
+ * The first credit received enable the flow control of the channel.
+ * @param service : Who sends the samples
+ * @param msg : Message received
+ * @param stream : Streaming channel sending the samples
+ * @return SUCCEED : If the message is a credit, else FAILED
+ ******************************************************************************/
+error_return_t Luos_ReceiveStreamingCredit(service_t *service, msg_t *msg, streaming_channel_t *stream)
+{
+    uint32_t credit = 0;
+
+    (void)service;
+    if ((msg->header.cmd != STREAMING_CREDIT) || (msg->header.size != sizeof(uint32_t)))
+    {
+        return FAILED;
+    }
+    memcpy(&credit, msg->data, sizeof(uint32_t));
+    // Credits can't go back, an older credit may arrive after a newer one
+    if ((stream->flow_control == false) || ((int32_t)(credit - stream->credit) > 0))
+    {
+        stream->credit = credit;
+    }
+    stream->flow_control = true;
+    return SUCCEED;
+}
 /******************************************************************************
  * @brief Store alias name service in flash
  * @param service : Service to store
@@ -1099,8 +1968,27 @@ void Luos_SetVerboseMode(uint8_t mode)
  ******************************************************************************/
 void Luos_AddPackage(void (*Init)(void), void (*Loop)(void))
 {
-    package_table[package_number].Init = Init;
-    package_table[package_number].Loop = Loop;
+    Luos_AddPeriodicPackage(Init, Loop, 0, 0);
+}
+/******************************************************************************
+ * @brief Register a new package with a loop running periodically
+ * A loop exceeding its budget is deferred by its overrun to give this time
+ * back to the other packages. Late and overrunning loops are counted in the
+ * node statistics as deadline misses.
+ * @param Init : Init function name
+ * @param Loop : Loop function name
+ * @param period_us : Period of the loop, 0 to run it on each Luos_Run
+ * @param budget_us : Maximum execution time of the loop, 0 if unlimited
+ * @return None
+ ******************************************************************************/
+void Luos_AddPeriodicPackage(void (*Init)(void), void (*Loop)(void), uint32_t period_us, uint32_t budget_us)
+{
+    LUOS_ASSERT(package_number < MAX_SERVICE_NUMBER);
+    package_table[package_number].Init      = Init;
+    package_table[package_number].Loop      = Loop;
+    package_table[package_number].period_us = period_us;
+    package_table[package_number].budget_us = budget_us;
+    package_table[package_number].next_date = 0;
 
     package_number += 1;
 }
@@ -1127,9 +2015,11 @@ void Luos_PackageInit(void)
     {
         while (package_index < package_number)
         {
+            package_running = package_index;
             package_table[package_index].Init();
             package_index += 1;
         }
+        package_running = 0xFFFF;
     }
     else
     {
@@ -1139,18 +2029,68 @@ void Luos_PackageInit(void)
 
 /******************************************************************************
  * @brief Run each package Loop()
+ * The time is read once, then once after each package loop run. The end of a
+ * package loop is the start of the next one.
  * @param None
  * @return None
  ******************************************************************************/
 void Luos_PackageLoop(void)
 {
     uint16_t package_index = 0;
+    uint64_t start_date    = Profiler_Start();
+    uint64_t end_date      = 0;
+    uint64_t now           = start_date / 1000;
+    uint64_t duration_us   = 0;
+    package_t *package     = NULL;
     while (package_index < package_number)
     {
-        package_table[package_index].Loop();
+        package = &package_table[package_index];
+        if (now >= package->next_date)
+        {
+            if (package->period_us != 0)
+            {
+                if ((package->next_date == 0) || (now >= (package->next_date + package->period_us)))
+                {
+                    if (package->next_date != 0)
+                    {
+                        // We missed at least a period, skip the missed ones
+                        Luos_PackageDeadlineMiss();
+                    }
+                    package->next_date = now;
+                }
+                package->next_date += package->period_us;
+            }
+            package->Loop();
+            end_date    = Profiler_Start();
+            duration_us = (end_date - start_date) / 1000;
+            Profiler_RecordDuration(PROFILER_PACKAGE_LOOP, package_index, (duration_us > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)duration_us);
+            if ((package->budget_us != 0) && (duration_us > package->budget_us))
+            {
+                // This loop overran its budget, defer it to let the others run
+                Luos_PackageDeadlineMiss();
+                if (package->next_date < (now + duration_us + (duration_us - package->budget_us)))
+                {
+                    package->next_date = now + duration_us + (duration_us - package->budget_us);
+                }
+            }
+            start_date = end_date;
+            now        = start_date / 1000;
+        }
         package_index += 1;
     }
 }
+/******************************************************************************
+ * @brief Count a package loop late or overrunning its budget
+ * @param None
+ * @return None
+ ******************************************************************************/
+static inline void Luos_PackageDeadlineMiss(void)
+{
+    if (luos_stats.package_deadline_miss < 0xFF)
+    {
+        luos_stats.package_deadline_miss++;
+    }
+}
 
 /******************************************************************************
  * @brief Luos high level state machine
@@ -1251,3 +2191,23 @@ error_return_t Luos_TopicUnsubscribe(service_t *service, uint16_t topic)
     }
     return Robus_TopicUnsubscribe(service->ll_service, topic);
 }
+/******************************************************************************
+ * @brief Run all the callbacks of a service on a specific worker thread
+ * @param service : Service to pin
+ * @param worker_id : Worker index, -1 to let any available worker run it
+ * @return SUCCEED if the HAL runs services on workers and the worker exists
+ ******************************************************************************/
+error_return_t Luos_SetServiceWorker(service_t *service, int16_t worker_id)
+{
+#ifdef LUOS_WORKER_NB
+    uint16_t index = Luos_GetServiceIndex(service);
+    if ((index != 0xFFFF) && LuosHAL_WorkerPin(index, worker_id))
+    {
+        return SUCCEED;
+    }
+#else
+    (void)service;
+    (void)worker_id;
+#endif
+    return FAILED;
+}
@@ -0,0 +1,169 @@
+/******************************************************************************
+ * @file profiler
+ * @brief Execution time histograms of service callbacks, package loops and
+ *        network loop phases
+ * @author Luos
+ * @version 0.0.0
+ ******************************************************************************/
+#include <string.h>
+#include "profiler.h"
+#include "luos_hal.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define PROFILER_NODE_PROBE_OFFSET (2 * MAX_SERVICE_NUMBER)
+#define PROFILER_HISTOGRAM_NB      (PROFILER_NODE_PROBE_OFFSET + PROFILER_PROBE_NB - PROFILER_LUOS_LOOP)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static profiler_histogram_t profiler_histogram[PROFILER_HISTOGRAM_NB];
+
+/*******************************************************************************
+ * Function
+ ******************************************************************************/
+
+/******************************************************************************
+ * @brief Clear all the histograms
+ * @param None
+ * @return None
+ ******************************************************************************/
+void Profiler_Init(void)
+{
+    memset(profiler_histogram, 0, sizeof(profiler_histogram));
+}
+
+/******************************************************************************
+ * @brief Get the date starting a measure
+ * @param None
+ * @return Date to give to Profiler_Record
+ ******************************************************************************/
+uint64_t Profiler_Start(void)
+{
+    return LuosHAL_GetTimestamp();
+}
+
+/******************************************************************************
+ * @brief Find the histogram of a probe
+ * @param probe : Measured part
+ * @param index : Service or package index, unused by other probes
+ * @return Histogram, NULL if the index is out of range
+ ******************************************************************************/
+profiler_histogram_t *Profiler_GetHistogram(profiler_probe_t probe, uint16_t index)
+{
+    switch (probe)
+    {
+        case PROFILER_SERVICE_CB:
+            return (index < MAX_SERVICE_NUMBER) ? &profiler_histogram[index] : NULL;
+        case PROFILER_PACKAGE_LOOP:
+            return (index < MAX_SERVICE_NUMBER) ? &profiler_histogram[MAX_SERVICE_NUMBER + index] : NULL;
+        default:
+            return (probe < PROFILER_PROBE_NB) ? &profiler_histogram[PROFILER_NODE_PROBE_OFFSET + probe - PROFILER_LUOS_LOOP] : NULL;
+    }
+}
+
+/******************************************************************************
+ * @brief Add the time elapsed since a start date to the histogram of a probe
+ * @param probe : Measured part
+ * @param index : Service or package index, unused by other probes
+ * @param start_date : Date given by Profiler_Start
+ * @return None
+ ******************************************************************************/
+void Profiler_Record(profiler_probe_t probe, uint16_t index, uint64_t start_date)
+{
+    uint64_t elapsed_us = (LuosHAL_GetTimestamp() - start_date) / 1000;
+    Profiler_RecordDuration(probe, index, (elapsed_us > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)elapsed_us);
+}
+
+/******************************************************************************
+ * @brief Add a duration already measured to the histogram of a probe
+ * @param probe : Measured part
+ * @param index : Service or package index, unused by other probes
+ * @param duration_us : Duration in us
+ * @return None
+ ******************************************************************************/
+void Profiler_RecordDuration(profiler_probe_t probe, uint16_t index, uint32_t duration_us)
+{
+    profiler_histogram_t *histogram = Profiler_GetHistogram(probe, index);
+    uint8_t bucket                  = 0;
+
+    if (histogram == NULL)
+    {
+        return;
+    }
+    // Find the position of the most significant bit
+    while ((bucket < (PROFILER_BUCKET_NB - 1)) && ((duration_us >> bucket) != 0))
+    {
+        bucket++;
+    }
+    if (histogram->bucket[bucket] == 0xFFFF)
+    {
+        // Halve all the buckets to keep the shape of the histogram without overflowing
+        for (uint8_t i = 0; i < PROFILER_BUCKET_NB; i++)
+        {
+            histogram->bucket[i] >>= 1;
+        }
+    }
+    histogram->bucket[bucket]++;
+    if ((histogram->count == 0) || (duration_us < histogram->min_us))
+    {
+        histogram->min_us = duration_us;
+    }
+    if (duration_us > histogram->max_us)
+    {
+        histogram->max_us = duration_us;
+    }
+    if (histogram->count < 0xFFFFFFFF)
+    {
+        histogram->count++;
+    }
+}
+
+/******************************************************************************
+ * @brief Compute the summary of a probe
+ * The p99 is the upper bound of the bucket reaching 99% of the measures.
+ * @param probe : Measured part
+ * @param index : Service or package index, unused by other probes
+ * @param summary : Summary to fill
+ * @return None
+ ******************************************************************************/
+void Profiler_GetSummary(profiler_probe_t probe, uint16_t index, profiler_summary_t *summary)
+{
+    profiler_histogram_t *histogram = Profiler_GetHistogram(probe, index);
+    uint32_t total                  = 0;
+    uint32_t cumul                  = 0;
+    uint8_t bucket                  = 0;
+
+    memset(summary, 0, sizeof(profiler_summary_t));
+    if ((histogram == NULL) || (histogram->count == 0))
+    {
+        return;
+    }
+    for (uint8_t i = 0; i < PROFILER_BUCKET_NB; i++)
+    {
+        total += histogram->bucket[i];
+    }
+    // Find the first bucket reaching 99% of the measures
+    for (bucket = 0; bucket < (PROFILER_BUCKET_NB - 1); bucket++)
+    {
+        cumul += histogram->bucket[bucket];
+        if (((uint64_t)cumul * 100) >= ((uint64_t)total * 99))
+        {
+            break;
+        }
+    }
+    summary->count  = histogram->count;
+    summary->min_us = histogram->min_us;
+    summary->max_us = histogram->max_us;
+    summary->p99_us = (bucket == 0) ? 0 : ((1 << bucket) - 1);
+    // The bucket bounds are wider than the measures
+    if ((summary->p99_us > summary->max_us) || (bucket == (PROFILER_BUCKET_NB - 1)))
+    {
+        summary->p99_us = summary->max_us;
+    }
+    if (summary->p99_us < summary->min_us)
+    {
+        summary->p99_us = summary->min_us;
+    }
+}
@@ -0,0 +1,259 @@
+/******************************************************************************
+ * @file reassembly
+ * @brief Reassembly of data split into several messages
+ * @author Luos
+ * @version 0.0.0
+ ******************************************************************************/
+#include <string.h>
+#include "reassembly.h"
+#include "luos_hal.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static reassembly_session_t session_table[MAX_REASSEMBLY_SESSION];
+
+/*******************************************************************************
+ * Function
+ ******************************************************************************/
+static reassembly_session_t *Reassembly_Find(uint16_t source, uint16_t target, uint8_t cmd);
+static reassembly_session_t *Reassembly_Alloc(void);
+static void Reassembly_Abort(reassembly_session_t *session);
+
+/******************************************************************************
+ * @brief Drop all the data in reception
+ * @param None
+ * @return None
+ ******************************************************************************/
+void Reassembly_Reset(void)
+{
+    for (uint8_t i = 0; i < MAX_REASSEMBLY_SESSION; i++)
+    {
+        if (session_table[i].next_size != 0)
+        {
+            Reassembly_Abort(&session_table[i]);
+        }
+    }
+    memset(session_table, 0, sizeof(session_table));
+}
+
+/******************************************************************************
+ * @brief Drop the data without any chunk received for REASSEMBLY_TIMEOUT_MS
+ * Their sink is told the data is not valid and their session is freed.
+ * @param None
+ * @return None
+ ******************************************************************************/
+void Reassembly_Loop(void)
+{
+    uint32_t now = LuosHAL_GetSystick();
+
+    for (uint8_t i = 0; i < MAX_REASSEMBLY_SESSION; i++)
+    {
+        if ((session_table[i].next_size != 0) && ((now - session_table[i].date) > REASSEMBLY_TIMEOUT_MS))
+        {
+            Reassembly_Abort(&session_table[i]);
+            session_table[i].next_size = 0;
+        }
+    }
+}
+
+/******************************************************************************
+ * @brief Add a chunk to the data it belongs to
+ * The buffer or the sink given with the first chunk receives the whole data,
+ * the ones given with the following chunks are ignored.
+ * @param target : Service receiving the chunk
+ * @param msg : Chunk received
+ * @param bin_data : Buffer receiving the data, unused if there is a sink
+ * @param size : Size of the buffer, a bigger data is dropped
+ * @param sink : Sink receiving the data chunk by chunk, NULL to use the buffer
+ * @param context : Argument given to the sink
+ * @return Size of the data if complete, 0 if not complete, -1 if chunks are missing, the data doesn't fit or there is no session available
+ ******************************************************************************/
+int32_t Reassembly_Receive(uint16_t target, msg_t *msg, void *bin_data, uint32_t size, DATA_SINK sink, void *context)
+{
+    reassembly_session_t *session = Reassembly_Find(msg->header.source, target, msg->header.cmd);
+    uint32_t left_size            = msg->header.size;
+    uint8_t *chunk                = msg->data;
+    uint16_t chunk_size           = 0;
+    uint32_t offset               = 0;
+    bool error                    = false;
+    int32_t data_size             = 0;
+
+    if (msg->header.config == BULK_PROTOCOL)
+    {
+        // The size left is in the data
+        if (msg->header.size < BULK_HEADER_SIZE)
+        {
+            return -1;
+        }
+        memcpy(&left_size, msg->data, BULK_HEADER_SIZE);
+        chunk      = &msg->data[BULK_HEADER_SIZE];
+        chunk_size = (msg->header.size > MAX_DATA_MSG_SIZE) ? (MAX_DATA_MSG_SIZE - BULK_HEADER_SIZE) : (msg->header.size - BULK_HEADER_SIZE);
+        if (chunk_size > left_size)
+        {
+            chunk_size = left_size;
+        }
+    }
+    else
+    {
+        chunk_size = (left_size > MAX_DATA_MSG_SIZE) ? MAX_DATA_MSG_SIZE : left_size;
+    }
+
+    if ((session != NULL) && (left_size > session->next_size))
+    {
+        // The end of the previous data is missing, this chunk start a new one
+        Reassembly_Abort(session);
+        session->next_size = 0;
+        session            = NULL;
+    }
+    if (session == NULL)
+    {
+        if ((sink == NULL) && (left_size > size))
+        {
+            // The data doesn't fit in the buffer, drop it
+            if (left_size <= MAX_DATA_MSG_SIZE)
+            {
+                return -1;
+            }
+            error = true;
+        }
+        else if (left_size <= MAX_DATA_MSG_SIZE)
+        {
+            // This data fit in a single message
+            if (sink != NULL)
+            {
+                sink(context, SINK_CHUNK, chunk, chunk_size, 0);
+                sink(context, SINK_END, NULL, 0, chunk_size);
+            }
+            else
+            {
+                memcpy(bin_data, chunk, chunk_size);
+            }
+            return left_size;
+        }
+        session = Reassembly_Alloc();
+        if (session == NULL)
+        {
+            // Too many data in reception
+            return -1;
+        }
+        session->source     = msg->header.source;
+        session->target     = target;
+        session->cmd        = msg->header.cmd;
+        session->lost       = error;
+        session->total_size = left_size;
+        session->next_size  = left_size;
+        session->buffer     = (sink == NULL) ? (uint8_t *)bin_data : NULL;
+        session->sink       = sink;
+        session->context    = context;
+    }
+    session->date = LuosHAL_GetSystick();
+
+    if (error)
+    {
+        // Drop the following chunks of this data
+        session->next_size = left_size - chunk_size;
+        return -1;
+    }
+    if ((left_size < session->next_size) && (session->lost == false))
+    {
+        // We miss some chunks, report it once and drop the end of the data
+        error = true;
+        Reassembly_Abort(session);
+        session->lost = true;
+    }
+    offset             = session->total_size - session->next_size;
+    session->next_size = left_size - chunk_size;
+    if (session->lost == false)
+    {
+        if (session->sink != NULL)
+        {
+            session->sink(session->context, SINK_CHUNK, chunk, chunk_size, offset);
+        }
+        else
+        {
+            memcpy(&session->buffer[offset], chunk, chunk_size);
+        }
+    }
+
+    if (session->next_size == 0)
+    {
+        // This is the last chunk, the session is now free
+        if (session->lost == false)
+        {
+            data_size = (int32_t)session->total_size;
+            if (session->sink != NULL)
+            {
+                session->sink(session->context, SINK_END, NULL, 0, session->total_size);
+            }
+        }
+    }
+    return error ? -1 : data_size;
+}
+
+/******************************************************************************
+ * @brief Tell the sink of a session its data is not valid
+ * @param session : Session dropped
+ * @return None
+ ******************************************************************************/
+static void Reassembly_Abort(reassembly_session_t *session)
+{
+    if ((session->sink != NULL) && (session->lost == false))
+    {
+        session->sink(session->context, SINK_ABORT, NULL, 0, session->total_size - session->next_size);
+    }
+}
+
+/******************************************************************************
+ * @brief Find the session of a data in reception
+ * @param source : Service sending the data
+ * @param target : Service receiving the data
+ * @param cmd : Command of the data messages
+ * @return Session, NULL if there is none
+ ******************************************************************************/
+static reassembly_session_t *Reassembly_Find(uint16_t source, uint16_t target, uint8_t cmd)
+{
+    for (uint8_t i = 0; i < MAX_REASSEMBLY_SESSION; i++)
+    {
+        if ((session_table[i].next_size != 0) && (session_table[i].source == source) && (session_table[i].target == target) && (session_table[i].cmd == cmd))
+        {
+            return &session_table[i];
+        }
+    }
+    return NULL;
+}
+
+/******************************************************************************
+ * @brief Get a free session, reusing the oldest timed out one if there is none
+ * @param None
+ * @return Session, NULL if all sessions are in use
+ ******************************************************************************/
+static reassembly_session_t *Reassembly_Alloc(void)
+{
+    reassembly_session_t *oldest = NULL;
+    uint32_t now                 = LuosHAL_GetSystick();
+
+    for (uint8_t i = 0; i < MAX_REASSEMBLY_SESSION; i++)
+    {
+        if (session_table[i].next_size == 0)
+        {
+            return &session_table[i];
+        }
+        if ((now - session_table[i].date) > REASSEMBLY_TIMEOUT_MS)
+        {
+            if ((oldest == NULL) || ((now - session_table[i].date) > (now - oldest->date)))
+            {
+                oldest = &session_table[i];
+            }
+        }
+    }
+    if (oldest != NULL)
+    {
+        Reassembly_Abort(oldest);
+    }
+    return oldest;
+}
@@ -17,25 +17,127 @@
  * Definitions
  ******************************************************************************/
 #define ALIAS_SIZE 15
+
+#define RTB_SHARE_TIMEOUT 15 // Time to wait for a node routing table status in ms
+#define RTB_SHARE_TRY_NB  5  // Number of repair rounds allowed per node
+#define RTB_MIN_CAPACITY  8  // Minimal number of entries of an allocated storage
+
+/* Routing tables are exchanged into frames of variable length entries.
+ * A frame can be decoded on its own, it start with this header followed by encoded entries.
+ * Each encoded entry start with a tag byte giving the entry mode and the fields following it :
+ *  - SERVICE : [tag][id if not RTB_TAG_ID_NEXT][type if not RTB_TAG_TYPE_SAME][alias]
+ *  - NODE    : [tag][node_id if not RTB_TAG_NODE_NEXT][certified if RTB_TAG_CERTIFIED][node_info][ports]
+ * An alias is a byte giving the number of characters shared with the previous alias (4 MSB) and the
+ * number of characters following it (4 LSB).
+ * IDs, types and aliases are coded relatively to the previous entry of the same frame.
+ * Default aliases are given by the application and can't be deduced from the type, so aliases are
+ * always sent. Services of the same type usually share most of their alias and only cost a few bytes.
+ */
+#define RTB_WIRE_VERSION 1
+
+typedef struct __attribute__((__packed__))
+{
+    uint8_t version;      // Encoding version of the frame
+    uint16_t first_entry; // Index of the first entry of this frame
+    uint16_t entry_nb;    // Total number of entries of the transmitted table
+} rtb_frame_header_t;
+
+#define RTB_TAG_MODE_MASK  0x03     // entry_mode_t of the entry
+#define RTB_TAG_ID_NEXT    (1 << 2) // SERVICE : id is the previous one + 1
+#define RTB_TAG_TYPE_SAME  (1 << 3) // SERVICE : type is the previous one
+#define RTB_TAG_TYPE_WIDE  (1 << 4) // SERVICE : type is coded on 2 bytes instead of 1
+#define RTB_TAG_ACCESS_POS 5        // SERVICE : access_t on 2 bits
+#define RTB_TAG_NODE_NEXT  (1 << 2) // NODE : node_id is the previous one + 1
+#define RTB_TAG_PORT_POS   3        // NODE : number of ports on 4 bits
+#define RTB_TAG_CERTIFIED  (1 << 7) // NODE : certified value is following
+
+#define RTB_PORT_MAX_NB    ((sizeof(routing_table_t) - 4) / sizeof(uint16_t))
+#define RTB_ENTRY_MAX_SIZE (sizeof(routing_table_t) + 2)
+
+// Delta coding context of a frame
+typedef struct
+{
+    uint16_t node_id;
+    uint16_t id;
+    uint16_t type;
+    char alias[MAX_ALIAS_SIZE];
+} rtb_codec_ctx_t;
+
+// Range of routing table entries missing on a node
+typedef struct __attribute__((__packed__))
+{
+    uint16_t first_entry;
+    uint16_t entry_nb;
+} rtb_range_t;
+
+#define RTB_NACK_MAX_NB (MAX_DATA_MSG_SIZE / sizeof(rtb_range_t))
+
+#define RTB_NO_INDEX     0xFFFF
+#define RTB_MAX_CAPACITY 0xFFFE
 /*******************************************************************************
  * Variables
  ******************************************************************************/
-routing_table_t routing_table[MAX_RTB_ENTRY];
+// Default storage, used until the application provide its own
+static routing_table_t default_routing_table[MAX_RTB_ENTRY];
+static uint16_t default_rtb_index[RTB_INDEX_SIZE(MAX_RTB_ENTRY)] = {[0 ... RTB_INDEX_SIZE(MAX_RTB_ENTRY) - 1] = RTB_NO_INDEX};
+
+routing_table_t *routing_table             = default_routing_table;
 volatile uint16_t last_service             = 0;
 volatile uint16_t last_routing_table_entry = 0;
+
+// Routing table storage context
+static uint16_t rtb_capacity          = MAX_RTB_ENTRY; // Number of entries available in the storage
+static void *rtb_storage              = NULL;          // Application storage, NULL for the default one
+static RTB_STORAGE_CB rtb_storage_cb  = NULL;          // Storage reallocation callback
+static uint16_t rtb_alias_hash_size   = 2 * MAX_RTB_ENTRY + 1;
+
+// Incremented each time the routing table content change, 0 is never used to let a cleared result be out of date
+static volatile uint32_t rtb_generation = 1;
+
+// Secondary indexes rebuilt each time the routing table is computed
+static uint16_t *rtb_id_index   = &default_rtb_index[0];                       // service id -> entry index
+static uint16_t *rtb_id_node    = &default_rtb_index[MAX_RTB_ENTRY + 1];       // service id -> node id
+static uint16_t *rtb_node_index = &default_rtb_index[2 * (MAX_RTB_ENTRY + 1)]; // node id -> node entry index
+static uint16_t *rtb_alias_hash = &default_rtb_index[3 * (MAX_RTB_ENTRY + 1)]; // alias hash -> entry index
+
+// Reception state of a shared routing table (node side)
+static uint16_t rtb_entry_received_nb = 0;
+// Reception state of a local routing table (detector side)
+static uint16_t rtb_local_next_entry = 0;     // Index of the next local entry expected
+static bool rtb_local_lost           = false; // Some local entries have been missed
+// Missing entries reported by the last polled node (detector side)
+static volatile bool rtb_nack_received = false;
+static uint16_t rtb_nack_node          = 0; // Node polled, 0 if there is no poll in progress
+static uint16_t rtb_nack_nb            = 0;
+static rtb_range_t rtb_nack_list[RTB_NACK_MAX_NB];
 /*******************************************************************************
  * Function
  ******************************************************************************/
 static void RoutingTB_AddNumToAlias(char *alias, uint8_t num);
+static void RoutingTB_SetLayout(void *storage, uint16_t capacity);
+static void RoutingTB_BuildIndex(void);
+static void RoutingTB_DropPartialEntries(void);
+static void RoutingTB_NewGeneration(void);
+static uint16_t RoutingTB_AliasHash(const char *alias);
+static uint16_t RoutingTB_FindAlias(const char *alias);
+static void RoutingTB_IndexAlias(uint16_t entry);
 uint16_t RoutingTB_IDFromAlias(char *alias);
 char *RoutingTB_AliasFromId(uint16_t id);
-static uint16_t RoutingTB_BigestNodeID(void);
 uint16_t RoutingTB_GetServiceIndex(uint16_t id);
 bool RoutingTB_WaitRoutingTable(service_t *service, msg_t *intro_msg);
 
 static void RoutingTB_Generate(service_t *service, uint16_t nb_node);
 static void RoutingTB_Share(service_t *service, uint16_t nb_node);
+static uint8_t RoutingTB_EncodeEntry(uint8_t *data, const routing_table_t *entry, rtb_codec_ctx_t *ctx);
+static uint8_t RoutingTB_DecodeEntry(routing_table_t *entry, const uint8_t *data, uint16_t size, rtb_codec_ctx_t *ctx);
+static int32_t RoutingTB_DecodeFrame(msg_t *msg, uint16_t base, rtb_frame_header_t *frame, uint16_t *new_entry_nb);
+static void RoutingTB_SendFrames(service_t *service, msg_t *msg, const routing_table_t *table, uint16_t first_entry, uint16_t end_entry, uint16_t entry_nb);
+static bool RoutingTB_WaitChunkStatus(service_t *service, msg_t *status_msg);
+static bool RoutingTB_NodeNeedRTB(uint16_t node_id);
 static void RoutingTB_SendEndDetection(service_t *service);
+static inline uint16_t *RTFilter_GetTable(search_result_t *result);
+static inline uint16_t RTFilter_GetCapacity(search_result_t *result);
+static void RTFilter_Fill(search_result_t *result);
 
 // ************************ routing_table search tools ***************************
 
@@ -48,15 +150,10 @@ uint16_t RoutingTB_IDFromAlias(char *alias)
 {
     if (*alias != -1)
     {
-        for (int i = 0; i <= last_routing_table_entry; i++)
+        uint16_t entry = RoutingTB_FindAlias(alias);
+        if (entry != RTB_NO_INDEX)
         {
-            if (routing_table[i].mode == SERVICE)
-            {
-                if (strcmp(routing_table[i].alias, alias) == 0)
-                {
-                    return routing_table[i].id;
-                }
-            }
+            return routing_table[entry].id;
         }
     }
     return 0;
@@ -68,6 +165,15 @@ uint16_t RoutingTB_IDFromAlias(char *alias)
  ******************************************************************************/
 uint16_t RoutingTB_NodeIDFromID(uint16_t id)
 {
+    if (id <= rtb_capacity)
+    {
+        if (rtb_id_index[id] != RTB_NO_INDEX)
+        {
+            return rtb_id_node[id];
+        }
+        return 0;
+    }
+    // This id is out of the index range, look for it.
     for (int32_t i = (int32_t)RoutingTB_GetServiceIndex(id); i >= 0; i--)
     {
         if (routing_table[i].mode == NODE)
@@ -84,6 +190,15 @@ uint16_t RoutingTB_NodeIDFromID(uint16_t id)
  ******************************************************************************/
 char *RoutingTB_AliasFromId(uint16_t id)
 {
+    if (id <= rtb_capacity)
+    {
+        if (rtb_id_index[id] != RTB_NO_INDEX)
+        {
+            return routing_table[rtb_id_index[id]].alias;
+        }
+        return (char *)0;
+    }
+    // This id is out of the index range, look for it.
     for (int i = 0; i <= last_routing_table_entry; i++)
     {
         if (routing_table[i].mode == SERVICE)
@@ -121,7 +236,7 @@ uint16_t RoutingTB_BigestID(void)
  * @param None
  * @return Bigest node ID
  ******************************************************************************/
-static uint16_t RoutingTB_BigestNodeID(void)
+uint16_t RoutingTB_BigestNodeID(void)
 {
     uint16_t max_id = 0;
     for (uint16_t i = 0; i < last_routing_table_entry; i++)
@@ -144,7 +259,16 @@ static uint16_t RoutingTB_BigestNodeID(void)
  ******************************************************************************/
 uint16_t RoutingTB_GetServiceIndex(uint16_t id)
 {
-    for (uint8_t i = 0; i < last_routing_table_entry; i++)
+    if (id <= rtb_capacity)
+    {
+        if (rtb_id_index[id] != RTB_NO_INDEX)
+        {
+            return rtb_id_index[id];
+        }
+        return 0;
+    }
+    // This id is out of the index range, look for it.
+    for (uint16_t i = 0; i < last_routing_table_entry; i++)
     {
         if (routing_table[i].mode == SERVICE && routing_table[i].id == id)
         {
@@ -153,6 +277,116 @@ uint16_t RoutingTB_GetServiceIndex(uint16_t id)
     }
     return 0;
 }
+/******************************************************************************
+ * @brief  Compute the hash of an alias
+ * @param alias : Pointer to alias
+ * @return Hash table slot
+ ******************************************************************************/
+static uint16_t RoutingTB_AliasHash(const char *alias)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (uint8_t i = 0; (i < MAX_ALIAS_SIZE) && (alias[i] != '\0'); i++)
+    {
+        hash ^= (uint8_t)alias[i];
+        hash *= 16777619u;
+    }
+    return (uint16_t)(hash % rtb_alias_hash_size);
+}
+/******************************************************************************
+ * @brief  Find the first entry using an alias
+ * @param alias : Pointer to alias
+ * @return Entry index, or RTB_NO_INDEX if not found
+ ******************************************************************************/
+static uint16_t RoutingTB_FindAlias(const char *alias)
+{
+    uint16_t slot = RoutingTB_AliasHash(alias);
+    while (rtb_alias_hash[slot] != RTB_NO_INDEX)
+    {
+        if (strncmp(routing_table[rtb_alias_hash[slot]].alias, alias, MAX_ALIAS_SIZE) == 0)
+        {
+            return rtb_alias_hash[slot];
+        }
+        slot = (slot + 1) % rtb_alias_hash_size;
+    }
+    return RTB_NO_INDEX;
+}
+/******************************************************************************
+ * @brief  Add an entry alias to the alias hash table if it is not already used
+ * @param entry : Entry index
+ * @return None
+ ******************************************************************************/
+static void RoutingTB_IndexAlias(uint16_t entry)
+{
+    uint16_t slot = RoutingTB_AliasHash(routing_table[entry].alias);
+    while (rtb_alias_hash[slot] != RTB_NO_INDEX)
+    {
+        if (strncmp(routing_table[rtb_alias_hash[slot]].alias, routing_table[entry].alias, MAX_ALIAS_SIZE) == 0)
+        {
+            // This alias is already indexed, keep the first one
+            return;
+        }
+        slot = (slot + 1) % rtb_alias_hash_size;
+    }
+    rtb_alias_hash[slot] = entry;
+}
+/******************************************************************************
+ * @brief  Build secondary indexes of the routing table
+ * @param None
+ * @return None
+ ******************************************************************************/
+static void RoutingTB_BuildIndex(void)
+{
+    uint16_t node_id = 0;
+    // All the indexes are contiguous, clear them at once
+    memset(rtb_id_index, 0xFF, RTB_INDEX_SIZE(rtb_capacity) * sizeof(uint16_t));
+    for (uint16_t i = 0; i < last_routing_table_entry; i++)
+    {
+        if (routing_table[i].mode == NODE)
+        {
+            node_id = routing_table[i].node_id;
+            if (node_id <= rtb_capacity)
+            {
+                rtb_node_index[node_id] = i;
+            }
+        }
+        else if (routing_table[i].mode == SERVICE)
+        {
+            if (routing_table[i].id <= rtb_capacity)
+            {
+                rtb_id_index[routing_table[i].id] = i;
+                rtb_id_node[routing_table[i].id]  = node_id;
+            }
+            RoutingTB_IndexAlias(i);
+        }
+    }
+}
+/******************************************************************************
+ * @brief  Remove the entries of an incomplete local routing table
+ * Entries received after last_routing_table_entry stay in storage until the
+ * table is complete, clear them so they can't be taken for valid ones.
+ * @param None
+ * @return None
+ ******************************************************************************/
+static void RoutingTB_DropPartialEntries(void)
+{
+    memset(&routing_table[last_routing_table_entry], 0, (rtb_capacity - last_routing_table_entry) * sizeof(routing_table_t));
+    RoutingTB_BuildIndex();
+}
+
+/******************************************************************************
+ * @brief  Invalidate all the results computed with the current routing table
+ * @param None
+ * @return None
+ ******************************************************************************/
+static void RoutingTB_NewGeneration(void)
+{
+    rtb_generation++;
+    if (rtb_generation == 0)
+    {
+        rtb_generation = 1;
+    }
+}
 
 // ********************* routing_table management tools ************************
 
@@ -163,7 +397,7 @@ uint16_t RoutingTB_GetServiceIndex(uint16_t id)
  ******************************************************************************/
 void RoutingTB_ComputeRoutingTableEntryNB(void)
 {
-    for (uint16_t i = 0; i < MAX_RTB_ENTRY; i++)
+    for (uint16_t i = 0; i < rtb_capacity; i++)
     {
         if (routing_table[i].mode == SERVICE)
         {
@@ -172,11 +406,15 @@ void RoutingTB_ComputeRoutingTableEntryNB(void)
         if (routing_table[i].mode == CLEAR)
         {
             last_routing_table_entry = i;
+            RoutingTB_BuildIndex();
+            RoutingTB_NewGeneration();
             return;
         }
     }
     // Routing table space is full.
-    last_routing_table_entry = MAX_RTB_ENTRY - 1;
+    last_routing_table_entry = rtb_capacity - 1;
+    RoutingTB_BuildIndex();
+    RoutingTB_NewGeneration();
 }
 /******************************************************************************
  * @brief Manage service name increment to never have same alias
@@ -216,23 +454,37 @@ static void RoutingTB_AddNumToAlias(char *alias, uint8_t num)
  * @brief Time out to receive en route table from
  * @param service : Service receive
  * @param intro_msg : into route table message
- * @return None
+ * @return true if the local routing table have been received, incomplete ones are dropped
  ******************************************************************************/
 bool RoutingTB_WaitRoutingTable(service_t *service, msg_t *intro_msg)
 {
     const uint8_t timeout    = 15; // timeout in ms
     const uint16_t entry_bkp = last_routing_table_entry;
-    Luos_SendMsg(service, intro_msg);
-    uint32_t timestamp = LuosHAL_GetSystick();
-    while ((LuosHAL_GetSystick() - timestamp) < timeout)
+    for (uint8_t try_nb = 0; try_nb < RTB_SHARE_TRY_NB; try_nb++)
     {
-        // If this request is for a service in this board allow him to respond.
-        Luos_Loop();
-        if (entry_bkp != last_routing_table_entry)
+        // Don't keep any entry of a previous try, the table received may be shorter
+        RoutingTB_DropPartialEntries();
+        rtb_local_next_entry = 0;
+        rtb_local_lost       = false;
+        Luos_SendMsg(service, intro_msg);
+        uint32_t timestamp = LuosHAL_GetSystick();
+        while ((LuosHAL_GetSystick() - timestamp) < timeout)
+        {
+            // If this request is for a service in this board allow him to respond.
+            Luos_Loop();
+            if (entry_bkp != last_routing_table_entry)
+            {
+                return true;
+            }
+        }
+        if ((rtb_local_next_entry == 0) && (rtb_local_lost == false))
         {
-            return true;
+            // The node didn't answer at all
+            break;
         }
+        // The node table is incomplete, ask it again
     }
+    RoutingTB_DropPartialEntries();
     return false;
 }
 /******************************************************************************
@@ -269,32 +521,400 @@ static void RoutingTB_Generate(service_t *service, uint16_t nb_node)
         last_node_id = RoutingTB_BigestNodeID();
     }
     // Check Alias duplication.
-    uint16_t nb_service = RoutingTB_BigestID();
-    for (uint16_t id = 1; id <= nb_service; id++)
-    {
-        int32_t found_id = RoutingTB_IDFromAlias(RoutingTB_AliasFromId(id));
-        if ((found_id != id) & (found_id != -1))
-        {
-            // The found_id don't match with the actual ID of the service because the alias already exist
-            // Find the new alias to give him
-            uint8_t annotation              = 1;
-            char base_alias[MAX_ALIAS_SIZE] = {0};
-            memcpy(base_alias, RoutingTB_AliasFromId(id), MAX_ALIAS_SIZE);
-            // Add a number after alias in routing table
-            RoutingTB_AddNumToAlias(RoutingTB_AliasFromId(id), annotation++);
-            // check another time if this alias is already used
-            while (RoutingTB_IDFromAlias(RoutingTB_AliasFromId(id)) != id)
-            {
-                // This alias is already used.
-                // Remove the number previously setuped by overwriting it with the base_alias
-                memcpy(RoutingTB_AliasFromId(id), base_alias, MAX_ALIAS_SIZE);
-                RoutingTB_AddNumToAlias(RoutingTB_AliasFromId(id), annotation++);
-            }
+    // The alias index only reference the first entry using an alias, any other entry using it is a duplicate.
+    RoutingTB_BuildIndex();
+    for (uint16_t i = 0; i < last_routing_table_entry; i++)
+    {
+        if ((routing_table[i].mode != SERVICE) || (RoutingTB_FindAlias(routing_table[i].alias) == i))
+        {
+            continue;
+        }
+        // The alias already exist
+        // Find the new alias to give him
+        uint8_t annotation              = 1;
+        char base_alias[MAX_ALIAS_SIZE] = {0};
+        memcpy(base_alias, routing_table[i].alias, MAX_ALIAS_SIZE);
+        // Add a number after alias in routing table
+        RoutingTB_AddNumToAlias(routing_table[i].alias, annotation++);
+        // check another time if this alias is already used
+        while (RoutingTB_FindAlias(routing_table[i].alias) != RTB_NO_INDEX)
+        {
+            // This alias is already used.
+            // Remove the number previously setuped by overwriting it with the base_alias
+            memcpy(routing_table[i].alias, base_alias, MAX_ALIAS_SIZE);
+            RoutingTB_AddNumToAlias(routing_table[i].alias, annotation++);
+        }
+        RoutingTB_IndexAlias(i);
+    }
+    // Aliases may have changed
+    RoutingTB_NewGeneration();
+}
+/******************************************************************************
+ * @brief Encode a routing table entry
+ * @param data : Buffer to fill, at least RTB_ENTRY_MAX_SIZE long
+ * @param entry : Entry to encode
+ * @param ctx : Delta coding context of the frame
+ * @return Encoded size
+ ******************************************************************************/
+static uint8_t RoutingTB_EncodeEntry(uint8_t *data, const routing_table_t *entry, rtb_codec_ctx_t *ctx)
+{
+    uint8_t size = 1;
+
+    data[0] = entry->mode & RTB_TAG_MODE_MASK;
+    if (entry->mode == SERVICE)
+    {
+        if (entry->id == (uint16_t)(ctx->id + 1))
+        {
+            data[0] |= RTB_TAG_ID_NEXT;
+        }
+        else
+        {
+            memcpy(&data[size], &entry->unmap_data[0], sizeof(uint16_t));
+            size += sizeof(uint16_t);
+        }
+        if (entry->type == ctx->type)
+        {
+            data[0] |= RTB_TAG_TYPE_SAME;
+        }
+        else if (entry->type > 0xFF)
+        {
+            data[0] |= RTB_TAG_TYPE_WIDE;
+            memcpy(&data[size], &entry->unmap_data[2], sizeof(uint16_t));
+            size += sizeof(uint16_t);
+        }
+        else
+        {
+            data[size++] = (uint8_t)entry->type;
         }
+        data[0] |= (entry->access & 0x03) << RTB_TAG_ACCESS_POS;
+        // Only send the part of the alias which differ from the previous one
+        uint8_t alias_size = strnlen(entry->alias, ALIAS_SIZE);
+        uint8_t shared     = 0;
+        while ((shared < alias_size) && (entry->alias[shared] == ctx->alias[shared]))
+        {
+            shared++;
+        }
+        data[size++] = (shared << 4) | (alias_size - shared);
+        memcpy(&data[size], &entry->alias[shared], alias_size - shared);
+        size += alias_size - shared;
+        ctx->id   = entry->id;
+        ctx->type = entry->type;
+        memset(ctx->alias, 0, MAX_ALIAS_SIZE);
+        memcpy(ctx->alias, entry->alias, alias_size);
+    }
+    else if (entry->mode == NODE)
+    {
+        // Unconnected ports at the end of the port table are not sent
+        uint8_t port_nb = RTB_PORT_MAX_NB;
+        while ((port_nb > 0) && (entry->port_table[port_nb - 1] == 0))
+        {
+            port_nb--;
+        }
+        data[0] |= port_nb << RTB_TAG_PORT_POS;
+        if (entry->node_id == (uint16_t)(ctx->node_id + 1))
+        {
+            data[0] |= RTB_TAG_NODE_NEXT;
+        }
+        else
+        {
+            uint16_t node_id = entry->node_id;
+            memcpy(&data[size], &node_id, sizeof(uint16_t));
+            size += sizeof(uint16_t);
+        }
+        if (entry->certified)
+        {
+            data[0] |= RTB_TAG_CERTIFIED;
+            data[size++] = entry->certified;
+        }
+        data[size++] = entry->node_info;
+        memcpy(&data[size], &entry->unmap_data[3], port_nb * sizeof(uint16_t));
+        size += port_nb * sizeof(uint16_t);
+        ctx->node_id = entry->node_id;
+    }
+    return size;
+}
+/******************************************************************************
+ * @brief Decode a routing table entry
+ * @param entry : Entry to fill
+ * @param data : Encoded entry
+ * @param size : Available data size
+ * @param ctx : Delta coding context of the frame
+ * @return Decoded size, 0 if the data is not a valid entry
+ ******************************************************************************/
+static uint8_t RoutingTB_DecodeEntry(routing_table_t *entry, const uint8_t *data, uint16_t size, rtb_codec_ctx_t *ctx)
+{
+    uint8_t tag      = data[0];
+    uint16_t decoded = 1;
+
+    memset(entry, 0, sizeof(routing_table_t));
+    entry->mode = tag & RTB_TAG_MODE_MASK;
+    if (entry->mode == SERVICE)
+    {
+        uint16_t needed = 1; // Alias description byte
+        needed += (tag & RTB_TAG_ID_NEXT) ? 0 : sizeof(uint16_t);
+        needed += (tag & RTB_TAG_TYPE_SAME) ? 0 : ((tag & RTB_TAG_TYPE_WIDE) ? sizeof(uint16_t) : 1);
+        if ((decoded + needed) > size)
+        {
+            return 0;
+        }
+        if (tag & RTB_TAG_ID_NEXT)
+        {
+            entry->id = ctx->id + 1;
+        }
+        else
+        {
+            memcpy(&entry->unmap_data[0], &data[decoded], sizeof(uint16_t));
+            decoded += sizeof(uint16_t);
+        }
+        if (tag & RTB_TAG_TYPE_SAME)
+        {
+            entry->type = ctx->type;
+        }
+        else if (tag & RTB_TAG_TYPE_WIDE)
+        {
+            memcpy(&entry->unmap_data[2], &data[decoded], sizeof(uint16_t));
+            decoded += sizeof(uint16_t);
+        }
+        else
+        {
+            entry->type = data[decoded++];
+        }
+        entry->access  = (tag >> RTB_TAG_ACCESS_POS) & 0x03;
+        uint8_t shared = data[decoded] >> 4;
+        uint8_t suffix = data[decoded++] & 0x0F;
+        if (((shared + suffix) > ALIAS_SIZE) || ((decoded + suffix) > size))
+        {
+            return 0;
+        }
+        memcpy(entry->alias, ctx->alias, shared);
+        memcpy(&entry->alias[shared], &data[decoded], suffix);
+        decoded += suffix;
+        ctx->id   = entry->id;
+        ctx->type = entry->type;
+        memcpy(ctx->alias, entry->alias, MAX_ALIAS_SIZE);
+    }
+    else if (entry->mode == NODE)
+    {
+        uint8_t port_nb = (tag >> RTB_TAG_PORT_POS) & 0x0F;
+        uint16_t needed = 1 + port_nb * sizeof(uint16_t);
+        needed += (tag & RTB_TAG_NODE_NEXT) ? 0 : sizeof(uint16_t);
+        needed += (tag & RTB_TAG_CERTIFIED) ? 1 : 0;
+        if ((port_nb > RTB_PORT_MAX_NB) || ((decoded + needed) > size))
+        {
+            return 0;
+        }
+        uint16_t node_id = ctx->node_id + 1;
+        if (!(tag & RTB_TAG_NODE_NEXT))
+        {
+            memcpy(&node_id, &data[decoded], sizeof(uint16_t));
+            decoded += sizeof(uint16_t);
+        }
+        entry->node_id = node_id;
+        if (tag & RTB_TAG_CERTIFIED)
+        {
+            entry->certified = data[decoded++];
+        }
+        entry->node_info = data[decoded++];
+        memcpy(&entry->unmap_data[3], &data[decoded], port_nb * sizeof(uint16_t));
+        decoded += port_nb * sizeof(uint16_t);
+        ctx->node_id = node_id;
+    }
+    return decoded;
+}
+/******************************************************************************
+ * @brief Encode as many routing table entries as possible into a message
+ * @param msg : Message to fill, only data and size are set
+ * @param table : Table to encode
+ * @param first_entry : Index of the first entry to encode
+ * @param end_entry : Index of the entry to stop at
+ * @param entry_nb : Total number of entries of the table
+ * @return Number of entries encoded
+ ******************************************************************************/
+uint16_t RoutingTB_EncodeFrame(msg_t *msg, const routing_table_t *table, uint16_t first_entry, uint16_t end_entry, uint16_t entry_nb)
+{
+    rtb_frame_header_t frame = {.version = RTB_WIRE_VERSION, .first_entry = first_entry, .entry_nb = entry_nb};
+    uint8_t encoded[RTB_ENTRY_MAX_SIZE];
+    uint16_t size  = sizeof(rtb_frame_header_t);
+    uint16_t index = first_entry;
+    rtb_codec_ctx_t ctx;
+
+    memset(&ctx, 0, sizeof(rtb_codec_ctx_t));
+    memcpy(msg->data, &frame, sizeof(rtb_frame_header_t));
+    while (index < end_entry)
+    {
+        uint8_t encoded_size = RoutingTB_EncodeEntry(encoded, &table[index], &ctx);
+        if ((size + encoded_size) > MAX_DATA_MSG_SIZE)
+        {
+            // This frame is full
+            break;
+        }
+        memcpy(&msg->data[size], encoded, encoded_size);
+        size += encoded_size;
+        index++;
+    }
+    msg->header.size = size;
+    return index - first_entry;
+}
+/******************************************************************************
+ * @brief Decode a routing table frame into the routing table
+ * @param msg : Message containing the frame
+ * @param base : Routing table index corresponding to the first entry of the transmitted table
+ * @param frame : Frame header to fill
+ * @param new_entry_nb : Number of entries which were not in the routing table yet
+ * @return Number of entries decoded, -1 if the frame is not valid
+ ******************************************************************************/
+static int32_t RoutingTB_DecodeFrame(msg_t *msg, uint16_t base, rtb_frame_header_t *frame, uint16_t *new_entry_nb)
+{
+    uint16_t size     = sizeof(rtb_frame_header_t);
+    uint16_t entry_nb = 0;
+    routing_table_t entry;
+    rtb_codec_ctx_t ctx;
+
+    *new_entry_nb = 0;
+    if ((msg->header.size < sizeof(rtb_frame_header_t)) || (msg->header.size > MAX_DATA_MSG_SIZE) || (msg->data[0] != RTB_WIRE_VERSION))
+    {
+        // We don't know how to decode this frame
+        return -1;
+    }
+    memcpy(frame, msg->data, sizeof(rtb_frame_header_t));
+    memset(&ctx, 0, sizeof(rtb_codec_ctx_t));
+    while (size < msg->header.size)
+    {
+        uint8_t encoded_size = RoutingTB_DecodeEntry(&entry, &msg->data[size], msg->header.size - size, &ctx);
+        uint32_t index       = (uint32_t)base + frame->first_entry + entry_nb;
+        if (encoded_size == 0)
+        {
+            return -1;
+        }
+        // Check routing table overflow
+        if (RoutingTB_Reserve(index + 1) != SUCCEED)
+        {
+            LUOS_ASSERT(0);
+            return -1;
+        }
+        if (routing_table[index].mode == CLEAR)
+        {
+            (*new_entry_nb)++;
+        }
+        memcpy(&routing_table[index], &entry, sizeof(routing_table_t));
+        size += encoded_size;
+        entry_nb++;
+    }
+    return entry_nb;
+}
+/******************************************************************************
+ * @brief Send a part of a routing table into frames
+ * @param service : Service who send
+ * @param msg : Message to use, cmd, target and target_mode have to be set
+ * @param table : Table to send
+ * @param first_entry : Index of the first entry to send
+ * @param end_entry : Index of the entry to stop at
+ * @param entry_nb : Total number of entries of the table
+ * @return None
+ ******************************************************************************/
+static void RoutingTB_SendFrames(service_t *service, msg_t *msg, const routing_table_t *table, uint16_t first_entry, uint16_t end_entry, uint16_t entry_nb)
+{
+    while (first_entry < end_entry)
+    {
+        first_entry += RoutingTB_EncodeFrame(msg, table, first_entry, end_entry, entry_nb);
+        uint32_t tickstart = Luos_GetSystick();
+        while (Luos_SendMsg(service, msg) == FAILED)
+        {
+            // No more memory space available
+            // 500ms of timeout after start trying to load our data in memory. Perhaps the buffer is full of RX messages try to increate the buffer size.
+            LUOS_ASSERT(((volatile uint32_t)Luos_GetSystick() - tickstart) < 500);
+        }
+    }
+}
+/******************************************************************************
+ * @brief Send a complete routing table
+ * @param service : Service who send
+ * @param msg : Message to use, cmd, target and target_mode have to be set
+ * @param table : Table to send
+ * @param entry_nb : Number of entries of the table
+ * @return None
+ ******************************************************************************/
+void RoutingTB_SendEntries(service_t *service, msg_t *msg, const routing_table_t *table, uint16_t entry_nb)
+{
+    RoutingTB_SendFrames(service, msg, table, 0, entry_nb, entry_nb);
+}
+/******************************************************************************
+ * @brief Append a received local routing table frame to the routing table
+ * @param msg : RTB message
+ * @return None
+ ******************************************************************************/
+void RoutingTB_ReceiveEntries(msg_t *msg)
+{
+    rtb_frame_header_t frame;
+    uint16_t new_entry_nb;
+    // Frames are received in order and last_routing_table_entry only move when the local table is complete.
+    int32_t entry_nb = RoutingTB_DecodeFrame(msg, last_routing_table_entry, &frame, &new_entry_nb);
+    if (entry_nb <= 0)
+    {
+        return;
+    }
+    if (frame.first_entry == 0)
+    {
+        // A new local routing table start
+        rtb_local_lost = false;
     }
+    else if (frame.first_entry != rtb_local_next_entry)
+    {
+        // A frame have been missed
+        rtb_local_lost = true;
+    }
+    rtb_local_next_entry = frame.first_entry + entry_nb;
+    if (rtb_local_next_entry >= frame.entry_nb)
+    {
+        rtb_local_next_entry = 0;
+        if (rtb_local_lost == false)
+        {
+            // route table section reception complete
+            RoutingTB_ComputeRoutingTableEntryNB();
+            Luos_ResetStatistic();
+        }
+    }
+}
+/******************************************************************************
+ * @brief Ask a node about the routing table entries it missed and wait for its answer
+ * @param service : Service who send
+ * @param status_msg : routing table status request message
+ * @return true if the node answered
+ ******************************************************************************/
+static bool RoutingTB_WaitChunkStatus(service_t *service, msg_t *status_msg)
+{
+    rtb_nack_received = false;
+    rtb_nack_node     = status_msg->header.target;
+    Luos_SendMsg(service, status_msg);
+    uint32_t timestamp = LuosHAL_GetSystick();
+    while ((LuosHAL_GetSystick() - timestamp) < RTB_SHARE_TIMEOUT)
+    {
+        // If this request is for a service in this board allow him to respond.
+        Luos_Loop();
+        if (rtb_nack_received)
+        {
+            break;
+        }
+    }
+    // Don't take any late answer for the one of the next poll
+    rtb_nack_node = 0;
+    return rtb_nack_received;
+}
+/******************************************************************************
+ * @brief Check if a node want to receive the routing table
+ * @param node_id : Node to check
+ * @return true if the node need the routing table
+ ******************************************************************************/
+static bool RoutingTB_NodeNeedRTB(uint16_t node_id)
+{
+    if ((node_id <= rtb_capacity) && (rtb_node_index[node_id] != RTB_NO_INDEX))
+    {
+        return ((routing_table[rtb_node_index[node_id]].node_info & (1 << 0)) == 0);
+    }
+    return true;
 }
 /******************************************************************************
- * @brief Send the complete route table to each node on the network
+ * @brief Broadcast the complete route table then make sure each node get it
  * @param service : Service who send
  * @param nb_node : number of nodes on network
  * @return None
@@ -306,29 +926,145 @@ static void RoutingTB_Share(service_t *service, uint16_t nb_node)
     {
         return;
     }
-    // send route table to each nodes. Routing tables are commonly usable for each services of a node.
-    msg_t intro_msg;
-    intro_msg.header.cmd         = RTB;
-    intro_msg.header.target_mode = NODEIDACK;
+    // Routing tables are commonly usable for each services of a node, broadcast it only once.
+    uint16_t entry_nb = last_routing_table_entry;
+    msg_t frame_msg;
+    frame_msg.header.cmd         = RTB_CHUNK;
+    frame_msg.header.target_mode = BROADCAST;
+    frame_msg.header.target      = BROADCAST_VAL;
+    RoutingTB_SendFrames(service, &frame_msg, routing_table, 0, entry_nb, entry_nb);
 
+    // Ask each node for the entries it missed and send them back until it confirms the reception.
+    msg_t status_msg;
+    status_msg.header.cmd         = RTB_STATUS;
+    status_msg.header.target_mode = NODEIDACK;
+    status_msg.header.size        = sizeof(uint16_t);
+    frame_msg.header.target_mode  = NODEIDACK;
     for (uint16_t i = 2; i <= nb_node; i++) // don't send to ourself
     {
-        intro_msg.header.target = i;
-
-        uint16_t node_idx;
-
-        for (node_idx = i; node_idx < last_routing_table_entry; node_idx++)
+        if (!RoutingTB_NodeNeedRTB(i))
         {
-            if ((routing_table[node_idx].mode == NODE) && (routing_table[node_idx].node_id == i))
+            continue;
+        }
+        status_msg.header.target = i;
+        frame_msg.header.target  = i;
+        bool missing = false; // The node reported missing entries at its last answer
+        // Poll the node once more than the repair rounds to check the last one
+        for (uint8_t try_nb = 0; try_nb <= RTB_SHARE_TRY_NB; try_nb++)
+        {
+            memcpy(status_msg.data, &entry_nb, sizeof(uint16_t));
+            if (!RoutingTB_WaitChunkStatus(service, &status_msg))
+            {
+                // No answer, ask again
+                continue;
+            }
+            missing = (rtb_nack_nb != 0);
+            if ((missing == false) || (try_nb == RTB_SHARE_TRY_NB))
             {
+                // This node have the complete routing table, or there is no repair round left
                 break;
             }
+            // Only send the missing pieces
+            for (uint16_t j = 0; j < rtb_nack_nb; j++)
+            {
+                uint32_t end_entry = (uint32_t)rtb_nack_list[j].first_entry + rtb_nack_list[j].entry_nb;
+                if (end_entry > entry_nb)
+                {
+                    end_entry = entry_nb;
+                }
+                RoutingTB_SendFrames(service, &frame_msg, routing_table, rtb_nack_list[j].first_entry, end_entry, entry_nb);
+            }
+        }
+        if (missing)
+        {
+            // Repairs didn't succeed, send the complete routing table to this node only
+            RoutingTB_SendFrames(service, &frame_msg, routing_table, 0, entry_nb, entry_nb);
+        }
+    }
+}
+/******************************************************************************
+ * @brief Save a received routing table frame
+ * @param msg : RTB_CHUNK message
+ * @return None
+ ******************************************************************************/
+void RoutingTB_ReceiveChunk(msg_t *msg)
+{
+    rtb_frame_header_t frame;
+    uint16_t new_entry_nb;
+
+    if ((Robus_IsNodeDetected() == LOCAL_DETECTION) || ((Robus_GetNode()->node_info & (1 << 0)) != 0))
+    {
+        // We are the detector and already have this table, or we don't want any routing table.
+        return;
+    }
+    if ((RoutingTB_DecodeFrame(msg, 0, &frame, &new_entry_nb) <= 0) || (new_entry_nb == 0))
+    {
+        // Invalid frame or we already have it
+        return;
+    }
+    rtb_entry_received_nb += new_entry_nb;
+    if (rtb_entry_received_nb == frame.entry_nb)
+    {
+        // route table reception complete
+        RoutingTB_ComputeRoutingTableEntryNB();
+        Luos_ResetStatistic();
+    }
+}
+/******************************************************************************
+ * @brief Reply to a routing table status request with the list of missing entries
+ * @param service : Service who reply
+ * @param msg : RTB_STATUS message containing the total number of entries
+ * @return None
+ ******************************************************************************/
+void RoutingTB_SendMissingChunks(service_t *service, msg_t *msg)
+{
+    uint16_t entry_nb = 0;
+    uint16_t missing  = 0;
+    uint16_t index    = 0;
+    rtb_range_t range;
+    msg_t nack_msg;
+
+    memcpy(&entry_nb, msg->data, sizeof(uint16_t));
+    nack_msg.header.cmd         = RTB_NACK;
+    nack_msg.header.target_mode = SERVICEIDACK;
+    nack_msg.header.target      = msg->header.source;
+    while ((index < entry_nb) && (missing < RTB_NACK_MAX_NB))
+    {
+        if ((index < rtb_capacity) && (routing_table[index].mode != CLEAR))
+        {
+            index++;
+            continue;
         }
-        if ((routing_table[node_idx].node_info & (1 << 0)) == 0)
+        // Find the end of this missing range
+        range.first_entry = index;
+        while ((index < entry_nb) && ((index >= rtb_capacity) || (routing_table[index].mode == CLEAR)))
         {
-            Luos_SendData(service, &intro_msg, routing_table, (last_routing_table_entry * sizeof(routing_table_t)));
+            index++;
         }
+        range.entry_nb = index - range.first_entry;
+        memcpy(&nack_msg.data[missing * sizeof(rtb_range_t)], &range, sizeof(rtb_range_t));
+        missing++;
+    }
+    // An empty list confirm the reception of the complete routing table
+    nack_msg.header.size = missing * sizeof(rtb_range_t);
+    Luos_SendMsg(service, &nack_msg);
+}
+/******************************************************************************
+ * @brief Save the list of missing entries reported by a node
+ * @param msg : RTB_NACK message
+ * @return None
+ ******************************************************************************/
+void RoutingTB_ReceiveMissingChunks(msg_t *msg)
+{
+    if ((rtb_nack_node == 0) || (RoutingTB_NodeIDFromID(msg->header.source) != rtb_nack_node))
+    {
+        // This is not the answer of the node we are polling
+        return;
     }
+    rtb_nack_nb = msg->header.size / sizeof(rtb_range_t);
+    LUOS_ASSERT(rtb_nack_nb <= RTB_NACK_MAX_NB);
+    memcpy(rtb_nack_list, msg->data, rtb_nack_nb * sizeof(rtb_range_t));
+    rtb_nack_received = true;
 }
 
 /******************************************************************************
@@ -367,7 +1103,7 @@ void RoutingTB_DetectServices(service_t *service)
     // Starts the topology detection.
     uint16_t nb_node = Robus_TopologyDetection(service->ll_service);
     // Clear data reception state
-    Luos_ReceiveData(NULL, NULL, NULL);
+    Luos_ReceiveData(NULL, NULL, NULL, 0);
     // clear the routing table.
     RoutingTB_Erase();
     // Generate the routing_table
@@ -401,9 +1137,10 @@ void RoutingTB_ConvertNodeToRoutingTable(routing_table_t *entry, node_t *node)
  ******************************************************************************/
 void RoutingTB_ConvertServiceToRoutingTable(routing_table_t *entry, service_t *service)
 {
-    entry->type = service->ll_service->type;
-    entry->id   = service->ll_service->id;
-    entry->mode = SERVICE;
+    entry->type   = service->ll_service->type;
+    entry->id     = service->ll_service->id;
+    entry->access = service->access;
+    entry->mode   = SERVICE;
     for (uint8_t i = 0; i < MAX_ALIAS_SIZE; i++)
     {
         entry->alias[i] = service->alias[i];
@@ -419,21 +1156,15 @@ void RoutingTB_RemoveNode(uint16_t nodeid)
     // instead of removing a node just remove all the service in it to make it unusable
     // We could add a param (CONTROL for example) to declare the node as STOP
     // find the node
-    for (uint16_t i = 0; i < last_routing_table_entry; i++)
+    if ((nodeid > rtb_capacity) || (rtb_node_index[nodeid] == RTB_NO_INDEX))
     {
-        if (routing_table[i].mode == NODE)
-        {
-            if (routing_table[i].node_id == nodeid)
-            {
-                i++;
-                // We find our node remove all services
-                while (routing_table[i].mode == SERVICE)
-                {
-                    RoutingTB_RemoveOnRoutingTable(routing_table[i].id);
-                }
-                return;
-            }
-        }
+        return;
+    }
+    uint16_t i = rtb_node_index[nodeid] + 1;
+    // We find our node remove all services
+    while (routing_table[i].mode == SERVICE)
+    {
+        RoutingTB_RemoveOnRoutingTable(routing_table[i].id);
     }
 }
 /******************************************************************************
@@ -449,13 +1180,155 @@ void RoutingTB_RemoveOnRoutingTable(uint16_t id)
         if ((routing_table[i].mode == SERVICE) && (routing_table[i].id == id))
         {
             LUOS_ASSERT(i < last_routing_table_entry);
-            memcpy(&routing_table[i], &routing_table[i + 1], sizeof(routing_table_t) * (last_routing_table_entry - (i + 1)));
+            memmove(&routing_table[i], &routing_table[i + 1], sizeof(routing_table_t) * (last_routing_table_entry - (i + 1)));
             last_routing_table_entry--;
             memset(&routing_table[last_routing_table_entry], 0, sizeof(routing_table_t));
+            RoutingTB_BuildIndex();
+            RoutingTB_NewGeneration();
             return;
         }
     }
 }
+/******************************************************************************
+ * @brief Point the routing table and its indexes into a storage
+ * @param storage : Storage of at least RTB_STORAGE_SIZE(capacity) bytes
+ * @param capacity : Number of entries of the storage
+ * @return None
+ ******************************************************************************/
+static void RoutingTB_SetLayout(void *storage, uint16_t capacity)
+{
+    // Indexes are placed after the entries, aligned on 16 bits.
+    uint16_t *index     = (uint16_t *)((uint8_t *)storage + (((capacity * sizeof(routing_table_t)) + 1) & ~1));
+    routing_table       = (routing_table_t *)storage;
+    rtb_capacity        = capacity;
+    rtb_alias_hash_size = 2 * capacity + 1;
+    rtb_id_index        = &index[0];
+    rtb_id_node         = &index[capacity + 1];
+    rtb_node_index      = &index[2 * (capacity + 1)];
+    rtb_alias_hash      = &index[3 * (capacity + 1)];
+}
+/******************************************************************************
+ * @brief Move the routing table into an application storage
+ * @param storage : Storage to use, NULL to allocate it with storage_cb or to go back to the default one
+ * @param size : Size of the storage in bytes (see RTB_STORAGE_SIZE)
+ * @param storage_cb : realloc compatible callback used to grow the storage, can be NULL
+ * @return SUCCEED if the current routing table fit into the new storage
+ ******************************************************************************/
+error_return_t RoutingTB_SetStorage(void *storage, uint32_t size, RTB_STORAGE_CB storage_cb)
+{
+    uint16_t entry_nb = last_routing_table_entry;
+    uint32_t capacity = 0;
+
+    if (storage == NULL)
+    {
+        if (storage_cb == NULL)
+        {
+            // Go back to the default storage
+            LUOS_ASSERT(entry_nb < MAX_RTB_ENTRY);
+            memmove(default_routing_table, routing_table, entry_nb * sizeof(routing_table_t));
+            storage  = default_routing_table;
+            capacity = MAX_RTB_ENTRY;
+        }
+        else
+        {
+            // Allocate a storage fitting the current routing table
+            capacity = (entry_nb < RTB_MIN_CAPACITY) ? RTB_MIN_CAPACITY : entry_nb + 1;
+            storage  = storage_cb(NULL, RTB_STORAGE_SIZE(capacity));
+            if (storage == NULL)
+            {
+                return FAILED;
+            }
+        }
+    }
+    else
+    {
+        // Find the number of entries fitting in this storage
+        capacity = 0;
+        if (size > RTB_STORAGE_SIZE(0))
+        {
+            capacity = (size - RTB_STORAGE_SIZE(0)) / (sizeof(routing_table_t) + (RTB_INDEX_SIZE(1) - RTB_INDEX_SIZE(0)) * sizeof(uint16_t));
+        }
+        while ((capacity > 0) && (RTB_STORAGE_SIZE(capacity) > size))
+        {
+            capacity--;
+        }
+        if (capacity > RTB_MAX_CAPACITY)
+        {
+            capacity = RTB_MAX_CAPACITY;
+        }
+        // Indexes need a 16 bits alignment
+        LUOS_ASSERT(((uintptr_t)storage & 1) == 0);
+    }
+    if (capacity <= entry_nb)
+    {
+        return FAILED;
+    }
+    if (storage != (void *)routing_table)
+    {
+        memmove(storage, routing_table, entry_nb * sizeof(routing_table_t));
+    }
+    memset((routing_table_t *)storage + entry_nb, 0, (capacity - entry_nb) * sizeof(routing_table_t));
+    if ((rtb_storage != NULL) && (rtb_storage_cb != NULL) && (rtb_storage != storage))
+    {
+        // Release the storage we allocated
+        rtb_storage_cb(rtb_storage, 0);
+    }
+    rtb_storage    = (storage == (void *)default_routing_table) ? NULL : storage;
+    rtb_storage_cb = storage_cb;
+    if (rtb_storage == NULL)
+    {
+        routing_table       = default_routing_table;
+        rtb_capacity        = MAX_RTB_ENTRY;
+        rtb_alias_hash_size = 2 * MAX_RTB_ENTRY + 1;
+        rtb_id_index        = &default_rtb_index[0];
+        rtb_id_node         = &default_rtb_index[MAX_RTB_ENTRY + 1];
+        rtb_node_index      = &default_rtb_index[2 * (MAX_RTB_ENTRY + 1)];
+        rtb_alias_hash      = &default_rtb_index[3 * (MAX_RTB_ENTRY + 1)];
+    }
+    else
+    {
+        RoutingTB_SetLayout(storage, capacity);
+    }
+    RoutingTB_BuildIndex();
+    return SUCCEED;
+}
+/******************************************************************************
+ * @brief Make sure the routing table can contain a number of entries
+ * @param entry_nb : Number of entries needed
+ * @return SUCCEED if the storage is big enough or have been grown
+ ******************************************************************************/
+error_return_t RoutingTB_Reserve(uint32_t entry_nb)
+{
+    // Always keep a clear entry at the end of the table
+    if (entry_nb < rtb_capacity)
+    {
+        return SUCCEED;
+    }
+    if ((rtb_storage == NULL) || (rtb_storage_cb == NULL) || (entry_nb >= RTB_MAX_CAPACITY))
+    {
+        return FAILED;
+    }
+    uint32_t capacity = 2 * (uint32_t)rtb_capacity;
+    if (capacity <= entry_nb)
+    {
+        capacity = entry_nb + 1;
+    }
+    if (capacity > RTB_MAX_CAPACITY)
+    {
+        capacity = RTB_MAX_CAPACITY;
+    }
+    void *storage = rtb_storage_cb(rtb_storage, RTB_STORAGE_SIZE(capacity));
+    if (storage == NULL)
+    {
+        return FAILED;
+    }
+    // Entries are at the begining of the storage and are kept by the reallocation, indexes are rebuilt.
+    memset((routing_table_t *)storage + rtb_capacity, 0, (capacity - rtb_capacity) * sizeof(routing_table_t));
+    rtb_storage = storage;
+    RoutingTB_SetLayout(storage, capacity);
+    RoutingTB_BuildIndex();
+    return SUCCEED;
+}
 /******************************************************************************
  * @brief Erase routing_table
  * @param None
@@ -463,9 +1336,14 @@ void RoutingTB_RemoveOnRoutingTable(uint16_t id)
  ******************************************************************************/
 void RoutingTB_Erase(void)
 {
-    memset(routing_table, 0, sizeof(routing_table));
+    memset(routing_table, 0, rtb_capacity * sizeof(routing_table_t));
+    rtb_entry_received_nb    = 0;
+    rtb_local_next_entry     = 0;
+    rtb_local_lost           = false;
     last_service             = 0;
     last_routing_table_entry = 0;
+    RoutingTB_BuildIndex();
+    RoutingTB_NewGeneration();
 }
 /******************************************************************************
  * @brief Get routing_table
@@ -494,6 +1372,15 @@ uint16_t RoutingTB_GetLastEntry(void)
 {
     return (uint16_t)last_routing_table_entry;
 }
+/******************************************************************************
+ * @brief return the current routing table generation
+ * @param None
+ * @return Generation, changed each time the routing table content change
+ ******************************************************************************/
+uint32_t RoutingTB_GetGeneration(void)
+{
+    return rtb_generation;
+}
 
 /******************************** Result Table ********************************/
 /******************************************************************************
@@ -504,98 +1391,219 @@ uint16_t RoutingTB_GetLastEntry(void)
 
 error_return_t RTFilter_InitCheck(search_result_t *result)
 {
-    // check if we fund the address of the result in routing table
-    if ((result->result_table[0] >= &routing_table[0]) && (result->result_table[0] <= &routing_table[last_routing_table_entry - 1]))
+    uint16_t *table = RTFilter_GetTable(result);
+    // A table given to RTFilter_ResetTable can't be read before the result have been computed with this routing table
+    if ((result->table != NULL) && ((result->generation == 0) || (result->generation > rtb_generation)))
+    {
+        return FAILED;
+    }
+    // check if the result index is in routing table and points to a service entry
+    if ((result->result_nbr <= RTFilter_GetCapacity(result)) && (table[0] < last_routing_table_entry)
+        && (routing_table[table[0]].mode == SERVICE))
     {
         return SUCCEED;
     }
     return FAILED;
 }
 /******************************************************************************
- * @brief Initialize the Result table pointers
+ * @brief Get the entry indexes table of a result
  * @param result : Pointer to result table
- * @return Last entry
+ * @return The table given to RTFilter_ResetTable, else result_table
  ******************************************************************************/
-search_result_t *RTFilter_Reset(search_result_t *result)
+static inline uint16_t *RTFilter_GetTable(search_result_t *result)
+{
+    return (result->table != NULL) ? result->table : result->result_table;
+}
+/******************************************************************************
+ * @brief Get the number of entry indexes a result can keep
+ * @param result : Pointer to result table
+ * @return Capacity of the table given to RTFilter_ResetTable, else MAX_RTB_RESULT
+ ******************************************************************************/
+static inline uint16_t RTFilter_GetCapacity(search_result_t *result)
+{
+    return (result->table != NULL) ? result->capacity : MAX_RTB_RESULT;
+}
+/******************************************************************************
+ * @brief Put all the services of the routing table in a result
+ * When the routing table have more services than the result capacity only
+ * the first ones are kept and the result is flagged as truncated.
+ * @param result : Pointer to result table
+ * @return None
+ ******************************************************************************/
+static void RTFilter_Fill(search_result_t *result)
 {
-    // the initialization is to keep a pointer to all the  servicesentries of the routing table
+    uint16_t *table   = RTFilter_GetTable(result);
+    uint16_t capacity = RTFilter_GetCapacity(result);
+
     result->result_nbr = 0;
-    for (uint8_t i = 0; i < last_routing_table_entry; i++)
+    result->truncated  = false;
+    result->generation = rtb_generation;
+    for (uint16_t i = 0; i < last_routing_table_entry; i++)
     {
         if (routing_table[i].mode == SERVICE)
         {
-            result->result_table[result->result_nbr] = &routing_table[i];
+            if (result->result_nbr >= capacity)
+            {
+                // The routing table is bigger than the result
+                result->truncated = true;
+                break;
+            }
+            table[result->result_nbr] = i;
             result->result_nbr++;
         }
     }
+}
+/******************************************************************************
+ * @brief Initialize the Result table pointers
+ * A result keeps up to MAX_RTB_RESULT services, use RTFilter_ResetTable for
+ * bigger networks. The truncated flag tells if some services are missing.
+ * @param result : Pointer to result table
+ * @return Last entry
+ ******************************************************************************/
+search_result_t *RTFilter_Reset(search_result_t *result)
+{
+    // the initialization is to keep the index of all the services entries of the routing table
+    result->table    = NULL;
+    result->capacity = MAX_RTB_RESULT;
+    RTFilter_Fill(result);
     return result;
 }
 /******************************************************************************
- * @brief Find the service with a specific Id
- * @param result : Pointer to previous result research structure
- * @param id : Id that we want to find
- * @return new result research structure with the entry of the demanded id
+ * @brief Initialize the Result table pointers with a table given by the caller
+ * The table can be sized from RoutingTB_GetLastEntry to keep all the services
+ * of a routing table growing with the network.
+ * @param result : Pointer to result table
+ * @param table : Table receiving the entry indexes, kept until the next reset
+ * @param capacity : Number of entry indexes the table can keep
+ * @return Last entry
  ******************************************************************************/
-search_result_t *RTFilter_ID(search_result_t *result, uint16_t id)
+search_result_t *RTFilter_ResetTable(search_result_t *result, uint16_t *table, uint16_t capacity)
 {
-    uint8_t entry_nbr = 0;
-    // Check result pointer
-    LUOS_ASSERT(result != 0);
-    // if we the result is not initialized return 0
-    if (RTFilter_InitCheck(result) == FAILED)
+    LUOS_ASSERT(table != NULL);
+    result->table    = table;
+    result->capacity = capacity;
+    RTFilter_Fill(result);
+    return result;
+}
+/******************************************************************************
+ * @brief Check if a result have been computed with the current routing table
+ * @param result : Pointer to result table
+ * @return true if the result is still valid
+ ******************************************************************************/
+bool RTFilter_IsUpToDate(search_result_t *result)
+{
+    return (result->generation == rtb_generation);
+}
+/******************************************************************************
+ * @brief Memoised research, only recompute the result if the routing table changed
+ * Always use the same filter with the same result.
+ * @param result : Pointer to the result kept between calls
+ * @param filter : Criteria to match, NULL to keep all the services
+ * @return Pointer to the up to date result
+ ******************************************************************************/
+search_result_t *RTFilter_Refresh(search_result_t *result, const rt_filter_t *filter)
+{
+    if (RTFilter_IsUpToDate(result))
     {
-        result->result_nbr = 0;
+        return result;
     }
-    while (entry_nbr < result->result_nbr)
+    // Keep the table the result have been reset with
+    RTFilter_Fill(result);
+    if (filter != NULL)
     {
-        // find a service with the wanted type
-        if (result->result_table[entry_nbr]->id != id)
-        {
-            // if we find an other id, erase it from the research table
-            memcpy(&result->result_table[entry_nbr], &result->result_table[entry_nbr + 1], sizeof(routing_table_t *) * (result->result_nbr - entry_nbr));
-            result->result_nbr--;
-        }
-        else
-        {
-            entry_nbr++;
-        }
+        RTFilter_Match(result, filter);
     }
-    // return a pointer to the search structure
-    return (result);
+    return result;
 }
 /******************************************************************************
- * @brief Search all the services with the same type
+ * @brief Get the routing table entry of a result
+ * @param result : Pointer to result research structure
+ * @param result_index : Index of the result
+ * @return Pointer to the routing table entry
+ ******************************************************************************/
+routing_table_t *RTFilter_GetEntry(search_result_t *result, uint16_t result_index)
+{
+    LUOS_ASSERT((result != 0) && (result_index < RTFilter_GetCapacity(result)) && (RTFilter_GetTable(result)[result_index] < rtb_capacity));
+    return &routing_table[RTFilter_GetTable(result)[result_index]];
+}
+/******************************************************************************
+ * @brief Check if a routing table entry match all the criteria of a filter
+ * @param entry : Routing table entry
+ * @param filter : Criteria to check
+ * @return true if the entry match
+ ******************************************************************************/
+static bool RTFilter_IsMatching(routing_table_t *entry, const rt_filter_t *filter)
+{
+    if ((filter->criteria & FILTER_ID) && (entry->id != filter->id))
+    {
+        return false;
+    }
+    if ((filter->criteria & FILTER_TYPE) && (entry->type != filter->type))
+    {
+        return false;
+    }
+    if ((filter->criteria & FILTER_ALIAS) && (strstr(entry->alias, filter->alias) == 0))
+    {
+        return false;
+    }
+    if ((filter->criteria & FILTER_NODE) && (RoutingTB_NodeIDFromID(entry->id) != filter->node_id))
+    {
+        return false;
+    }
+    return true;
+}
+/******************************************************************************
+ * @brief Keep only the services matching all the criteria of a filter
  * @param result : Pointer to previous result research structure
- * @param type : Type that we want to find
+ * @param filter : Criteria to apply in a single sweep
  * @return New result research structure
  ******************************************************************************/
-search_result_t *RTFilter_Type(search_result_t *result, luos_type_t type)
+search_result_t *RTFilter_Match(search_result_t *result, const rt_filter_t *filter)
 {
-    uint8_t entry_nbr = 0;
+    uint16_t kept_nbr = 0;
+    uint16_t *table   = NULL;
     // Check result pointer
-    LUOS_ASSERT(result != 0);
+    LUOS_ASSERT((result != 0) && (filter != 0));
+    table = RTFilter_GetTable(result);
     // if we the result is not initialized return 0
     if (RTFilter_InitCheck(result) == FAILED)
     {
         result->result_nbr = 0;
     }
-    while (entry_nbr < result->result_nbr)
+    // Compact the matching entries at the begining of the research table keeping their order
+    for (uint16_t entry_nbr = 0; entry_nbr < result->result_nbr; entry_nbr++)
     {
-        // find a service with the wanted type
-        if (result->result_table[entry_nbr]->type != type)
-        {
-            // if we find an other type, erase it from the research table
-            memcpy(&result->result_table[entry_nbr], &result->result_table[entry_nbr + 1], sizeof(routing_table_t *) * (result->result_nbr - entry_nbr));
-            result->result_nbr--;
-        }
-        else
+        if (RTFilter_IsMatching(&routing_table[table[entry_nbr]], filter))
         {
-            entry_nbr++;
+            table[kept_nbr++] = table[entry_nbr];
         }
     }
+    result->result_nbr = kept_nbr;
     // return a pointer to the search structure
     return (result);
 }
+/******************************************************************************
+ * @brief Find the service with a specific Id
+ * @param result : Pointer to previous result research structure
+ * @param id : Id that we want to find
+ * @return new result research structure with the entry of the demanded id
+ ******************************************************************************/
+search_result_t *RTFilter_ID(search_result_t *result, uint16_t id)
+{
+    rt_filter_t filter = {.criteria = FILTER_ID, .id = id};
+    return RTFilter_Match(result, &filter);
+}
+/******************************************************************************
+ * @brief Search all the services with the same type
+ * @param result : Pointer to previous result research structure
+ * @param type : Type that we want to find
+ * @return New result research structure
+ ******************************************************************************/
+search_result_t *RTFilter_Type(search_result_t *result, luos_type_t type)
+{
+    rt_filter_t filter = {.criteria = FILTER_TYPE, .type = type};
+    return RTFilter_Match(result, &filter);
+}
 /******************************************************************************
  * @brief Search all the services of the same node
  * @param result : Pointer to previous result research structure
@@ -604,62 +1612,20 @@ search_result_t *RTFilter_Type(search_result_t *result, luos_type_t type)
  ******************************************************************************/
 search_result_t *RTFilter_Node(search_result_t *result, uint16_t node_id)
 {
-    uint8_t entry_nbr = 0;
-    // Check result pointer
-    LUOS_ASSERT(result != 0);
-    // if we the result is not initialized return 0
-    if (RTFilter_InitCheck(result) == FAILED)
-    {
-        result->result_nbr = 0;
-    }
-    // search all the entries of the research table
-    while (entry_nbr < result->result_nbr)
-    {
-        // find a service with the wanted node_id
-        if (RoutingTB_NodeIDFromID(result->result_table[entry_nbr]->id) != node_id)
-        {
-            // if we find an other node_id, erase it from the research table
-            memcpy(&result->result_table[entry_nbr], &result->result_table[entry_nbr + 1], sizeof(routing_table_t *) * (result->result_nbr - entry_nbr));
-            result->result_nbr--;
-        }
-        else
-        {
-            entry_nbr++;
-        }
-    }
-    // return a pointer to the search structure
-    return (result);
+    rt_filter_t filter = {.criteria = FILTER_NODE, .node_id = node_id};
+    return RTFilter_Match(result, &filter);
 }
-
+/******************************************************************************
+ * @brief Search all the services containing an alias
+ * @param result : Pointer to previous result research structure
+ * @param alias : Alias (or part of alias) that we want to find
+ * @return New result research structure
+ ******************************************************************************/
 search_result_t *RTFilter_Alias(search_result_t *result, char *alias)
 {
-    uint8_t entry_nbr = 0;
-    // Check result pointer
-    LUOS_ASSERT(result != 0);
-    // if we the result is not initialized return 0
-    if (RTFilter_InitCheck(result) == FAILED)
-    {
-        result->result_nbr = 0;
-    }
-    // search all the entries of the research table
-    while (entry_nbr < result->result_nbr)
-    {
-        // find a service with the wanted node_id
-        if (strstr(result->result_table[entry_nbr]->alias, alias) == 0)
-        {
-            // if we find an other node_id, erase it from the research table
-            memcpy(&result->result_table[entry_nbr], &result->result_table[entry_nbr + 1], sizeof(routing_table_t *) * (result->result_nbr - entry_nbr));
-            result->result_nbr--;
-        }
-        else
-        {
-            entry_nbr++;
-        }
-    }
-    // return a pointer to the search structure
-    return (result);
+    rt_filter_t filter = {.criteria = FILTER_ALIAS, .alias = alias};
+    return RTFilter_Match(result, &filter);
 }
-
 /******************************************************************************
  * @brief Find the service info with a service pointer
  * @param result : Pointer to previous result research structure
@@ -668,29 +1634,13 @@ search_result_t *RTFilter_Alias(search_result_t *result, char *alias)
  ******************************************************************************/
 search_result_t *RTFilter_Service(search_result_t *result, service_t *service)
 {
-    uint8_t entry_nbr = 0;
-    // Check result pointer
-    LUOS_ASSERT(result != 0);
-    // if we the result is not initialized return 0
-    if (RTFilter_InitCheck(result) == FAILED)
-    {
-        result->result_nbr = 0;
-    }
+    rt_filter_t filter = {.criteria = FILTER_ID};
     LUOS_ASSERT(service != 0);
-    while (entry_nbr < result->result_nbr)
+    if (service == 0)
     {
-        // find a service with the wanted type
-        if (result->result_table[entry_nbr]->id != service->ll_service->id)
-        {
-            // if we find an other id, erase it from the research table
-            memcpy(&result->result_table[entry_nbr], &result->result_table[entry_nbr + 1], sizeof(routing_table_t *) * (result->result_nbr - entry_nbr));
-            result->result_nbr--;
-        }
-        else
-        {
-            entry_nbr++;
-        }
+        result->result_nbr = 0;
+        return result;
     }
-    // return a pointer to the search structure
-    return (result);
+    filter.id = service->ll_service->id;
+    return RTFilter_Match(result, &filter);
 }
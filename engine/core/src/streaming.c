@@ -10,6 +10,9 @@
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
+// Lock free channel counters are published after the copy of their samples
+#define STREAM_LOAD_ACQUIRE(counter)         __atomic_load_n(&(counter), __ATOMIC_ACQUIRE)
+#define STREAM_STORE_RELEASE(counter, value) __atomic_store_n(&(counter), (value), __ATOMIC_RELEASE)
 
 /*******************************************************************************
  * Variables
@@ -18,6 +21,10 @@
 /*******************************************************************************
  * Function
  ******************************************************************************/
+static inline void Stream_ShiftDate(streaming_channel_t *stream, uint32_t size);
+static inline void Stream_Overwrite(streaming_channel_t *stream, uint16_t size);
+static inline void Stream_Skip(streaming_channel_t *stream, uint16_t size);
+static inline void *Stream_MovePtr(streaming_channel_t *stream, void *ptr, uint32_t size);
 
 /******************************************************************************
  * @brief Initialisation of a streaming channel.
@@ -38,6 +45,21 @@ streaming_channel_t Stream_CreateStreamingChannel(const void *ring_buffer, uint1
     // Set data pointers to 0
     stream.data_ptr   = stream.ring_buffer;
     stream.sample_ptr = stream.ring_buffer;
+
+    // Samples are not timed by default
+    stream.period_ns = 0;
+    stream.date_ns   = 0;
+
+    // Samples are not flow controlled by default
+    stream.sample_nb    = 0;
+    stream.credit       = 0;
+    stream.flow_control = false;
+
+    // A full channel asserts by default
+    stream.overwrite   = false;
+    stream.dropped     = 0;
+    stream.skipped     = 0;
+    stream.overwritten = 0;
     return stream;
 }
 /******************************************************************************
@@ -49,6 +71,8 @@ void Stream_ResetStreamingChannel(streaming_channel_t *stream)
 {
     stream->data_ptr   = stream->ring_buffer;
     stream->sample_ptr = stream->ring_buffer;
+    stream->date_ns    = 0;
+    stream->skipped    = stream->dropped;
 }
 /******************************************************************************
  * @brief Set data into ring buffer.
@@ -59,6 +83,19 @@ void Stream_ResetStreamingChannel(streaming_channel_t *stream)
  ******************************************************************************/
 uint16_t Stream_PutSample(streaming_channel_t *stream, const void *data, uint16_t size)
 {
+    if (stream->overwrite)
+    {
+        uint16_t capacity = Stream_GetAvailableSampleNB(stream) + Stream_GetFreeSampleNB(stream);
+        while (size > capacity)
+        {
+            // Only the last samples fit in the ring buffer, put the first ones by parts so the consumer skips them all
+            uint16_t part = ((size - capacity) > capacity) ? capacity : (size - capacity);
+            Stream_PutSample(stream, data, part);
+            data = (const uint8_t *)data + (part * stream->data_size);
+            size -= part;
+        }
+        Stream_Overwrite(stream, size);
+    }
     // check if we exceed ring buffer capacity
     LUOS_ASSERT((Stream_GetAvailableSampleNB(stream) + size) <= (stream->end_ring_buffer - stream->ring_buffer));
     if (((size * stream->data_size) + stream->data_ptr) >= stream->end_ring_buffer)
@@ -70,14 +107,14 @@ uint16_t Stream_PutSample(streaming_channel_t *stream, const void *data, uint16_
         memcpy(stream->data_ptr, data, chunk1);
         memcpy(stream->ring_buffer, (char *)data + chunk1, chunk2);
         // Set the new data pointer
-        stream->data_ptr = stream->ring_buffer + chunk2;
+        STREAM_STORE_RELEASE(stream->data_ptr, stream->ring_buffer + chunk2);
     }
     else
     {
         // our data fit before ring buffer end
         memcpy(stream->data_ptr, data, (size * stream->data_size));
         // Set the new data pointer
-        stream->data_ptr = stream->data_ptr + (size * stream->data_size);
+        STREAM_STORE_RELEASE(stream->data_ptr, stream->data_ptr + (size * stream->data_size));
     }
     return Stream_GetAvailableSampleNB(stream);
 }
@@ -90,7 +127,10 @@ uint16_t Stream_PutSample(streaming_channel_t *stream, const void *data, uint16_
  ******************************************************************************/
 uint16_t Stream_GetSample(streaming_channel_t *stream, void *data, uint16_t size)
 {
-    uint16_t nb_available_samples = Stream_GetAvailableSampleNB(stream);
+    uint16_t nb_available_samples = 0;
+    // Skip the samples replaced by the producer
+    Stream_Skip(stream, 0);
+    nb_available_samples = Stream_GetAvailableSampleNB(stream);
     if (nb_available_samples >= size)
     {
         // check if we need to loop in ring buffer
@@ -101,15 +141,13 @@ uint16_t Stream_GetSample(streaming_channel_t *stream, void *data, uint16_t size
             int chunk2 = (size * stream->data_size) - chunk1;
             memcpy(data, stream->sample_ptr, chunk1);
             memcpy((char *)data + chunk1, stream->ring_buffer, chunk2);
-            // Set the new sample pointer
-            stream->sample_ptr = stream->ring_buffer + chunk2;
         }
         else
         {
-            data = memcpy(data, stream->sample_ptr, (size * stream->data_size));
-            // Set the new sample pointer
-            stream->sample_ptr = stream->sample_ptr + (size * stream->data_size);
+            memcpy(data, stream->sample_ptr, (size * stream->data_size));
         }
+        // Set the new sample pointer
+        Stream_Skip(stream, size);
 
         nb_available_samples -= size;
     }
@@ -127,11 +165,14 @@ uint16_t Stream_GetSample(streaming_channel_t *stream, void *data, uint16_t size
  ******************************************************************************/
 uint16_t Stream_GetAvailableSampleNB(streaming_channel_t *stream)
 {
-    int32_t nb_available_sample = (stream->data_ptr - stream->sample_ptr) / stream->data_size;
+    // The producer counts the samples it replaces before publishing the new ones
+    void *data_ptr              = STREAM_LOAD_ACQUIRE(stream->data_ptr);
+    void *sample_ptr            = Stream_MovePtr(stream, stream->sample_ptr, STREAM_LOAD_ACQUIRE(stream->dropped) - stream->skipped);
+    int32_t nb_available_sample = (data_ptr - sample_ptr) / stream->data_size;
     if (nb_available_sample < 0)
     {
         // The buffer have looped
-        nb_available_sample = ((stream->end_ring_buffer - stream->sample_ptr) + (stream->data_ptr - stream->ring_buffer)) / stream->data_size;
+        nb_available_sample = ((stream->end_ring_buffer - sample_ptr) + (data_ptr - stream->ring_buffer)) / stream->data_size;
     }
     LUOS_ASSERT(nb_available_sample >= 0);
     return (uint16_t)nb_available_sample;
@@ -143,7 +184,10 @@ uint16_t Stream_GetAvailableSampleNB(streaming_channel_t *stream)
  ******************************************************************************/
 uint16_t Stream_GetAvailableSampleNBUntilEndBuffer(streaming_channel_t *stream)
 {
-    int32_t nb_available_sample = (stream->data_ptr - stream->sample_ptr) / stream->data_size;
+    int32_t nb_available_sample = 0;
+    // Skip the samples replaced by the producer
+    Stream_Skip(stream, 0);
+    nb_available_sample = (STREAM_LOAD_ACQUIRE(stream->data_ptr) - stream->sample_ptr) / stream->data_size;
     if (nb_available_sample < 0)
     {
         // The buffer have looped
@@ -160,16 +204,20 @@ uint16_t Stream_GetAvailableSampleNBUntilEndBuffer(streaming_channel_t *stream)
  ******************************************************************************/
 uint16_t Stream_AddAvailableSampleNB(streaming_channel_t *stream, uint16_t size)
 {
+    if (stream->overwrite)
+    {
+        Stream_Overwrite(stream, size);
+    }
     LUOS_ASSERT((uint32_t)(Stream_GetAvailableSampleNB(stream) + size) < (uint32_t)(stream->end_ring_buffer - stream->ring_buffer));
     if (((size * stream->data_size) + stream->data_ptr) >= stream->end_ring_buffer)
     {
-        uint16_t chunk1  = stream->end_ring_buffer - stream->data_ptr;
-        uint16_t chunk2  = (size * stream->data_size) - chunk1;
-        stream->data_ptr = stream->ring_buffer + chunk2;
+        uint16_t chunk1 = stream->end_ring_buffer - stream->data_ptr;
+        uint16_t chunk2 = (size * stream->data_size) - chunk1;
+        STREAM_STORE_RELEASE(stream->data_ptr, stream->ring_buffer + chunk2);
     }
     else
     {
-        stream->data_ptr = stream->data_ptr + (size * stream->data_size);
+        STREAM_STORE_RELEASE(stream->data_ptr, stream->data_ptr + (size * stream->data_size));
     }
     return Stream_GetAvailableSampleNB(stream);
 }
@@ -182,22 +230,500 @@ uint16_t Stream_AddAvailableSampleNB(streaming_channel_t *stream, uint16_t size)
 uint16_t Stream_RmvAvailableSampleNB(streaming_channel_t *stream, uint16_t size)
 {
     LUOS_ASSERT(Stream_GetAvailableSampleNB(stream) >= size);
-    // Check if we exceed ring buffer capacity
-    if (((size * stream->data_size) + stream->sample_ptr) > stream->end_ring_buffer)
+    Stream_Skip(stream, size);
+    return Stream_GetAvailableSampleNB(stream);
+}
+/******************************************************************************
+ * @brief Return the number of samples the ring buffer can still receive
+ * @param stream : Streaming channel pointer
+ * @return Number of free samples
+ ******************************************************************************/
+uint16_t Stream_GetFreeSampleNB(streaming_channel_t *stream)
+{
+    // A full ring buffer would look empty, keep one sample free
+    return (uint16_t)(((stream->end_ring_buffer - stream->ring_buffer) / stream->data_size) - Stream_GetAvailableSampleNB(stream) - 1);
+}
+/******************************************************************************
+ * @brief Return the number of samples the receiver still accept
+ * @param stream : Streaming channel pointer
+ * @return Number of samples allowed to be sent, 0xFFFF if the channel is not flow controlled
+ ******************************************************************************/
+uint16_t Stream_GetCreditSampleNB(streaming_channel_t *stream)
+{
+    int32_t credit = (int32_t)(stream->credit - stream->sample_nb);
+    if (stream->flow_control == false)
     {
-        // We exceed ring buffer end.
-        uint16_t chunk1    = stream->end_ring_buffer - stream->sample_ptr;
-        uint16_t chunk2    = (size * stream->data_size) - chunk1;
-        stream->sample_ptr = stream->ring_buffer + chunk2;
+        return 0xFFFF;
     }
-    else
+    if (credit < 0)
+    {
+        // The samples sent already reached the credit
+        return 0;
+    }
+    return (credit > 0xFFFF) ? 0xFFFF : (uint16_t)credit;
+}
+/******************************************************************************
+ * @brief Choose what happens when samples are put in a full streaming channel
+ * @param stream : Streaming channel pointer
+ * @param overwrite : true to replace the oldest samples, false to assert
+ * @return None
+ ******************************************************************************/
+void Stream_SetOverwriteMode(streaming_channel_t *stream, bool overwrite)
+{
+    stream->overwrite = overwrite;
+}
+/******************************************************************************
+ * @brief Get the samples replaced by the producer since the previous call
+ * Consumer side, the samples replaced are skipped first.
+ * @param stream : Streaming channel pointer
+ * @return Number of samples overwritten
+ ******************************************************************************/
+uint32_t Stream_GetOverwrittenSampleNB(streaming_channel_t *stream)
+{
+    uint32_t overwritten = 0;
+    Stream_Skip(stream, 0);
+    overwritten         = stream->overwritten;
+    stream->overwritten = 0;
+    return overwritten;
+}
+/******************************************************************************
+ * @brief Set the time between two samples of a streaming channel
+ * @param stream : Streaming channel pointer
+ * @param period : Sample period, 0 to stop timing the samples
+ * @return None
+ ******************************************************************************/
+void Stream_SetSamplePeriod(streaming_channel_t *stream, time_luos_t period)
+{
+    stream->period_ns = (int64_t)TimeOD_TimeTo_ns(period);
+}
+/******************************************************************************
+ * @brief Set data into ring buffer and date them
+ * The dates of the samples already available are computed back from the date
+ * of the new ones, so the last time base given is the one used.
+ * @param stream : Streaming channel pointer
+ * @param data : A pointer to the data table
+ * @param size : The number of data to copy
+ * @param date : Date of the first sample copied
+ * @return Number of samples to put in buffer
+ ******************************************************************************/
+uint16_t Stream_PutTimestampSample(streaming_channel_t *stream, const void *data, uint16_t size, time_luos_t date)
+{
+    return Stream_PutTimestampSampleNs(stream, data, size, (int64_t)TimeOD_TimeTo_ns(date));
+}
+/******************************************************************************
+ * @brief Set data into ring buffer and date them in ns
+ * @param stream : Streaming channel pointer
+ * @param data : A pointer to the data table
+ * @param size : The number of data to copy
+ * @param date_ns : Date of the first sample copied in ns
+ * @return Number of samples to put in buffer
+ ******************************************************************************/
+uint16_t Stream_PutTimestampSampleNs(streaming_channel_t *stream, const void *data, uint16_t size, int64_t date_ns)
+{
+    stream->date_ns = date_ns - (stream->period_ns * Stream_GetAvailableSampleNB(stream));
+    return Stream_PutSample(stream, data, size);
+}
+/******************************************************************************
+ * @brief Get the date of an available sample
+ * @param stream : Streaming channel pointer
+ * @param index : Position of the sample from the oldest one available
+ * @return Date of the sample
+ ******************************************************************************/
+time_luos_t Stream_GetSampleDate(streaming_channel_t *stream, uint16_t index)
+{
+    return TimeOD_TimeFrom_ns((double)(stream->date_ns + (stream->period_ns * index)));
+}
+/******************************************************************************
+ * @brief Move the date of the oldest sample after samples are taken out
+ * @param stream : Streaming channel pointer
+ * @param size : The number of samples taken out
+ * @return None
+ ******************************************************************************/
+static inline void Stream_ShiftDate(streaming_channel_t *stream, uint32_t size)
+{
+    if (stream->period_ns != 0)
+    {
+        stream->date_ns += stream->period_ns * size;
+    }
+}
+/******************************************************************************
+ * @brief Drop the oldest samples to make room for new ones
+ * @param stream : Streaming channel pointer
+ * @param size : The number of samples to make room for
+ * @return None
+ ******************************************************************************/
+static inline void Stream_Overwrite(streaming_channel_t *stream, uint16_t size)
+{
+    uint16_t free_nb = Stream_GetFreeSampleNB(stream);
+    if (size > free_nb)
+    {
+        // Producer side, let the consumer skip them
+        STREAM_STORE_RELEASE(stream->dropped, stream->dropped + (size - free_nb));
+    }
+}
+/******************************************************************************
+ * @brief Move the oldest sample after samples taken out
+ * Consumer side, the samples replaced by the producer are skipped and counted
+ * as overwritten. The ones replaced while they were read are taken out once.
+ * @param stream : Streaming channel pointer
+ * @param size : The number of samples taken out
+ * @return None
+ ******************************************************************************/
+static inline void Stream_Skip(streaming_channel_t *stream, uint16_t size)
+{
+    uint32_t dropped = STREAM_LOAD_ACQUIRE(stream->dropped);
+    uint32_t drop_nb = dropped - stream->skipped;
+    uint32_t move_nb = (drop_nb > size) ? drop_nb : size;
+
+    stream->skipped = dropped;
+    stream->overwritten += drop_nb;
+    stream->sample_ptr = Stream_MovePtr(stream, stream->sample_ptr, move_nb);
+    Stream_ShiftDate(stream, move_nb);
+}
+/******************************************************************************
+ * @brief Compute the position of a sample in the ring buffer
+ * @param stream : Streaming channel pointer
+ * @param ptr : Position of the sample to start from
+ * @param size : The number of samples to move of
+ * @return Position of the sample
+ ******************************************************************************/
+static inline void *Stream_MovePtr(streaming_channel_t *stream, void *ptr, uint32_t size)
+{
+    uint32_t sample_max = (stream->end_ring_buffer - stream->ring_buffer) / stream->data_size;
+    uint32_t index      = ((uint32_t)((ptr - stream->ring_buffer) / stream->data_size) + (size % sample_max)) % sample_max;
+    return stream->ring_buffer + (index * stream->data_size);
+}
+/******************************************************************************
+ * @brief Initialisation of a lock free streaming channel.
+ * @param ring_buffer : Pointer to a data table
+ * @param ring_buffer_size : Size of the buffer in number of values, a power of 2.
+ * @param data_size : Values size.
+ * @return Lock free streaming channel
+ ******************************************************************************/
+spsc_channel_t Stream_CreateSpscChannel(const void *ring_buffer, uint16_t ring_buffer_size, uint8_t data_size)
+{
+    spsc_channel_t stream;
+    // The counters wrap with a mask, the ring buffer size have to be a power of 2
+    LUOS_ASSERT((ring_buffer != NULL) && (data_size > 0) && (ring_buffer_size > 0) && ((ring_buffer_size & (ring_buffer_size - 1)) == 0));
+    // Save ring buffer informations
+    stream.ring_buffer = (uint8_t *)ring_buffer;
+    stream.mask        = ring_buffer_size - 1;
+    stream.data_size   = data_size;
+
+    // Set counters to 0
+    stream.head = 0;
+    stream.tail = 0;
+    return stream;
+}
+/******************************************************************************
+ * @brief Re initialize a lock free streaming channel.
+ * The producer and the consumer must not use the channel during the reset.
+ * @param stream : Lock free streaming channel pointer
+ * @return None
+ ******************************************************************************/
+void Stream_ResetSpscChannel(spsc_channel_t *stream)
+{
+    STREAM_STORE_RELEASE(stream->head, 0);
+    STREAM_STORE_RELEASE(stream->tail, 0);
+}
+/******************************************************************************
+ * @brief Set data into ring buffer, producer side.
+ * @param stream : Lock free streaming channel pointer
+ * @param data : A pointer to the data table
+ * @param size : The number of data to copy
+ * @return Number of samples put in buffer, lower than size if the buffer is full
+ ******************************************************************************/
+uint16_t Stream_SpscPutSample(spsc_channel_t *stream, const void *data, uint16_t size)
+{
+    uint32_t head       = stream->head;
+    uint32_t index      = head & stream->mask;
+    uint32_t free_nb    = (stream->mask + 1) - (head - STREAM_LOAD_ACQUIRE(stream->tail));
+    uint32_t chunk_size = (stream->mask + 1) - index;
+
+    if (size > free_nb)
+    {
+        size = free_nb;
+    }
+    if (chunk_size > size)
+    {
+        chunk_size = size;
+    }
+    // Copy until the end of the ring buffer then from its beginning
+    memcpy(&stream->ring_buffer[index * stream->data_size], data, chunk_size * stream->data_size);
+    memcpy(stream->ring_buffer, (const uint8_t *)data + (chunk_size * stream->data_size), (size - chunk_size) * stream->data_size);
+    // Give the samples to the consumer once they are written
+    STREAM_STORE_RELEASE(stream->head, head + size);
+    return size;
+}
+/******************************************************************************
+ * @brief Copy samples from ring buffer to a data, consumer side.
+ * @param stream : Lock free streaming channel pointer
+ * @param data : A pointer of data
+ * @param size : The number of data to copy
+ * @return Number of samples copied, lower than size if the buffer is empty
+ ******************************************************************************/
+uint16_t Stream_SpscGetSample(spsc_channel_t *stream, void *data, uint16_t size)
+{
+    uint32_t tail         = stream->tail;
+    uint32_t index        = tail & stream->mask;
+    uint32_t available_nb = STREAM_LOAD_ACQUIRE(stream->head) - tail;
+    uint32_t chunk_size   = (stream->mask + 1) - index;
+
+    if (size > available_nb)
+    {
+        size = available_nb;
+    }
+    if (chunk_size > size)
+    {
+        chunk_size = size;
+    }
+    // Copy until the end of the ring buffer then from its beginning
+    memcpy(data, &stream->ring_buffer[index * stream->data_size], chunk_size * stream->data_size);
+    memcpy((uint8_t *)data + (chunk_size * stream->data_size), stream->ring_buffer, (size - chunk_size) * stream->data_size);
+    // Give the space back to the producer once the samples are read
+    STREAM_STORE_RELEASE(stream->tail, tail + size);
+    return size;
+}
+/******************************************************************************
+ * @brief Return the number of available samples
+ * @param stream : Lock free streaming channel pointer
+ * @return Number of availabled samples
+ ******************************************************************************/
+uint16_t Stream_SpscGetAvailableSampleNB(spsc_channel_t *stream)
+{
+    uint32_t tail = STREAM_LOAD_ACQUIRE(stream->tail);
+    return (uint16_t)(STREAM_LOAD_ACQUIRE(stream->head) - tail);
+}
+/******************************************************************************
+ * @brief Return the number of samples able to be put in buffer
+ * @param stream : Lock free streaming channel pointer
+ * @return Number of free samples
+ ******************************************************************************/
+uint16_t Stream_SpscGetFreeSampleNB(spsc_channel_t *stream)
+{
+    return (uint16_t)((stream->mask + 1) - Stream_SpscGetAvailableSampleNB(stream));
+}
+/******************************************************************************
+ * @brief Get sample number availabled in buffer before its end, consumer side
+ * @param stream : Lock free streaming channel pointer
+ * @return Number of contiguous available samples from Stream_SpscGetSamplePtr
+ ******************************************************************************/
+uint16_t Stream_SpscGetAvailableSampleNBUntilEndBuffer(spsc_channel_t *stream)
+{
+    uint32_t available_nb = Stream_SpscGetAvailableSampleNB(stream);
+    uint32_t until_end_nb = (stream->mask + 1) - (stream->tail & stream->mask);
+    return (uint16_t)((available_nb < until_end_nb) ? available_nb : until_end_nb);
+}
+/******************************************************************************
+ * @brief Get sample number able to be written in buffer before its end, producer side
+ * @param stream : Lock free streaming channel pointer
+ * @return Number of contiguous free samples from Stream_SpscGetDataPtr
+ ******************************************************************************/
+uint16_t Stream_SpscGetFreeSampleNBUntilEndBuffer(spsc_channel_t *stream)
+{
+    uint32_t free_nb      = Stream_SpscGetFreeSampleNB(stream);
+    uint32_t until_end_nb = (stream->mask + 1) - (stream->head & stream->mask);
+    return (uint16_t)((free_nb < until_end_nb) ? free_nb : until_end_nb);
+}
+/******************************************************************************
+ * @brief Get the oldest available sample, consumer side
+ * @param stream : Lock free streaming channel pointer
+ * @return Pointer to the sample
+ ******************************************************************************/
+void *Stream_SpscGetSamplePtr(spsc_channel_t *stream)
+{
+    return &stream->ring_buffer[(stream->tail & stream->mask) * stream->data_size];
+}
+/******************************************************************************
+ * @brief Get the place of the next sample to write, producer side
+ * @param stream : Lock free streaming channel pointer
+ * @return Pointer to the sample
+ ******************************************************************************/
+void *Stream_SpscGetDataPtr(spsc_channel_t *stream)
+{
+    return &stream->ring_buffer[(stream->head & stream->mask) * stream->data_size];
+}
+/******************************************************************************
+ * @brief Set a number of sample written in buffer available, producer side
+ * Allow a DMA or a driver to write directly from Stream_SpscGetDataPtr.
+ * @param stream : Lock free streaming channel pointer
+ * @param size : The number of data written
+ * @return Number of availabled samples
+ ******************************************************************************/
+uint16_t Stream_SpscAddAvailableSampleNB(spsc_channel_t *stream, uint16_t size)
+{
+    LUOS_ASSERT(size <= Stream_SpscGetFreeSampleNB(stream));
+    STREAM_STORE_RELEASE(stream->head, stream->head + size);
+    return Stream_SpscGetAvailableSampleNB(stream);
+}
+/******************************************************************************
+ * @brief Remove a specific number of samples in buffer, consumer side
+ * Allow a DMA or a driver to read directly from Stream_SpscGetSamplePtr.
+ * @param stream : Lock free streaming channel pointer
+ * @param size : The number of data to remove
+ * @return Number of availabled samples
+ ******************************************************************************/
+uint16_t Stream_SpscRmvAvailableSampleNB(spsc_channel_t *stream, uint16_t size)
+{
+    LUOS_ASSERT(size <= Stream_SpscGetAvailableSampleNB(stream));
+    STREAM_STORE_RELEASE(stream->tail, stream->tail + size);
+    return Stream_SpscGetAvailableSampleNB(stream);
+}
+/******************************************************************************
+ * @brief Initialisation of a broadcast streaming channel.
+ * @param ring_buffer : Pointer to a data table
+ * @param ring_buffer_size : Size of the buffer in number of values, a power of 2.
+ * @param data_size : Values size.
+ * @return Broadcast streaming channel
+ ******************************************************************************/
+broadcast_channel_t Stream_CreateBroadcastChannel(const void *ring_buffer, uint16_t ring_buffer_size, uint8_t data_size)
+{
+    broadcast_channel_t stream;
+    // The counters wrap with a mask, the ring buffer size have to be a power of 2
+    LUOS_ASSERT((ring_buffer != NULL) && (data_size > 0) && (ring_buffer_size > 0) && ((ring_buffer_size & (ring_buffer_size - 1)) == 0));
+    memset(&stream, 0, sizeof(broadcast_channel_t));
+    // Save ring buffer informations
+    stream.ring_buffer = (uint8_t *)ring_buffer;
+    stream.mask        = ring_buffer_size - 1;
+    stream.data_size   = data_size;
+    return stream;
+}
+/******************************************************************************
+ * @brief Register a reader of a broadcast streaming channel
+ * The reader starts with the next sample put in the channel.
+ * @param stream : Broadcast streaming channel pointer
+ * @param reader : Reader to register
+ * @param policy : Behavior when this reader is late
+ * @return SUCCEED : If the reader is registered, else FAILED
+ ******************************************************************************/
+error_return_t Stream_AddBroadcastReader(broadcast_channel_t *stream, stream_reader_t *reader, stream_reader_policy_t policy)
+{
+    LUOS_ASSERT(reader != NULL);
+    if (stream->reader_nb >= MAX_STREAM_READER)
+    {
+        return FAILED;
+    }
+    reader->tail                        = stream->head;
+    reader->overrun_nb                  = 0;
+    reader->policy                      = policy;
+    stream->reader[stream->reader_nb++] = reader;
+    return SUCCEED;
+}
+/******************************************************************************
+ * @brief Unregister a reader of a broadcast streaming channel
+ * The samples this reader didn't read are no more kept for it, a blocking
+ * reader doesn't stop the producer anymore.
+ * @param stream : Broadcast streaming channel pointer
+ * @param reader : Reader to unregister
+ * @return SUCCEED : If the reader is unregistered, FAILED if it was not registered
+ ******************************************************************************/
+error_return_t Stream_RemoveBroadcastReader(broadcast_channel_t *stream, stream_reader_t *reader)
+{
+    for (uint8_t i = 0; i < stream->reader_nb; i++)
     {
-        stream->sample_ptr = stream->sample_ptr + (size * stream->data_size);
-        if (stream->sample_ptr == stream->end_ring_buffer)
+        if (stream->reader[i] == reader)
         {
-            // If we are exactly at the end of the ring buffer, we need to loop
-            stream->sample_ptr = stream->ring_buffer;
+            // Keep the other readers packed
+            stream->reader_nb--;
+            memmove(&stream->reader[i], &stream->reader[i + 1], (stream->reader_nb - i) * sizeof(stream_reader_t *));
+            stream->reader[stream->reader_nb] = NULL;
+            return SUCCEED;
         }
     }
-    return Stream_GetAvailableSampleNB(stream);
+    return FAILED;
+}
+/******************************************************************************
+ * @brief Set data into ring buffer, shared by all the readers.
+ * @param stream : Broadcast streaming channel pointer
+ * @param data : A pointer to the data table
+ * @param size : The number of data to copy
+ * @return Number of samples put in buffer, lower than size if a blocking reader is late
+ ******************************************************************************/
+uint16_t Stream_BroadcastPutSample(broadcast_channel_t *stream, const void *data, uint16_t size)
+{
+    uint32_t index      = stream->head & stream->mask;
+    uint32_t free_nb    = Stream_BroadcastGetFreeSampleNB(stream);
+    uint32_t chunk_size = (stream->mask + 1) - index;
+
+    if (size > free_nb)
+    {
+        size = free_nb;
+    }
+    if (chunk_size > size)
+    {
+        chunk_size = size;
+    }
+    // Copy until the end of the ring buffer then from its beginning
+    memcpy(&stream->ring_buffer[index * stream->data_size], data, chunk_size * stream->data_size);
+    memcpy(stream->ring_buffer, (const uint8_t *)data + (chunk_size * stream->data_size), (size - chunk_size) * stream->data_size);
+    stream->head += size;
+    // Move the overrun readers after the samples overwritten
+    for (uint8_t i = 0; i < stream->reader_nb; i++)
+    {
+        uint32_t late_nb = stream->head - stream->reader[i]->tail;
+        if (late_nb > (stream->mask + 1))
+        {
+            // This reader lost its oldest samples
+            stream->reader[i]->overrun_nb += late_nb - (stream->mask + 1);
+            stream->reader[i]->tail = stream->head - (stream->mask + 1);
+        }
+    }
+    return size;
+}
+/******************************************************************************
+ * @brief Copy samples from ring buffer to a data, for one reader.
+ * @param stream : Broadcast streaming channel pointer
+ * @param reader : Reader getting the samples
+ * @param data : A pointer of data
+ * @param size : The number of data to copy
+ * @return Number of samples copied, lower than size if the reader have no more samples
+ ******************************************************************************/
+uint16_t Stream_BroadcastGetSample(broadcast_channel_t *stream, stream_reader_t *reader, void *data, uint16_t size)
+{
+    uint32_t index        = reader->tail & stream->mask;
+    uint32_t available_nb = Stream_BroadcastGetAvailableSampleNB(stream, reader);
+    uint32_t chunk_size   = (stream->mask + 1) - index;
+
+    if (size > available_nb)
+    {
+        size = available_nb;
+    }
+    if (chunk_size > size)
+    {
+        chunk_size = size;
+    }
+    // Copy until the end of the ring buffer then from its beginning
+    memcpy(data, &stream->ring_buffer[index * stream->data_size], chunk_size * stream->data_size);
+    memcpy((uint8_t *)data + (chunk_size * stream->data_size), stream->ring_buffer, (size - chunk_size) * stream->data_size);
+    reader->tail += size;
+    return size;
+}
+/******************************************************************************
+ * @brief Return the number of samples available for one reader
+ * @param stream : Broadcast streaming channel pointer
+ * @param reader : Reader of the channel
+ * @return Number of availabled samples
+ ******************************************************************************/
+uint16_t Stream_BroadcastGetAvailableSampleNB(broadcast_channel_t *stream, stream_reader_t *reader)
+{
+    return (uint16_t)(stream->head - reader->tail);
+}
+/******************************************************************************
+ * @brief Return the number of samples able to be put in buffer
+ * Only the blocking readers limit it.
+ * @param stream : Broadcast streaming channel pointer
+ * @return Number of free samples
+ ******************************************************************************/
+uint16_t Stream_BroadcastGetFreeSampleNB(broadcast_channel_t *stream)
+{
+    uint32_t free_nb = stream->mask + 1;
+
+    for (uint8_t i = 0; i < stream->reader_nb; i++)
+    {
+        if ((stream->reader[i]->policy == STREAM_READER_BLOCK) && ((stream->mask + 1) - (stream->head - stream->reader[i]->tail) < free_nb))
+        {
+            free_nb = (stream->mask + 1) - (stream->head - stream->reader[i]->tail);
+        }
+    }
+    return (uint16_t)free_nb;
 }
@@ -0,0 +1,340 @@
+/******************************************************************************
+ * @file timer_wheel
+ * @brief Hierarchical timer wheel scheduling periodic jobs with a microsecond
+ *        resolution
+ *
+ *  The wheel is made of levels of 16 slots, each level being 16 times coarser
+ *  than the previous one. A timer is linked in the level matching the time
+ *  left before its expiration. When the wheel date reaches the date of a slot
+ *  its timers are moved down to a finer level, when it reaches a slot of the
+ *  level 0 its timers expire.
+ *  Each level keeps a bit field of its non empty slots so the wheel directly
+ *  jumps to the next date with something to do instead of ticking.
+ *
+ * @author Luos
+ * @version 0.0.0
+ ******************************************************************************/
+#include <string.h>
+#include "timer_wheel.h"
+#include "luos_hal.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define TIMER_WHEEL_SLOT_BITS 4
+#define TIMER_WHEEL_SLOT_NB   (1 << TIMER_WHEEL_SLOT_BITS) // Fit into the uint16_t occupied bit field
+#define TIMER_WHEEL_SLOT_MASK (TIMER_WHEEL_SLOT_NB - 1)
+#define TIMER_WHEEL_LEVEL_NB  8 // 8 levels of 4 bits cover any uint32_t delay
+#define TIMER_WHEEL_FAR_LEVEL TIMER_WHEEL_LEVEL_NB
+#define TIMER_WHEEL_RANGE     ((uint64_t)1 << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVEL_NB))
+
+typedef struct
+{
+    uint64_t date;                                                 // Date reached by the wheel in us
+    luos_timer_t *slot[TIMER_WHEEL_LEVEL_NB][TIMER_WHEEL_SLOT_NB]; // Timers linked in each slot
+    uint16_t occupied[TIMER_WHEEL_LEVEL_NB];                       // Bit field of the non empty slots
+    luos_timer_t *far;                                             // Timers out of the range of the wheel
+    uint64_t far_date;                                             // Date to try again to put far timers in the wheel
+} timer_wheel_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static timer_wheel_t wheel;
+
+/*******************************************************************************
+ * Function
+ ******************************************************************************/
+static void TimerWheel_Insert(luos_timer_t *timer);
+static void TimerWheel_Unlink(luos_timer_t *timer);
+static void TimerWheel_Reinsert(luos_timer_t *list);
+static uint64_t TimerWheel_NextDate(void);
+
+/******************************************************************************
+ * @brief Get the date used by the timer wheel
+ * @param None
+ * @return Date in us
+ ******************************************************************************/
+uint64_t TimerWheel_Now(void)
+{
+    return LuosHAL_GetTimestamp() / 1000;
+}
+
+/******************************************************************************
+ * @brief Init the timer wheel, stop all the timers
+ * @param None
+ * @return None
+ ******************************************************************************/
+void TimerWheel_Init(void)
+{
+    // Release the timers still linked so they can be started again
+    for (uint8_t level = 0; level < TIMER_WHEEL_LEVEL_NB; level++)
+    {
+        for (uint8_t slot = 0; slot < TIMER_WHEEL_SLOT_NB; slot++)
+        {
+            while (wheel.slot[level][slot] != NULL)
+            {
+                TimerWheel_Unlink(wheel.slot[level][slot]);
+            }
+        }
+    }
+    while (wheel.far != NULL)
+    {
+        TimerWheel_Unlink(wheel.far);
+    }
+    memset(&wheel, 0, sizeof(timer_wheel_t));
+    wheel.date = TimerWheel_Now();
+}
+
+/******************************************************************************
+ * @brief Expire all the timers reaching their date, called by Luos_Loop
+ * @param None
+ * @return None
+ ******************************************************************************/
+void TimerWheel_Loop(void)
+{
+    uint64_t now = TimerWheel_Now();
+    uint64_t date;
+    uint8_t slot;
+    luos_timer_t *timer;
+    luos_timer_t *list;
+
+    while ((date = TimerWheel_NextDate()) <= now)
+    {
+        wheel.date = date;
+        // Try again to put far timers into the wheel
+        if ((wheel.far != NULL) && (wheel.far_date == date))
+        {
+            list      = wheel.far;
+            wheel.far = NULL;
+            TimerWheel_Reinsert(list);
+        }
+        // Move down the timers of the slots reaching their date
+        for (uint8_t level = TIMER_WHEEL_LEVEL_NB - 1; level > 0; level--)
+        {
+            slot  = (date >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK;
+            timer = wheel.slot[level][slot];
+            if ((timer != NULL) && (((timer->expiry >> (TIMER_WHEEL_SLOT_BITS * level)) << (TIMER_WHEEL_SLOT_BITS * level)) == date))
+            {
+                list                    = timer;
+                wheel.slot[level][slot] = NULL;
+                wheel.occupied[level] &= ~(1 << slot);
+                TimerWheel_Reinsert(list);
+            }
+        }
+        // Expire the timers of this date
+        slot = date & TIMER_WHEEL_SLOT_MASK;
+        while ((timer = wheel.slot[0][slot]) != NULL)
+        {
+            TimerWheel_Unlink(timer);
+            if (timer->period)
+            {
+                // Reload before the callback to allow it to stop the timer
+                timer->expiry += timer->period;
+                if (timer->expiry <= now)
+                {
+                    // We are late, skip the missed periods but keep the phase
+                    timer->expiry += ((now - timer->expiry) / timer->period + 1) * timer->period;
+                }
+                TimerWheel_Insert(timer);
+            }
+            timer->callback(timer->arg);
+        }
+    }
+    // Nothing to do until now
+    if (wheel.date < now)
+    {
+        wheel.date = now;
+    }
+}
+
+/******************************************************************************
+ * @brief Compute the time left before the wheel have something to do
+ * @param None
+ * @return Time in us, 0 if late, TIMER_WHEEL_NO_EVENT if there is no timer
+ ******************************************************************************/
+uint64_t TimerWheel_NextEvent(void)
+{
+    uint64_t date = TimerWheel_NextDate();
+    uint64_t now  = TimerWheel_Now();
+
+    if (date == TIMER_WHEEL_NO_EVENT)
+    {
+        return TIMER_WHEEL_NO_EVENT;
+    }
+    return (date > now) ? (date - now) : 0;
+}
+
+/******************************************************************************
+ * @brief Start or restart a timer
+ * @param timer : Timer to start, must be zero initialized before its first use
+ * @param delay_us : Time before the first expiration in us
+ * @param period_us : Reload period in us, 0 for a one shot timer
+ * @param callback : Function called on each expiration
+ * @param arg : Argument given to the callback
+ * @return SUCCEED if the timer is started
+ ******************************************************************************/
+error_return_t TimerWheel_Start(luos_timer_t *timer, uint32_t delay_us, uint32_t period_us, TIMER_CB callback, void *arg)
+{
+    if ((timer == NULL) || (callback == NULL))
+    {
+        return FAILED;
+    }
+    TimerWheel_Stop(timer);
+    timer->expiry = TimerWheel_Now() + delay_us;
+    if (timer->expiry <= wheel.date)
+    {
+        // Never expire during the date currently managed by the wheel
+        timer->expiry = wheel.date + 1;
+    }
+    timer->period   = period_us;
+    timer->callback = callback;
+    timer->arg      = arg;
+    TimerWheel_Insert(timer);
+    return SUCCEED;
+}
+
+/******************************************************************************
+ * @brief Stop a timer, do nothing if the timer is not running
+ * @param timer : Timer to stop
+ * @return None
+ ******************************************************************************/
+void TimerWheel_Stop(luos_timer_t *timer)
+{
+    if ((timer != NULL) && (timer->prev != NULL))
+    {
+        TimerWheel_Unlink(timer);
+    }
+}
+
+/******************************************************************************
+ * @brief Check if a timer is waiting for its expiration
+ * @param timer : Timer to check
+ * @return true if the timer is running
+ ******************************************************************************/
+bool TimerWheel_IsRunning(luos_timer_t *timer)
+{
+    return (timer->prev != NULL);
+}
+
+/******************************************************************************
+ * @brief Link a timer in the slot matching its expiration date
+ * @param timer : Timer to link
+ * @return None
+ ******************************************************************************/
+static void TimerWheel_Insert(luos_timer_t *timer)
+{
+    uint64_t delta = 0;
+    luos_timer_t **head;
+
+    if (timer->expiry < wheel.date)
+    {
+        timer->expiry = wheel.date;
+    }
+    delta        = timer->expiry - wheel.date;
+    timer->level = 0;
+    if (delta >= TIMER_WHEEL_RANGE)
+    {
+        // Too far for the wheel, keep it apart until the wheel get closer
+        if (wheel.far == NULL)
+        {
+            wheel.far_date = wheel.date + TIMER_WHEEL_RANGE - 1;
+        }
+        timer->level = TIMER_WHEEL_FAR_LEVEL;
+        timer->slot  = 0;
+        head         = &wheel.far;
+    }
+    else
+    {
+        while ((delta >> (TIMER_WHEEL_SLOT_BITS * (timer->level + 1))) != 0)
+        {
+            timer->level++;
+        }
+        timer->slot = (timer->expiry >> (TIMER_WHEEL_SLOT_BITS * timer->level)) & TIMER_WHEEL_SLOT_MASK;
+        head        = &wheel.slot[timer->level][timer->slot];
+        wheel.occupied[timer->level] |= (1 << timer->slot);
+    }
+    timer->next = *head;
+    if (timer->next != NULL)
+    {
+        timer->next->prev = &timer->next;
+    }
+    timer->prev = head;
+    *head       = timer;
+}
+
+/******************************************************************************
+ * @brief Remove a timer from its slot
+ * @param timer : Timer to remove
+ * @return None
+ ******************************************************************************/
+static void TimerWheel_Unlink(luos_timer_t *timer)
+{
+    *timer->prev = timer->next;
+    if (timer->next != NULL)
+    {
+        timer->next->prev = timer->prev;
+    }
+    if ((timer->level < TIMER_WHEEL_LEVEL_NB) && (wheel.slot[timer->level][timer->slot] == NULL))
+    {
+        wheel.occupied[timer->level] &= ~(1 << timer->slot);
+    }
+    timer->next = NULL;
+    timer->prev = NULL;
+}
+
+/******************************************************************************
+ * @brief Link again a list of timers removed from the wheel
+ * @param list : First timer of the list
+ * @return None
+ ******************************************************************************/
+static void TimerWheel_Reinsert(luos_timer_t *list)
+{
+    luos_timer_t *timer;
+    while (list != NULL)
+    {
+        timer = list;
+        list  = timer->next;
+        TimerWheel_Insert(timer);
+    }
+}
+
+/******************************************************************************
+ * @brief Find the next date the wheel have something to do
+ * Slots of a level are sorted by date starting after the slot of the wheel
+ * date, so the first non empty one is the next date of this level.
+ * @param None
+ * @return Date in us, TIMER_WHEEL_NO_EVENT if there is no timer
+ ******************************************************************************/
+static uint64_t TimerWheel_NextDate(void)
+{
+    uint64_t next = TIMER_WHEEL_NO_EVENT;
+    uint64_t date;
+    uint8_t shift;
+    uint8_t slot;
+
+    for (uint8_t level = 0; level < TIMER_WHEEL_LEVEL_NB; level++)
+    {
+        if (wheel.occupied[level] == 0)
+        {
+            continue;
+        }
+        shift = TIMER_WHEEL_SLOT_BITS * level;
+        // The level 0 slot of the wheel date is still to expire, upper levels already moved it down
+        slot = ((wheel.date >> shift) + ((level == 0) ? 0 : 1)) & TIMER_WHEEL_SLOT_MASK;
+        while ((wheel.occupied[level] & (1 << slot)) == 0)
+        {
+            slot = (slot + 1) & TIMER_WHEEL_SLOT_MASK;
+        }
+        date = (wheel.slot[level][slot]->expiry >> shift) << shift;
+        if (date < next)
+        {
+            next = date;
+        }
+    }
+    if ((wheel.far != NULL) && (wheel.far_date < next))
+    {
+        next = wheel.far_date;
+    }
+    return next;
+}
@@ -5,6 +5,7 @@
  * @version 0.0.0
  ******************************************************************************/
 #include "_timestamp.h"
+#include "clock_sync.h"
 #include "luos_hal.h"
 #include "string.h"
 #include "service_structs.h"
@@ -46,6 +47,12 @@
 *
 * Timestamp values are transformed from date to latency at message send and from latency to date at message reception.
 * This allow to track events in the system and put them at a representative date for the node using it.
+*
+* The timestamp is carried and converted as a 64 bits integer number of ns, avoiding floating point computation in the
+* transmission and reception paths. The time_luos_t conversion is only done when the user give or get the timestamp.
+*
+* Dates are in the network time given by the clock synchronisation, allowing to compare timestamps of different nodes
+* whatever the path of the messages.
 *
  ***************************************************************************************************/
 
@@ -54,13 +61,13 @@
  ******************************************************************************/
 
 /******************************************************************************
- * @brief Get the present timestamp
+ * @brief Get the present timestamp in the network time
  * @param msg None
  * @return time_luos_t
  ******************************************************************************/
 time_luos_t Timestamp_now(void)
 {
-    return TimeOD_TimeFrom_ns((double)LuosHAL_GetTimestamp());
+    return TimeOD_TimeFrom_ns((double)ClockSync_GetNetworkTime(LuosHAL_GetTimestamp()));
 }
 /******************************************************************************
  * @brief Check if the message is a timestamp message
@@ -78,11 +85,20 @@ _CRITICAL inline bool Timestamp_IsTimestampMsg(msg_t *msg)
  ******************************************************************************/
 time_luos_t Timestamp_GetTimestamp(msg_t *msg)
 {
-    time_luos_t timestamp = {0.0f};
+    return TimeOD_TimeFrom_ns((double)Timestamp_GetTimestampNs(msg));
+}
+/******************************************************************************
+ * @brief Get the timestamp associated to a message in ns
+ * @param msg : Message to get the timestamp from
+ * @return Timestamp in ns, 0 if the message is not timestamped
+ ******************************************************************************/
+int64_t Timestamp_GetTimestampNs(msg_t *msg)
+{
+    int64_t timestamp = 0;
     if (Timestamp_IsTimestampMsg(msg))
     {
         // Timestamp is at the end of the message
-        memcpy(&timestamp, (msg->data + msg->header.size), sizeof(time_luos_t));
+        memcpy(&timestamp, (msg->data + msg->header.size), TIMESTAMP_SIZE);
     }
     return timestamp;
 }
@@ -95,11 +111,22 @@ time_luos_t Timestamp_GetTimestamp(msg_t *msg)
  * @return None
  ******************************************************************************/
 void Timestamp_EncodeMsg(msg_t *msg, time_luos_t timestamp)
+{
+    Timestamp_EncodeMsgNs(msg, (int64_t)TimeOD_TimeTo_ns(timestamp));
+}
+
+/******************************************************************************
+ * @brief Modifies luos message according to a timestamp in ns
+ * @param msg : message to modify
+ * @param timestamp_ns : date of the message in ns
+ * @return None
+ ******************************************************************************/
+void Timestamp_EncodeMsgNs(msg_t *msg, int64_t timestamp_ns)
 {
     // Update message header protocol
     msg->header.config = TIMESTAMP_PROTOCOL;
     // Timestamp is at the end of the message copy it
-    memcpy(&msg->data[msg->header.size], &timestamp, sizeof(time_luos_t));
+    memcpy(&msg->data[msg->header.size], &timestamp_ns, TIMESTAMP_SIZE);
 }
 
 /******************************************************************************
@@ -109,20 +136,20 @@ void Timestamp_EncodeMsg(msg_t *msg, time_luos_t timestamp)
  ******************************************************************************/
 _CRITICAL void Timestamp_ConvertToLatency(msg_t *msg)
 {
-    static time_luos_t timestamp_date = {0.0f};
-    static msg_t *last_msg            = NULL;
+    static int64_t timestamp_date = 0;
+    static msg_t *last_msg        = NULL;
 
     if (last_msg != msg)
     {
         // This is a new message, backup the timestamp date
-        memcpy(&timestamp_date, &msg->data[msg->header.size], sizeof(time_luos_t));
+        memcpy(&timestamp_date, &msg->data[msg->header.size], TIMESTAMP_SIZE);
         // Keep the message pointer to know if we already manage this one or not.
         last_msg = msg;
     }
     // Compute the latency from date
-    time_luos_t latency = TimeOD_TimeFrom_s(TimeOD_TimeTo_s(timestamp_date) - TimeOD_TimeTo_s(Timestamp_now()));
+    int64_t latency = timestamp_date - ClockSync_GetNetworkTime(LuosHAL_GetTimestamp());
     // Write latency on the message
-    memcpy(&msg->data[msg->header.size], &latency, sizeof(time_luos_t));
+    memcpy(&msg->data[msg->header.size], &latency, TIMESTAMP_SIZE);
 }
 
 /******************************************************************************
@@ -133,11 +160,11 @@ _CRITICAL void Timestamp_ConvertToLatency(msg_t *msg)
  ******************************************************************************/
 _CRITICAL inline void Timestamp_ConvertToDate(msg_t *msg, uint64_t reception_date)
 {
-    time_luos_t timestamp_latency = {0.0f};
+    int64_t timestamp_latency = 0;
     // Get latency
-    memcpy(&timestamp_latency, &msg->data[msg->header.size], sizeof(time_luos_t));
+    memcpy(&timestamp_latency, &msg->data[msg->header.size], TIMESTAMP_SIZE);
     // Compute the date from latency
-    time_luos_t timestamp_date = TimeOD_TimeFrom_ns(TimeOD_TimeTo_ns(timestamp_latency) + reception_date);
+    int64_t timestamp_date = timestamp_latency + ClockSync_GetNetworkTime(reception_date);
     // Write the date on the message
-    memcpy(&msg->data[msg->header.size], &timestamp_date, sizeof(time_luos_t));
+    memcpy(&msg->data[msg->header.size], &timestamp_date, TIMESTAMP_SIZE);
 }
@@ -64,7 +64,7 @@ void AlarmController_Loop(void)
             if (result.result_nbr > 0)
             {
                 msg_t msg;
-                msg.header.target      = result.result_table[0]->id;
+                msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
                 msg.header.target_mode = SERVICEIDACK;
                 time_luos_t time       = TimeOD_TimeFrom_s(0.5f);
                 TimeOD_TimeToMsg(&time, &msg);
@@ -85,7 +85,7 @@ void AlarmController_Loop(void)
                 msg_t msg;
                 msg.header.cmd         = PARAMETERS;
                 msg.header.size        = sizeof(imu_report_t);
-                msg.header.target      = result.result_table[0]->id;
+                msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
                 msg.header.target_mode = SERVICEIDACK;
                 memcpy(msg.data, &report, sizeof(imu_report_t));
                 while (Luos_SendMsg(app, &msg) != SUCCEED)
@@ -125,7 +125,7 @@ void AlarmController_Loop(void)
             if (result.result_nbr > 0)
             {
                 msg_t msg;
-                msg.header.target      = result.result_table[0]->id;
+                msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
                 msg.header.target_mode = SERVICEIDACK;
                 msg.header.cmd         = IO_STATE;
                 msg.header.size        = 1;
@@ -155,7 +155,7 @@ void AlarmController_Loop(void)
                         color.r = LIGHT_INTENSITY;
                     }
                     msg_t msg;
-                    msg.header.target      = result.result_table[0]->id;
+                    msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
                     msg.header.target_mode = SERVICEIDACK;
                     IlluminanceOD_ColorToMsg(&color, &msg);
                     while (Luos_SendMsg(app, &msg) != SUCCEED)
@@ -174,7 +174,7 @@ void AlarmController_Loop(void)
                         horn = 1;
                     }
                     msg_t msg;
-                    msg.header.target      = result.result_table[0]->id;
+                    msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
                     msg.header.target_mode = SERVICEIDACK;
                     msg.header.size        = sizeof(uint8_t);
                     msg.header.cmd         = IO_STATE;
@@ -79,7 +79,7 @@ void BiometricSecurity_Loop(void)
             if (id_btn[i] > 0)
             {
                 msg_t pub_msg;
-                pub_msg.header.target      = result.result_table[i]->id;
+                pub_msg.header.target      = RTFilter_GetEntry(&result, i)->id;
                 pub_msg.header.target_mode = SERVICEIDACK;
                 time_luos_t time           = TimeOD_TimeFrom_ms(UPDATE_PERIOD_MS);
                 TimeOD_TimeToMsg(&time, &pub_msg);
@@ -88,10 +88,10 @@ void BiometricSecurity_Loop(void)
             }
         }
         RTFilter_Type(RTFilter_Reset(&result), LCD_TYPE);
-        if (result.result_table[0]->id > 0)
+        if (RTFilter_GetEntry(&result, 0)->id > 0)
         {
             msg_t pub_msg;
-            pub_msg.header.target      = result.result_table[0]->id;
+            pub_msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
             pub_msg.header.target_mode = SERVICEID;
             pub_msg.header.cmd         = REINIT;
             Luos_SendMsg(app, &pub_msg);
@@ -118,10 +118,10 @@ void BiometricSecurity_MsgHandler(service_t *service, msg_t *msg)
 {
     search_result_t result;
     RTFilter_Type(RTFilter_Reset(&result), STATE_TYPE);
-    if ((msg->header.cmd == IO_STATE) && (result.result_nbr > 0) && (result.result_table[0]->id == msg->header.source))
+    if ((msg->header.cmd == IO_STATE) && (result.result_nbr > 0) && (RTFilter_GetEntry(&result, 0)->id == msg->header.source))
     {
         RTFilter_Alias(RTFilter_Reset(&result), "btn_enroll");
-        if (result.result_table[0]->id == msg->header.source)
+        if (RTFilter_GetEntry(&result, 0)->id == msg->header.source)
         {
             if ((!enroll_last_state) && (enroll_last_state != msg->data[0]))
             {
@@ -133,7 +133,7 @@ void BiometricSecurity_MsgHandler(service_t *service, msg_t *msg)
             enroll_last_state = msg->data[0];
         }
         RTFilter_Alias(RTFilter_Reset(&result), "btn_up");
-        if (result.result_table[0]->id == msg->header.source)
+        if (RTFilter_GetEntry(&result, 0)->id == msg->header.source)
         {
             if ((!up_last_state) && (up_last_state != msg->data[0]))
             {
@@ -146,7 +146,7 @@ void BiometricSecurity_MsgHandler(service_t *service, msg_t *msg)
             up_last_state = msg->data[0];
         }
         RTFilter_Alias(RTFilter_Reset(&result), "btn_down");
-        if (result.result_table[0]->id == msg->header.source)
+        if (RTFilter_GetEntry(&result, 0)->id == msg->header.source)
         {
             if ((!down_last_state) && (down_last_state != msg->data[0]) && (!fingerprint_busy))
             {
@@ -159,7 +159,7 @@ void BiometricSecurity_MsgHandler(service_t *service, msg_t *msg)
             down_last_state = msg->data[0];
         }
         RTFilter_Alias(RTFilter_Reset(&result), "btn_delete");
-        if (result.result_table[0]->id == msg->header.source)
+        if (RTFilter_GetEntry(&result, 0)->id == msg->header.source)
         {
             if ((!delete_last_state) && (delete_last_state != msg->data[0]))
             {
@@ -171,7 +171,7 @@ void BiometricSecurity_MsgHandler(service_t *service, msg_t *msg)
                         msg_t pub_msg;
                         pub_msg.header.target_mode = msg->header.target_mode;
                         pub_msg.header.cmd         = DELETE;
-                        pub_msg.header.target      = result.result_table[0]->id;
+                        pub_msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
                         fingerprint_busy           = 1;
                         BiometricSecurity_LcdPrint("Checking auth..", sizeof("Checking auth..") - 1);
                         Luos_SendMsg(app, &pub_msg);
@@ -186,7 +186,7 @@ void BiometricSecurity_MsgHandler(service_t *service, msg_t *msg)
         }
     }
     RTFilter_Type(RTFilter_Reset(&result), FINGERPRINT_TYPE);
-    if (msg->header.source == result.result_table[0]->id)
+    if (msg->header.source == RTFilter_GetEntry(&result, 0)->id)
     {
         fingerprint_busy = 0;
         switch (msg->header.cmd)
@@ -254,7 +254,7 @@ uint8_t BiometricSecurity_SetServoPosition(void)
     {
         msg_t servo_msg;
         servo_msg.header.target_mode = SERVICEID;
-        servo_msg.header.target      = result.result_table[0]->id;
+        servo_msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
 
         AngularOD_PositionToMsg(&angle, &servo_msg);
         while (Luos_SendMsg(app, &servo_msg) != SUCCEED)
@@ -288,7 +288,7 @@ uint8_t BiometricSecurity_CheckFingerprint(void)
         msg_t fing_msg;
         fing_msg.header.cmd         = CHECK;
         fing_msg.header.target_mode = SERVICEID;
-        fing_msg.header.target      = result.result_table[0]->id;
+        fing_msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
         fingerprint_busy            = 1;
         while (Luos_SendMsg(app, &fing_msg) != SUCCEED)
         {
@@ -319,7 +319,7 @@ uint8_t BiometricSecurity_ControlLed(uint8_t green_state)
     RTFilter_Alias(RTFilter_Reset(&result), "led_green");
     if (result.result_nbr > 0)
     {
-        led_msg.header.target = result.result_table[0]->id;
+        led_msg.header.target = RTFilter_GetEntry(&result, 0)->id;
         led_msg.data[0]       = green_state;
         while (Luos_SendMsg(app, &led_msg) != SUCCEED)
         {
@@ -331,7 +331,7 @@ uint8_t BiometricSecurity_ControlLed(uint8_t green_state)
     RTFilter_Alias(RTFilter_Reset(&result), "led_red");
     if (result.result_nbr > 0)
     {
-        led_msg.header.target = result.result_table[0]->id;
+        led_msg.header.target = RTFilter_GetEntry(&result, 0)->id;
         led_msg.data[0]       = 1 - green_state;
         while (Luos_SendMsg(app, &led_msg) != SUCCEED)
         {
@@ -359,7 +359,7 @@ uint8_t BiometricSecurity_LcdPrint(char *text, uint16_t length)
         txt_msg.header.cmd         = TEXT;
         txt_msg.header.size        = length;
         txt_msg.header.target_mode = ID;
-        txt_msg.header.target      = result.result_table[0]->id;
+        txt_msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
 
         memcpy(txt_msg.data, text, txt_msg.header.size);
 
@@ -73,7 +73,7 @@ void StartController_Loop(void)
             {
 
                 msg_t msg;
-                msg.header.target      = result.result_table[0]->id;
+                msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
                 msg.header.target_mode = SERVICEIDACK;
                 // Setup auto update each UPDATE_PERIOD_MS on button
                 // This value is resetted on all service at each detection
@@ -116,7 +116,7 @@ void StartController_Loop(void)
                 alarm_control.flux = STOP;
             }
             // send message
-            msg.header.target = result.result_table[0]->id;
+            msg.header.target = RTFilter_GetEntry(&result, 0)->id;
             ControlOD_ControlToMsg(&alarm_control, &msg);
             while (Luos_SendMsg(app, &msg) != SUCCEED)
             {
@@ -141,7 +141,7 @@ void StartController_Loop(void)
             {
                 color.b = LIGHT_INTENSITY;
             }
-            msg.header.target = result.result_table[0]->id;
+            msg.header.target = RTFilter_GetEntry(&result, 0)->id;
             IlluminanceOD_ColorToMsg(&color, &msg);
             while (Luos_SendMsg(app, &msg) != SUCCEED)
             {
@@ -152,7 +152,7 @@ void StartController_Loop(void)
         if (result.result_nbr > 0)
         {
             // we get a horn
-            msg.header.target = result.result_table[0]->id;
+            msg.header.target = RTFilter_GetEntry(&result, 0)->id;
             msg.header.size   = sizeof(uint8_t);
             msg.header.cmd    = IO_STATE;
             // turn the horn on/off
@@ -168,7 +168,7 @@ void StartController_Loop(void)
             RTFilter_Alias(RTFilter_Reset(&result), "buzzer_mod");
             if (result.result_nbr > 0)
             {
-                msg.header.target = result.result_table[0]->id;
+                msg.header.target = RTFilter_GetEntry(&result, 0)->id;
                 msg.header.cmd    = IO_STATE;
                 msg.header.size   = 1;
                 msg.data[0]       = 1;
@@ -192,7 +192,7 @@ void StartController_Loop(void)
         if (result.result_nbr > 0)
         {
             // we get a horn
-            msg.header.target = result.result_table[0]->id;
+            msg.header.target = RTFilter_GetEntry(&result, 0)->id;
             msg.header.size   = sizeof(uint8_t);
             msg.header.cmd    = IO_STATE;
             // turn the horn on/off
@@ -226,7 +226,7 @@ void StartController_Loop(void)
                 color.g = LIGHT_INTENSITY;
                 color.b = LIGHT_INTENSITY;
             }
-            msg.header.target = result.result_table[0]->id;
+            msg.header.target = RTFilter_GetEntry(&result, 0)->id;
             IlluminanceOD_ColorToMsg(&color, &msg);
             while (Luos_SendMsg(app, &msg) != SUCCEED)
             {
@@ -250,7 +250,7 @@ static void StartController_MsgHandler(service_t *service, msg_t *msg)
         {
             search_result_t result;
             RTFilter_ID(RTFilter_Reset(&result), msg->header.source);
-            if (result.result_table[0]->type == STATE_TYPE)
+            if (RTFilter_GetEntry(&result, 0)->type == STATE_TYPE)
             {
                 // this is the button reply we have filter it to manage monostability
                 if ((!last_btn_state) & (last_btn_state != msg->data[0]))
@@ -54,7 +54,7 @@ void Button_Loop(void)
     {
         // Now send a message
         msg_t led_msg;
-        led_msg.header.target      = result.result_table[0]->id;
+        led_msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
         led_msg.header.cmd         = IO_STATE;
         led_msg.header.target_mode = SERVICEIDACK;
         led_msg.header.size        = sizeof(char);
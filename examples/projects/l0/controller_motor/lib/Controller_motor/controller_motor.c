@@ -311,8 +311,9 @@ void HAL_SYSTICK_Motor_Callback(void)
     static uint32_t last_rec_systick = 0;
     if (servo_motor.control.rec && ((Luos_GetSystick() - last_rec_systick) >= TimeOD_TimeTo_ms(servo_motor.sampling_period)))
     {
-        // We have to save a sample of current position
-        Stream_PutSample(&servo_motor.measurement, (angular_position_t *)&servo_motor.angular_position, 1);
+        // We have to save a dated sample of current position, allowing to align it with other recordings
+        Stream_SetSamplePeriod(&servo_motor.measurement, servo_motor.sampling_period);
+        Stream_PutTimestampSample(&servo_motor.measurement, (angular_position_t *)&servo_motor.angular_position, 1, Timestamp_now());
         last_rec_systick = Luos_GetSystick();
     }
     // ****** trajectory management *********
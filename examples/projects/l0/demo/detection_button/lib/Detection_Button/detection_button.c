@@ -98,7 +98,7 @@ void Setup_button(void)
     if (result.result_nbr > 0)
     {
         msg_t msg;
-        msg.header.target      = result.result_table[0]->id;
+        msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
         msg.header.target_mode = SERVICEIDACK;
         // Setup auto update each UPDATE_PERIOD_MS on button
         // This value is resetted on all service at each detection
@@ -95,7 +95,7 @@ void LedStripPosition_Loop(void)
                 // This value is resetted on all service at each detection
                 // It's important to setting it each time.
                 msg_t msg;
-                msg.header.target      = result.result_table[0]->id;
+                msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
                 msg.header.target_mode = SERVICEIDACK;
                 time_luos_t time       = TimeOD_TimeFrom_ms(MAX_DISTANCE_UPDATE_MS);
                 TimeOD_TimeToMsg(&time, &msg);
@@ -123,15 +123,15 @@ void LedStripPosition_Loop(void)
             {
                 if (detection_animation)
                 {
-                    detection_animation = detection_display(result.result_table[0]->id);
+                    detection_animation = detection_display(RTFilter_GetEntry(&result, 0)->id);
                 }
                 else if (parameter == DISTANCE_DISPLAY)
                 {
-                    distance_based_display(result.result_table[0]->id);
+                    distance_based_display(RTFilter_GetEntry(&result, 0)->id);
                 }
                 else if (parameter == MOTOR_COPY_DISPLAY)
                 {
-                    motor_copy_display(result.result_table[0]->id);
+                    motor_copy_display(RTFilter_GetEntry(&result, 0)->id);
                 }
             }
             lastframe_time_ms = Luos_GetSystick();
@@ -154,7 +154,7 @@ static void LedStripPosition_MsgHandler(service_t *service, msg_t *msg)
 {
     search_result_t services_list;
     RTFilter_Reset(&services_list);
-    if ((services_list.result_table[msg->header.source]->type == DISTANCE_TYPE)) // && (msg->header.cmd == LINEAR_POSITION))
+    if ((RTFilter_GetEntry(&services_list, msg->header.source)->type == DISTANCE_TYPE)) // && (msg->header.cmd == LINEAR_POSITION))
     {
         if (msg->header.cmd == LINEAR_POSITION)
         {
@@ -168,7 +168,7 @@ static void LedStripPosition_MsgHandler(service_t *service, msg_t *msg)
             return;
         }
     }
-    else if ((msg->header.cmd == GET_CMD) && (services_list.result_table[msg->header.source]->type == RUN_MOTOR))
+    else if ((msg->header.cmd == GET_CMD) && (RTFilter_GetEntry(&services_list, msg->header.source)->type == RUN_MOTOR))
     {
         // motor application asks which position of the led_strip is lightened - respond
         msg_t pub_msg;
@@ -63,7 +63,7 @@ void MotorCopy_Loop(void)
             if (result.result_nbr > 0)
             {
                 msg_t msg;
-                uint8_t ledstrip_id = result.result_table[0]->id;
+                uint8_t ledstrip_id = RTFilter_GetEntry(&result, 0)->id;
                 // Switch the LEDSTRIP_POSITION_APP to copy mode
                 msg.header.target_mode = SERVICEIDACK;
                 msg.header.target      = ledstrip_id;
@@ -80,7 +80,7 @@ void MotorCopy_Loop(void)
                     // Setup auto update each UPDATE_PERIOD_MS on dxl
                     // This value is resetted on all service at each detection
                     // It's important to setting it each time.
-                    msg.header.target      = result.result_table[0]->id;
+                    msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
                     msg.header.target_mode = SERVICEIDACK;
                     time_luos_t time       = TimeOD_TimeFrom_ms(REFRESH_POSITION_MOTOR);
                     TimeOD_TimeToMsg(&time, &msg);
@@ -97,7 +97,7 @@ void MotorCopy_Loop(void)
                         .mode_angular_position = true,
                         .angular_position      = true};
 
-                    msg.header.target      = result.result_table[0]->id;
+                    msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
                     msg.header.cmd         = PARAMETERS;
                     msg.header.target_mode = SERVICEIDACK;
                     msg.header.size        = sizeof(servo_motor_mode_t);
@@ -119,9 +119,9 @@ void MotorCopy_Loop(void)
                 }
                 // find the other motors and configure them
                 RTFilter_Alias(RTFilter_Reset(&result), "servo");
-                for (uint8_t i = 0; i < result.result_nbr; i++)
+                for (uint16_t i = 0; i < result.result_nbr; i++)
                 {
-                    Motor_init(result.result_table[i]->id);
+                    Motor_init(RTFilter_GetEntry(&result, i)->id);
                 }
                 end_detection = false;
             }
@@ -137,9 +137,9 @@ void MotorCopy_EventHandler(service_t *service, msg_t *msg)
         angular_position_t target;
         AngularOD_PositionFromMsg(&target, msg);
         RTFilter_Alias(RTFilter_Reset(&result), "servo");
-        for (uint8_t i = 0; i < result.result_nbr; i++)
+        for (uint16_t i = 0; i < result.result_nbr; i++)
         {
-            motor_set(result.result_table[i]->id, target);
+            motor_set(RTFilter_GetEntry(&result, i)->id, target);
         }
     }
     else if (msg->header.cmd == END_DETECTION)
@@ -227,12 +227,12 @@ static void sort_motors(void)
     RTFilter_Type(RTFilter_Reset(&result), SERVO_MOTOR_TYPE);
     for (motor_found = 0; motor_found < result.result_nbr; motor_found++)
     {
-        motor_table[motor_found] = result.result_table[motor_found]->id;
+        motor_table[motor_found] = RTFilter_GetEntry(&result, motor_found)->id;
     }
     motor_found = result.result_nbr;
-    for (uint8_t i = 0; i < result.result_nbr; i++)
+    for (uint16_t i = 0; i < result.result_nbr; i++)
     {
-        if (strstr(result.result_table[i]->alias, "dxl") != 0)
+        if (strstr(RTFilter_GetEntry(&result, i)->alias, "dxl") != 0)
         {
             position = i + 1;
             break;
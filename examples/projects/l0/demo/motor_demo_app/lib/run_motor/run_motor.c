@@ -125,7 +125,7 @@ void RunMotor_EventHandler(service_t *service, msg_t *msg)
             // This value is resetted on all service at each detection
             // It's important to setting it each time.
             msg_t update_msg;
-            update_msg.header.target      = result.result_table[0]->id;
+            update_msg.header.target      = RTFilter_GetEntry(&result, 0)->id;
             update_msg.header.target_mode = SERVICEIDACK;
             time_luos_t time              = TimeOD_TimeFrom_ms(REFRESH_POSITION_MOTOR);
             TimeOD_TimeToMsg(&time, &update_msg);
@@ -151,7 +151,7 @@ void motor_init(uint8_t motor_target)
     // Do not send motor configuration to dxl
     search_result_t result;
     RTFilter_ID(RTFilter_Reset(&result), motor_target);
-    if (strstr(result.result_table[0]->alias, "dxl") == 0)
+    if (strstr(RTFilter_GetEntry(&result, 0)->alias, "dxl") == 0)
     {
         // Send sensor resolution
         float resolution       = 12.0;
@@ -257,9 +257,9 @@ static void sort_motors(void)
     search_result_t result;
     // Parse routing table to find motors
     RTFilter_Type(RTFilter_Reset(&result), SERVO_MOTOR_TYPE);
-    for (uint8_t i = 0; i < result.result_nbr; i++)
+    for (uint16_t i = 0; i < result.result_nbr; i++)
     {
-        motor_table[i] = result.result_table[i]->id;
+        motor_table[i] = RTFilter_GetEntry(&result, i)->id;
     }
     motor_found = result.result_nbr;
 }
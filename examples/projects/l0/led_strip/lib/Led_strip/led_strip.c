@@ -69,7 +69,7 @@ static void LedStrip_MsgHandler(service_t *service, msg_t *msg)
         else
         {
             // image management
-            Luos_ReceiveData(service, msg, (void *)matrix);
+            Luos_ReceiveData(service, msg, (void *)matrix, sizeof(matrix));
         }
         return;
     }
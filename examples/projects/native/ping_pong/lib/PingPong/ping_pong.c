@@ -157,9 +157,9 @@ bool send_random()
     // Randomize ball position.
     uint8_t r = (rand() % 2) + 1; // Returns a pseudo-random integer between 0 and RAND_MAX.
     // Randomize target
-    search_result_t target_list;
-    RTFilter_Reset(&target_list);
-    RTFilter_Type(&target_list, PLAYER_TYPE);
+    static search_result_t target_list;
+    const rt_filter_t player_filter = {.criteria = FILTER_TYPE, .type = PLAYER_TYPE};
+    RTFilter_Refresh(&target_list, &player_filter);
     if (target_list.result_nbr == 1)
     {
         return false;
@@ -168,11 +168,11 @@ bool send_random()
     do
     {
         target = rand() % target_list.result_nbr;
-    } while (target_list.result_table[target]->id == player->ll_service->id);
+    } while (RTFilter_GetEntry(&target_list, target)->id == player->ll_service->id);
 
     // Our target is OK, Send the message
     msg_t msg;
-    msg.header.target      = target_list.result_table[target]->id;
+    msg.header.target      = RTFilter_GetEntry(&target_list, target)->id;
     msg.header.target_mode = SERVICEIDACK;
     msg.header.size        = sizeof(r);
     msg.header.cmd         = BALL_POS_CMD;
@@ -20,8 +20,8 @@ void score_init(service_t *player, search_result_t *player_list)
     score_table.scores    = scores;
     for (int i = 0; i < score_table.player_nb; i++)
     {
-        scores[i].alias = player_list->result_table[i]->alias;
-        scores[i].id    = player_list->result_table[i]->id;
+        scores[i].alias = RTFilter_GetEntry(player_list, i)->alias;
+        scores[i].id    = RTFilter_GetEntry(player_list, i)->id;
         scores[i].score = 0;
     }
 }
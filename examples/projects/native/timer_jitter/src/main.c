@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <math.h>
+#include "luos_engine.h"
+
+#define BENCH_DURATION_US 5000000
+#define BENCH_JOB_NB      3
+
+typedef struct
+{
+    luos_timer_t timer;
+    uint32_t period_us;
+    uint64_t expected_us; // Date the job should run
+    uint32_t count;
+    uint32_t missed; // Periods skipped because we were too late
+    int64_t min_us;
+    int64_t max_us;
+    double sum_us;
+    double square_sum_us;
+} bench_job_t;
+
+static bench_job_t job[BENCH_JOB_NB] = {
+    {.period_us = 100},
+    {.period_us = 250},
+    {.period_us = 1000},
+};
+
+/******************************************************************************
+ * @brief Measure the time difference between the expected and the real date
+ * @param arg : Job running
+ * @return None
+ ******************************************************************************/
+static void Bench_Job(void *arg)
+{
+    bench_job_t *bench = (bench_job_t *)arg;
+    int64_t jitter     = (int64_t)(TimerWheel_Now() - bench->expected_us);
+
+    if ((bench->count == 0) || (jitter < bench->min_us))
+    {
+        bench->min_us = jitter;
+    }
+    if ((bench->count == 0) || (jitter > bench->max_us))
+    {
+        bench->max_us = jitter;
+    }
+    bench->sum_us += jitter;
+    bench->square_sum_us += (double)jitter * jitter;
+    bench->count++;
+    // The timer is already reloaded with the date of the next run
+    bench->missed += (uint32_t)((bench->timer.expiry - bench->expected_us) / bench->period_us) - 1;
+    bench->expected_us = bench->timer.expiry;
+}
+
+int main(void)
+{
+    uint64_t start_date;
+    double mean;
+
+    Luos_Init();
+    start_date = TimerWheel_Now();
+    for (uint8_t i = 0; i < BENCH_JOB_NB; i++)
+    {
+        TimerWheel_Start(&job[i].timer, job[i].period_us, job[i].period_us, Bench_Job, &job[i]);
+        job[i].expected_us = job[i].timer.expiry;
+    }
+    while (TimerWheel_Now() - start_date < BENCH_DURATION_US)
+    {
+        Luos_Loop();
+    }
+
+    printf("period (us) | runs    | missed | min (us) | mean (us) | max (us) | std dev (us)\n");
+    for (uint8_t i = 0; i < BENCH_JOB_NB; i++)
+    {
+        TimerWheel_Stop(&job[i].timer);
+        mean = job[i].sum_us / job[i].count;
+        printf("%11u | %7u | %6u | %8ld | %9.2f | %8ld | %12.2f\n",
+               job[i].period_us,
+               job[i].count,
+               job[i].missed,
+               (long)job[i].min_us,
+               mean,
+               (long)job[i].max_us,
+               sqrt((job[i].square_sum_us / job[i].count) - (mean * mean)));
+    }
+    return 0;
+}
@@ -30,6 +30,8 @@
 #ifndef WS_BROKER_ADDR
     #define WS_BROKER_ADDR "ws://127.0.0.1:8000"
 #endif
+#define WS_POLL_TIMEOUT 100 // Websocket poll timeout in ms, any socket activity end it before
+#define IDLE_SLEEP      5   // Maximum idle sleep of the loop in ms
 
 // #define WS_PRINT
 
@@ -50,6 +52,7 @@ volatile uint8_t *tx_data = 0;
 // Mongoose connection information
 struct mg_mgr robus_mgr; // Event manager
 struct mg_connection *c; // Client connection
+static int ws_wakeup = -1; // Socket used to wake up the websocket thread
 static const char *s_url   = WS_BROKER_ADDR;
 volatile bool ptpa         = false;
 volatile bool ptpb         = false;
@@ -62,6 +65,7 @@ static void RobusHAL_CRCInit(void);
 static void RobusHAL_TimeoutInit(void);
 static void RobusHAL_GPIOInit(void);
 static void RobusHAL_RegisterPTP(void);
+static void RobusHAL_WakeupWS(void);
 
 /* msleep(): Sleep for the requested number of milliseconds. */
 static int msleep(long msec)
@@ -112,23 +116,49 @@ void RobusHAL_Init(void)
  ******************************************************************************/
 void RobusHAL_Loop(void)
 {
-    // Just sleep to avoid 100% CPU usage and websockets overflows
-    msleep(5);
+    // Sleep to avoid 100% CPU usage and websockets overflows, any network event wake us up.
+    LuosHAL_IdleWait(IDLE_SLEEP);
 }
 
 void *WSrobusThread(void *vargp)
 {
     while (1)
     {
-        msleep(1);
         if (c)
         {
-            mg_mgr_poll(&robus_mgr, 10);
+            // Block until a socket activity, a transmission wake it up through ws_wakeup.
+            mg_mgr_poll(&robus_mgr, WS_POLL_TIMEOUT);
+        }
+        else
+        {
+            msleep(WS_POLL_TIMEOUT);
         }
     }
     return NULL;
 }
 
+// Flush wake up data, the poll will then send pending data
+static void WSwakeup(struct mg_connection *c, int ev, void *ev_data, void *fn_data)
+{
+    if (ev == MG_EV_READ)
+    {
+        c->recv.len = 0;
+    }
+}
+
+/******************************************************************************
+ * @brief Make the websocket thread send the pending data now
+ * @param None
+ * @return None
+ ******************************************************************************/
+static void RobusHAL_WakeupWS(void)
+{
+    if (ws_wakeup >= 0)
+    {
+        send(ws_wakeup, "W", 1, 0);
+    }
+}
+
 // Print websocket response and signal that we're done
 static void fn(struct mg_connection *c, int ev, void *ev_data, void *fn_data)
 {
@@ -192,6 +222,7 @@ static void fn(struct mg_connection *c, int ev, void *ev_data, void *fn_data)
                 }
             }
             ptp_update = true;
+            LuosHAL_SignalEvent();
         }
         else
         {
@@ -216,6 +247,8 @@ static void fn(struct mg_connection *c, int ev, void *ev_data, void *fn_data)
 #endif
             // We consider this information received and acked
             Recep_Timeout();
+            // Wake up the Luos loop to manage it
+            LuosHAL_SignalEvent();
         }
     }
 
@@ -243,6 +276,8 @@ void RobusHAL_ComInit(uint32_t Baudrate)
             mg_mgr_poll(&robus_mgr, 1000);
         }
     }
+    // Create a socket allowing to wake up the websocket thread on transmission
+    ws_wakeup = mg_mkpipe(&robus_mgr, WSwakeup, NULL, true);
     // Create a thread to poll the websocket.
     pthread_t thread_id;
     pthread_create(&thread_id, NULL, WSrobusThread, NULL);
@@ -280,12 +315,14 @@ void RobusHAL_ComTransmit(uint8_t *data, uint16_t size)
         printf("Transmiting %d bytes : %.*s\n\n", size, size, data);
 #endif
         mg_ws_send(c, data, size, WEBSOCKET_OP_BINARY);
+        RobusHAL_WakeupWS();
         // Avoid the need of ack
         ctx.tx.status = TX_OK;
         // Check if ack was needed
         msg_t *current_msg = (msg_t *)data;
         // We consider this information sent
         Recep_Timeout();
+        LuosHAL_SignalEvent();
         // Check if this was a reset detection or a routing table message
         if ((current_msg->header.cmd == START_DETECTION) || (current_msg->header.cmd == LOCAL_RTB))
         {
@@ -391,6 +428,7 @@ void RobusHAL_SetPTPDefaultState(uint8_t PTPNbr)
         if (PTPNbr == 0)
         {
             mg_ws_send(c, "PTPA0", sizeof("PTPA0"), WEBSOCKET_OP_TEXT);
+            RobusHAL_WakeupWS();
             // Wait to avoid message bursts
             start_tick = LuosHAL_GetSystick();
             while (LuosHAL_GetSystick() - start_tick < 1)
@@ -399,6 +437,7 @@ void RobusHAL_SetPTPDefaultState(uint8_t PTPNbr)
         else if (PTPNbr == 1)
         {
             mg_ws_send(c, "PTPB0", sizeof("PTPB0"), WEBSOCKET_OP_TEXT);
+            RobusHAL_WakeupWS();
             // Wait to avoid message bursts
             start_tick = LuosHAL_GetSystick();
             while (LuosHAL_GetSystick() - start_tick < 1)
@@ -442,6 +481,7 @@ uint8_t RobusHAL_GetPTPState(uint8_t PTPNbr)
     {
         // Ask PTPA state to the server
         mg_ws_send(c, "PTPA1", sizeof("PTPA1"), WEBSOCKET_OP_TEXT);
+        RobusHAL_WakeupWS();
         // Wait for the server to acknowledge the PTP update if connected
         if (ws_connected)
         {
@@ -456,6 +496,7 @@ uint8_t RobusHAL_GetPTPState(uint8_t PTPNbr)
     {
         // Ask PTPB state to the server
         mg_ws_send(c, "PTPB1", sizeof("PTPB1"), WEBSOCKET_OP_TEXT);
+        RobusHAL_WakeupWS();
         // Wait for the server to acknowledge the PTP update if connected
         if (ws_connected)
         {
@@ -54,6 +54,26 @@
     #define LAST_TOPIC 20
 #endif
 
+#ifndef MAX_UPDATE_SUBSCRIBER
+    #define MAX_UPDATE_SUBSCRIBER 4 // Services able to ask for auto updates of a service
+#endif
+
+#ifndef UPDATE_TOPIC_NB
+    #define UPDATE_TOPIC_NB 4 // Last topics reserved to publish auto updates to several subscribers
+#endif
+#if (UPDATE_TOPIC_NB >= LAST_TOPIC)
+    #error 'UPDATE_TOPIC_NB' must be lower than 'LAST_TOPIC'
+#endif
+#define FIRST_UPDATE_TOPIC (LAST_TOPIC - UPDATE_TOPIC_NB + 1)
+
+#ifndef MAX_UPDATE_TOPIC_SOURCE
+    #define MAX_UPDATE_TOPIC_SOURCE (2 * MAX_SERVICE_NUMBER) // Services of this node able to receive auto updates by topic
+#endif
+
+#ifndef PRIORITY_STARVATION_LIMIT
+    #define PRIORITY_STARVATION_LIMIT 8 // Messages dispatched ahead of the oldest one before it is dispatched anyway
+#endif
+
 // Tab of byte. + 2 for overlap ID because aligned to byte
 #define ID_MASK_SIZE    ((MAX_SERVICE_NUMBER / 8) + 2)
 #define TOPIC_MASK_SIZE ((LAST_TOPIC / 8) + 2)
@@ -48,14 +48,17 @@ void MsgAlloc_LuosTaskAlloc(ll_service_t *service_concerned_by_current_msg, msg_
 error_return_t MsgAlloc_PullMsg(ll_service_t *target_service, msg_t **returned_msg);
 error_return_t MsgAlloc_PullMsgFromLuosTask(uint16_t luos_task_id, msg_t **returned_msg);
 error_return_t MsgAlloc_LookAtLuosTask(uint16_t luos_task_id, ll_service_t **allocated_service);
+error_return_t MsgAlloc_PeekLuosTask(uint16_t luos_task_id, ll_service_t **allocated_service, uint8_t *cmd, uint16_t *size);
 error_return_t MsgAlloc_GetLuosTaskSourceId(uint16_t luos_task_id, uint16_t *source_id);
 error_return_t MsgAlloc_GetLuosTaskCmd(uint16_t luos_task_id, uint8_t *cmd);
 error_return_t MsgAlloc_GetLuosTaskSize(uint16_t luos_task_id, uint16_t *size);
 uint16_t MsgAlloc_LuosTasksNbr(void);
+uint16_t MsgAlloc_MsgToInterpretNbr(void);
 void MsgAlloc_ClearMsgFromLuosTasks(msg_t *msg);
 
 // Tx tasks create, get and consume
 error_return_t MsgAlloc_SetTxTask(ll_service_t *ll_service_pt, uint8_t *data, uint16_t crc, uint16_t size, luos_localhost_t localhost, uint8_t ack);
+error_return_t MsgAlloc_SetTxTaskPayload(ll_service_t *ll_service_pt, uint8_t *data, uint8_t *payload, uint16_t payload_size, uint16_t crc, uint16_t size, luos_localhost_t localhost, uint8_t ack);
 void MsgAlloc_PullMsgFromTxTask(void);
 void MsgAlloc_PullServiceFromTxTask(uint16_t service_id);
 error_return_t MsgAlloc_GetTxTask(ll_service_t **ll_service_pt, uint8_t **data, uint16_t *size, uint8_t *localhost);
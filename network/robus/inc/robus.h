@@ -34,6 +34,7 @@ ll_service_t *Robus_ServiceCreate(uint16_t type);
 void Robus_ServicesClear(void);
 error_return_t Robus_SetTxTask(ll_service_t *ll_service, msg_t *msg);
 error_return_t Robus_SendMsg(ll_service_t *ll_service, msg_t *msg);
+error_return_t Robus_SendMsgPayload(ll_service_t *ll_service, msg_t *msg, uint8_t *payload, uint16_t payload_size);
 uint16_t Robus_TopologyDetection(ll_service_t *ll_service);
 node_t *Robus_GetNode(void);
 void Robus_IDMaskCalculation(uint16_t service_id, uint16_t service_number);
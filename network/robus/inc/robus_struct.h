@@ -113,6 +113,9 @@ typedef struct __attribute__((__packed__))
 
     // variable stat on robus com for ll_service
     ll_stats_t ll_stat;
+
+    // Link to the upper layer service
+    void *upper_service; /*!< Pointer to the service using this ll_service. */
 } ll_service_t;
 
 /******************************************************************************
@@ -166,6 +169,7 @@ typedef enum
     // Protocol version
     BASE_PROTOCOL = PROTOCOL_REVISION,
     TIMESTAMP_PROTOCOL,
+    BULK_PROTOCOL, // Data chunk starting with the 32 bits size left to receive
 } robus_protocol_t;
 
 typedef void (*RX_CB)(ll_service_t *ll_service, msg_t *msg);
@@ -125,6 +125,9 @@ _CRITICAL static inline void MsgAlloc_ClearLuosTask(uint16_t luos_task_id);
 // Available buffer space evaluation
 static inline uint32_t MsgAlloc_BufferAvailableSpaceComputation(void);
 
+// Tx data copy
+static inline void MsgAlloc_CopyTxData(uint8_t *tx_msg, uint8_t *data, uint8_t *payload, uint16_t payload_size, uint16_t data_size);
+
 // Check if this message is the oldest
 _CRITICAL static inline void MsgAlloc_OldestMsgCandidate(msg_t *oldest_stack_msg_pt);
 
@@ -816,6 +819,25 @@ static inline error_return_t MsgAlloc_CheckMsgSpace(void *from, void *to)
     }
     return SUCCEED;
 }
+/******************************************************************************
+ * @brief Copy the data of a message to transmit after its header
+ * @param tx_msg : message in msg_buffer
+ * @param data : message to transmit
+ * @param payload : first bytes of the data
+ * @param payload_size : number of bytes of the payload
+ * @param data_size : number of bytes to copy after the header
+ * @return None
+ ******************************************************************************/
+static inline void MsgAlloc_CopyTxData(uint8_t *tx_msg, uint8_t *data, uint8_t *payload, uint16_t payload_size, uint16_t data_size)
+{
+    if (payload_size > data_size)
+    {
+        payload_size = data_size;
+    }
+    memcpy(&tx_msg[sizeof(header_t)], payload, payload_size);
+    // The end of the data (timestamp...) stays in the message
+    memcpy(&tx_msg[sizeof(header_t) + payload_size], &data[sizeof(header_t) + payload_size], data_size - payload_size);
+}
 /*******************************************************************************
  * Functions --> msg interpretation task stack
  ******************************************************************************/
@@ -1173,6 +1195,31 @@ error_return_t MsgAlloc_LookAtLuosTask(uint16_t luos_task_id, ll_service_t **all
     MSGALLOC_MUTEX_UNLOCK
     return FAILED;
 }
+/******************************************************************************
+ * @brief get back the service, the command and the size of a slot in one shot
+ * @param luos_task_id : Id of the allocator slot
+ * @param allocated_service : Return the service concerned by the message
+ * @param cmd : The pointer filled with the cmd value.
+ * @param size : The pointer filled with the size value.
+ * @return error_return_t : Fail is there is no more message available.
+ ******************************************************************************/
+error_return_t MsgAlloc_PeekLuosTask(uint16_t luos_task_id, ll_service_t **allocated_service, uint8_t *cmd, uint16_t *size)
+{
+    MsgAlloc_ValidDataIntegrity();
+    // Same as MsgAlloc_LookAtLuosTask, MsgAlloc_GetLuosTaskCmd and MsgAlloc_GetLuosTaskSize
+    // with a single bound check and a single critical section.
+    MSGALLOC_MUTEX_LOCK
+    if (luos_task_id < luos_tasks_stack_id)
+    {
+        *allocated_service = luos_tasks[luos_task_id].ll_service_pt;
+        *cmd               = luos_tasks[luos_task_id].msg_pt->header.cmd;
+        *size              = luos_tasks[luos_task_id].msg_pt->header.size;
+        MSGALLOC_MUTEX_UNLOCK
+        return SUCCEED;
+    }
+    MSGALLOC_MUTEX_UNLOCK
+    return FAILED;
+}
 /******************************************************************************
  * @brief get back a specific slot message command
  * @param luos_task_id : Id of the allocator slot
@@ -1314,6 +1361,15 @@ uint16_t MsgAlloc_LuosTasksNbr(void)
 {
     return (uint16_t)luos_tasks_stack_id;
 }
+/******************************************************************************
+ * @brief return the number of received messages not interpreted yet
+ * @param None
+ * @return the number of messages
+ ******************************************************************************/
+uint16_t MsgAlloc_MsgToInterpretNbr(void)
+{
+    return (uint16_t)msg_tasks_stack_id;
+}
 /******************************************************************************
  * @brief Clear a specific message in Luos Tasks
  * @param None
@@ -1387,7 +1443,22 @@ void MsgAlloc_ClearMsgFromLuosTasks(msg_t *msg)
  ******************************************************************************/
 error_return_t MsgAlloc_SetTxTask(ll_service_t *ll_service_pt, uint8_t *data, uint16_t crc, uint16_t size, luos_localhost_t localhost, uint8_t ack)
 {
-    LUOS_ASSERT((tx_tasks_stack_id >= 0) && (tx_tasks_stack_id < MAX_MSG_NB) && ((uintptr_t)data > 0) && ((uintptr_t)current_msg < (uintptr_t)&msg_buffer[MSG_BUFFER_SIZE]) && ((uintptr_t)current_msg >= (uintptr_t)&msg_buffer[0]));
+    return MsgAlloc_SetTxTaskPayload(ll_service_pt, data, &data[sizeof(header_t)], size, crc, size, localhost, ack);
+}
+/******************************************************************************
+ * @brief copy a header and its payload into msg_buffer and create a Tx task
+ * The payload don't have to follow the header, allowing to send data directly
+ * from where they are with a single copy. The data following the payload are
+ * taken from the message to transmit.
+ * @param data header to transmit
+ * @param payload to transmit after the header
+ * @param payload_size number of bytes of the payload
+ * @param size of the message to transmit
+ * @return None
+ ******************************************************************************/
+error_return_t MsgAlloc_SetTxTaskPayload(ll_service_t *ll_service_pt, uint8_t *data, uint8_t *payload, uint16_t payload_size, uint16_t crc, uint16_t size, luos_localhost_t localhost, uint8_t ack)
+{
+    LUOS_ASSERT((tx_tasks_stack_id >= 0) && (tx_tasks_stack_id < MAX_MSG_NB) && ((uintptr_t)data > 0) && ((uintptr_t)payload > 0) && ((uintptr_t)current_msg < (uintptr_t)&msg_buffer[MSG_BUFFER_SIZE]) && ((uintptr_t)current_msg >= (uintptr_t)&msg_buffer[0]));
     void *rx_msg_bkp          = 0;
     void *tx_msg              = 0;
     uint16_t progression_size = 0;
@@ -1677,7 +1748,8 @@ error_return_t MsgAlloc_SetTxTask(ll_service_t *ll_service_pt, uint8_t *data, ui
         //
         // Finish the copy of the message to transmit
         LuosHAL_SetIrqState(false);
-        memcpy((void *)&((char *)tx_msg)[3], (void *)&data[3], size - 6); // 3 bytes already copied - 2 bytes CRC - 1 byte ack
+        memcpy((void *)&((char *)tx_msg)[3], (void *)&data[3], sizeof(header_t) - 3); // 3 bytes already copied
+        MsgAlloc_CopyTxData((uint8_t *)tx_msg, data, payload, payload_size, size - sizeof(header_t) - 3); // - 2 bytes CRC - 1 byte ack
         LuosHAL_SetIrqState(true);
         ((char *)tx_msg)[size - 3] = (uint8_t)(crc);
         ((char *)tx_msg)[size - 2] = (uint8_t)(crc >> 8);
@@ -1693,7 +1765,8 @@ error_return_t MsgAlloc_SetTxTask(ll_service_t *ll_service_pt, uint8_t *data, ui
         //                                     tx_msg
         //
         // Finish the copy of the message to transmit
-        memcpy((void *)&((char *)tx_msg)[3], (void *)&data[3], size - 5); // 3 bytes already copied - 2 bytes CRC
+        memcpy((void *)&((char *)tx_msg)[3], (void *)&data[3], sizeof(header_t) - 3); // 3 bytes already copied
+        MsgAlloc_CopyTxData((uint8_t *)tx_msg, data, payload, payload_size, size - sizeof(header_t) - 2); // - 2 bytes CRC
         ((char *)tx_msg)[size - 2] = (uint8_t)(crc);
         ((char *)tx_msg)[size - 1] = (uint8_t)(crc >> 8);
     }
@@ -152,7 +152,7 @@ _CRITICAL void Recep_GetHeader(volatile uint8_t *data)
                 // we need to check if we have a timestamped message and increase the data size if yes
                 if (Timestamp_IsTimestampMsg((msg_t *)current_msg) == true)
                 {
-                    data_size += sizeof(time_luos_t);
+                    data_size += TIMESTAMP_SIZE;
                 }
             }
 
@@ -18,6 +18,7 @@
 #include "msg_alloc.h"
 #include "luos_utils.h"
 #include "timestamp.h"
+#include "profiler.h"
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
@@ -41,6 +42,7 @@ static error_return_t Robus_MsgHandler(msg_t *input);
 static error_return_t Robus_DetectNextNodes(ll_service_t *ll_service);
 static error_return_t Robus_ResetNetworkDetection(ll_service_t *ll_service);
 static void Robus_RunNetworkTimeout(void);
+static error_return_t Robus_SetTxTaskPayload(ll_service_t *ll_service, msg_t *msg, uint8_t *payload, uint16_t payload_size);
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -126,11 +128,16 @@ void Robus_MaskInit(void)
  ******************************************************************************/
 void Robus_Loop(void)
 {
+    uint64_t start_date = Profiler_Start();
     // Network timeout management
     Robus_RunNetworkTimeout();
+    Profiler_Record(PROFILER_ROBUS_TIMEOUT, 0, start_date);
     // Execute message allocation tasks
+    start_date = Profiler_Start();
     MsgAlloc_loop();
+    Profiler_Record(PROFILER_ROBUS_MSG_ALLOC, 0, start_date);
     // Interpreat received messages and create luos task for it.
+    start_date = Profiler_Start();
     msg_t *msg = NULL;
     while (MsgAlloc_PullMsgToInterpret(&msg) == SUCCEED)
     {
@@ -141,7 +148,10 @@ void Robus_Loop(void)
             Recep_InterpretMsgProtocol(msg);
         }
     }
+    Profiler_Record(PROFILER_ROBUS_INTERPRET, 0, start_date);
+    start_date = Profiler_Start();
     RobusHAL_Loop();
+    Profiler_Record(PROFILER_ROBUS_HAL, 0, start_date);
 }
 /******************************************************************************
  * @brief create a service add in local route table
@@ -164,6 +174,8 @@ ll_service_t *Robus_ServiceCreate(uint16_t type)
     {
         ctx.ll_service_table[ctx.ll_service_number].topic_list[i] = 0;
     }
+    // No upper layer service linked yet
+    ctx.ll_service_table[ctx.ll_service_number].upper_service = 0;
     // Return the freshly initialized ll_service pointer.
     return (ll_service_t *)&ctx.ll_service_table[ctx.ll_service_number++];
 }
@@ -186,6 +198,18 @@ void Robus_ServicesClear(void)
  * @return error_return_t
  ******************************************************************************/
 error_return_t Robus_SetTxTask(ll_service_t *ll_service, msg_t *msg)
+{
+    return Robus_SetTxTaskPayload(ll_service, msg, msg->data, msg->header.size);
+}
+/******************************************************************************
+ * @brief Formalize message with a payload stored outside of it, Set tx task and send
+ * @param service to send
+ * @param msg header to send, with the data following the payload
+ * @param payload to send with the header
+ * @param payload_size number of bytes of the payload, the first ones of the data
+ * @return error_return_t
+ ******************************************************************************/
+static error_return_t Robus_SetTxTaskPayload(ll_service_t *ll_service, msg_t *msg, uint8_t *payload, uint16_t payload_size)
 {
     error_return_t error = SUCCEED;
     uint8_t ack          = 0;
@@ -211,14 +235,19 @@ error_return_t Robus_SetTxTask(ll_service_t *ll_service, msg_t *msg)
     // Add the CRC to the total size of the message
     uint16_t full_size = sizeof(header_t) + data_size + CRC_SIZE;
 
-    uint16_t crc_max_index = full_size;
-
     if (Timestamp_IsTimestampMsg(msg) == true)
     {
-        full_size += sizeof(time_luos_t);
+        // The timestamp follows the data into the message
+        full_size += TIMESTAMP_SIZE;
+    }
+    if (payload_size > data_size)
+    {
+        payload_size = data_size;
     }
     // Compute the CRC
-    crc_val = ll_crc_compute(&msg->stream[0], crc_max_index - CRC_SIZE, 0xFFFF);
+    crc_val = ll_crc_compute(&msg->stream[0], sizeof(header_t), 0xFFFF);
+    crc_val = ll_crc_compute(payload, payload_size, crc_val);
+    crc_val = ll_crc_compute(&msg->data[payload_size], data_size - payload_size, crc_val);
 
     // Check the localhost situation
     luos_localhost_t localhost = Recep_NodeConcerned(&msg->header);
@@ -231,7 +260,7 @@ error_return_t Robus_SetTxTask(ll_service_t *ll_service, msg_t *msg)
     }
 
     // ********** Allocate the message ********************
-    if (MsgAlloc_SetTxTask(ll_service, (uint8_t *)msg->stream, crc_val, full_size, localhost, ack) == FAILED)
+    if (MsgAlloc_SetTxTaskPayload(ll_service, (uint8_t *)msg->stream, payload, payload_size, crc_val, full_size, localhost, ack) == FAILED)
     {
         error = FAILED;
     }
@@ -253,6 +282,19 @@ error_return_t Robus_SetTxTask(ll_service_t *ll_service, msg_t *msg)
  * @return none
  ******************************************************************************/
 error_return_t Robus_SendMsg(ll_service_t *ll_service, msg_t *msg)
+{
+    return Robus_SendMsgPayload(ll_service, msg, msg->data, msg->header.size);
+}
+/******************************************************************************
+ * @brief Send Msg to a service with a payload stored outside of the message
+ * The payload is copied once, directly into the message buffer.
+ * @param service to send
+ * @param msg header to send, with the data following the payload
+ * @param payload to send, header.size bytes or MAX_DATA_MSG_SIZE if bigger
+ * @param payload_size number of bytes of the payload, the first ones of the data
+ * @return none
+ ******************************************************************************/
+error_return_t Robus_SendMsgPayload(ll_service_t *ll_service, msg_t *msg, uint8_t *payload, uint16_t payload_size)
 {
     // ********** Prepare the message ********************
     if (ll_service->id != 0)
@@ -263,7 +305,7 @@ error_return_t Robus_SendMsg(ll_service_t *ll_service, msg_t *msg)
     {
         msg->header.source = ctx.node.node_id;
     }
-    if (Robus_SetTxTask(ll_service, msg) == FAILED)
+    if (Robus_SetTxTaskPayload(ll_service, msg, payload, payload_size) == FAILED)
     {
         return FAILED;
     }
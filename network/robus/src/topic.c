@@ -70,7 +70,7 @@ error_return_t Topic_Unsubscribe(ll_service_t *ll_service, uint16_t topic_id)
             {
                 return FAILED;
             }
-            memcpy(&ll_service->topic_list[i], &ll_service->topic_list[i + 1], ll_service->last_topic_position - i);
+            memmove(&ll_service->topic_list[i], &ll_service->topic_list[i + 1], (ll_service->last_topic_position - i - 1) * sizeof(uint16_t));
             ll_service->last_topic_position--;
             return SUCCEED;
         }
@@ -173,7 +173,7 @@ _CRITICAL void Transmit_Process()
 
                 // Complete the CRC computation with the latency
                 msg_t *msg                       = (msg_t *)data;
-                uint16_t full_size               = sizeof(header_t) + msg->header.size + sizeof(time_luos_t) + CRC_SIZE;
+                uint16_t full_size               = sizeof(header_t) + msg->header.size + TIMESTAMP_SIZE + CRC_SIZE;
                 uint16_t index_without_timestamp = sizeof(header_t) + msg->header.size;
                 uint16_t crc_seed                = 0;
                 memcpy(&crc_seed, &msg->stream[full_size - CRC_SIZE], CRC_SIZE);
@@ -65,18 +65,25 @@ sources = ["+<*.c>",
 find_HAL = False
 env.Replace(SRC_FILTER=sources)
 envdefs = env['CPPDEFINES'].copy()
+# ROBUSHAL allows to use another HAL for Robus, the STUB one to test the NATIVE Luos HAL for example
+robus_HAL = None
+for item in envdefs:
+    if (isinstance(item, tuple) and item[0] == "ROBUSHAL"):
+        robus_HAL = item[1]
 for item in envdefs:
     if (isinstance(item, tuple) and item[0] == "LUOSHAL") and (find_HAL == False):
         find_HAL = True
-        if (path.exists("network/robus/HAL/" + item[1]) and path.exists("engine/HAL/" + item[1])):
+        if (robus_HAL == None):
+            robus_HAL = item[1]
+        if (path.exists("network/robus/HAL/" + robus_HAL) and path.exists("engine/HAL/" + item[1])):
             if not visited_key in global_env:
                 click.secho(
-                    "\t* %s HAL selected for Luos and Robus." % item[1], fg="green")
+                    "\t* %s HAL selected for Luos and %s HAL for Robus." % (item[1], robus_HAL), fg="green")
                 luos_telemetry["luos_hal"] = item[1]
-                if (path.exists("network/robus/HAL/" + item[1] + "/hal_script.py")):
+                if (path.exists("network/robus/HAL/" + robus_HAL + "/hal_script.py")):
                     # This is an extra script dedicated to this HAL, run it
                     hal_script_path = realpath(
-                        "network/robus/HAL/" + item[1] + "/hal_script.py")
+                        "network/robus/HAL/" + robus_HAL + "/hal_script.py")
                     env.SConscript(hal_script_path, exports="env")
                 if (path.exists("engine/HAL/" + item[1] + "/hal_script.py")):
                     # This is an extra script dedicated to this HAL, run it
@@ -87,10 +94,10 @@ for item in envdefs:
             if not visited_key in global_env:
                 click.secho("\t* %s HAL not found" % item[1], fg="red")
                 luos_telemetry["luos_hal"] = "invalid" + str(item[1])
-        env.Append(CPPPATH=[realpath("network/robus/HAL/" + item[1])])
+        env.Append(CPPPATH=[realpath("network/robus/HAL/" + robus_HAL)])
         env.Append(CPPPATH=[realpath("engine/HAL/" + item[1])])
         env.Append(
-            SRC_FILTER=["+<../../../network/robus/HAL/%s/*.c>" % item[1]])
+            SRC_FILTER=["+<../../../network/robus/HAL/%s/*.c>" % robus_HAL])
         env.Append(SRC_FILTER=["+<../../HAL/%s/*.c>" % item[1]])
     if (item == 'NOTELEMETRY'):
         telemetry = False
@@ -4,7 +4,11 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
-#include "../../../.pio/libdeps/native/Unity/src/unity.h"
+#ifdef LUOS_WORKER_NB
+    #include "../../../.pio/libdeps/native_worker/Unity/src/unity.h"
+#else
+    #include "../../../.pio/libdeps/native/Unity/src/unity.h"
+#endif
 #include "luos_hal.h"
 #include "robus_hal.h"
 #include "luos_engine.h"
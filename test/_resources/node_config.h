@@ -43,6 +43,7 @@
 #define MAX_SERVICE_NUMBER 25
 #define MSG_BUFFER_SIZE    25 * sizeof(msg_t)
 #define MAX_MSG_NB         100
+#define MAX_RTB_RESULT     1000
 
 /*******************************************************************************
  * LUOS HAL LIBRARY DEFINITION
@@ -0,0 +1,126 @@
+#include "main.h"
+#include <stdio.h>
+#include <default_scenario.h>
+#include "_timestamp.h"
+
+extern default_scenario_t default_sc;
+
+static void WaitNs(uint64_t duration_ns)
+{
+    uint64_t start_date = LuosHAL_GetTimestamp();
+    while ((LuosHAL_GetTimestamp() - start_date) < duration_ns)
+        ;
+}
+
+void unittest_ClockSync_Model()
+{
+    NEW_TEST_CASE("Follow the network time of the master");
+    {
+        clock_sync_quality_t quality;
+        uint64_t local_date;
+        int64_t date_ns;
+        //  Init default scenario context
+        Init_Context();
+        ClockSync_Init();
+
+        NEW_STEP("Verify that the local time is used before any sync frame");
+        local_date = LuosHAL_GetTimestamp();
+        TEST_ASSERT_TRUE(ClockSync_GetNetworkTime(local_date) == (int64_t)local_date);
+        ClockSync_GetQuality(&quality);
+        TEST_ASSERT_FALSE(quality.synced);
+        TEST_ASSERT_FALSE(quality.master);
+
+        NEW_STEP("Verify that the first sync frame gives the offset");
+        ClockSync_Receive(1, 5000000);
+        local_date = LuosHAL_GetTimestamp();
+        TEST_ASSERT_TRUE(ClockSync_GetNetworkTime(local_date) == ((int64_t)local_date - 5000000));
+        ClockSync_GetQuality(&quality);
+        TEST_ASSERT_TRUE(quality.synced);
+        TEST_ASSERT_EQUAL(1, quality.sync_nb);
+        TEST_ASSERT_EQUAL(0, quality.drift_ppb);
+
+        NEW_STEP("Verify that a sync frame given to several services is used once");
+        ClockSync_Receive(1, 5000000);
+        ClockSync_GetQuality(&quality);
+        TEST_ASSERT_EQUAL(1, quality.sync_nb);
+        TEST_ASSERT_TRUE(quality.offset_ns == 5000000);
+
+        NEW_STEP("Verify that the drift is estimated from the error accumulated between sync frames");
+        WaitNs(10000000);
+        ClockSync_Receive(2, 1000);
+        ClockSync_GetQuality(&quality);
+        TEST_ASSERT_EQUAL(2, quality.sync_nb);
+        TEST_ASSERT_TRUE(quality.error_ns == 1000);
+        TEST_ASSERT_TRUE((quality.drift_ppb > 0) && (quality.drift_ppb <= 50000));
+        TEST_ASSERT_TRUE(quality.offset_ns >= 5001000);
+
+        NEW_STEP("Verify that an update keeps the network time");
+        local_date = LuosHAL_GetTimestamp();
+        date_ns    = ClockSync_GetNetworkTime(local_date);
+        WaitNs(10000000);
+        ClockSync_Update();
+        TEST_ASSERT_TRUE((ClockSync_GetNetworkTime(local_date) - date_ns) <= 1);
+        TEST_ASSERT_TRUE((ClockSync_GetNetworkTime(local_date) - date_ns) >= -1);
+
+        NEW_STEP("Verify that missing sync frames are counted");
+        ClockSync_Receive(4, 0);
+        ClockSync_GetQuality(&quality);
+        TEST_ASSERT_EQUAL(1, quality.lost_nb);
+
+        NEW_STEP("Verify that a too big error restarts the synchronisation");
+        ClockSync_Receive(5, 2 * CLOCK_SYNC_RESET_NS);
+        ClockSync_GetQuality(&quality);
+        TEST_ASSERT_EQUAL(0, quality.drift_ppb);
+        TEST_ASSERT_EQUAL(0, quality.lost_nb);
+
+        NEW_STEP("Verify that the master ignores sync frames");
+        ClockSync_SetMaster(true);
+        ClockSync_Receive(6, 5000000);
+        local_date = LuosHAL_GetTimestamp();
+        TEST_ASSERT_TRUE(ClockSync_GetNetworkTime(local_date) == (int64_t)local_date);
+        ClockSync_GetQuality(&quality);
+        TEST_ASSERT_TRUE(quality.master);
+        TEST_ASSERT_EQUAL(0, quality.sync_nb);
+        ClockSync_Init();
+    }
+}
+
+void unittest_ClockSync_Frame()
+{
+    NEW_TEST_CASE("Measure the network time error with a sync frame");
+    {
+        msg_t sync_msg;
+        uint64_t reception_date;
+        int64_t error_ns;
+        //  Init default scenario context
+        Init_Context();
+        ClockSync_Init();
+        sync_msg.header.cmd  = CLOCK_SYNC;
+        sync_msg.header.size = sizeof(uint16_t);
+
+        NEW_STEP("Verify that a frame received with a clock 3ms ahead measures a 3ms error");
+        Timestamp_EncodeMsg(&sync_msg, TimeOD_TimeFrom_ns(0.0));
+        Timestamp_ConvertToLatency(&sync_msg);
+        reception_date = LuosHAL_GetTimestamp() + 3000000;
+        Timestamp_ConvertToDate(&sync_msg, reception_date);
+        error_ns = Timestamp_GetTimestampNs(&sync_msg);
+        TEST_ASSERT_TRUE((error_ns >= 3000000) && (error_ns < 3500000));
+
+        NEW_STEP("Verify that the corrected network time matches the master one");
+        ClockSync_Receive(1, error_ns);
+        TEST_ASSERT_TRUE(ClockSync_GetNetworkTime(reception_date) <= (int64_t)(reception_date - 3000000));
+        TEST_ASSERT_TRUE(ClockSync_GetNetworkTime(reception_date) > (int64_t)(reception_date - 3500000));
+        ClockSync_Init();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    // Clock synchronisation functions
+    UNIT_TEST_RUN(unittest_ClockSync_Model);
+    UNIT_TEST_RUN(unittest_ClockSync_Frame);
+
+    UNITY_END();
+}
@@ -0,0 +1,8 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+// Clock synchronisation functions
+void unittest_ClockSync_Model(void);
+void unittest_ClockSync_Frame(void);
+
+#endif // MAIN_H
@@ -1,6 +1,8 @@
 #include "main.h"
 #include <stdio.h>
+#include <math.h>
 #include <default_scenario.h>
+#include "topic.h"
 #define STREAM_BUFFER_SIZE 1024
 
 extern default_scenario_t default_sc;
@@ -123,6 +125,477 @@ void unittest_Streaming_SendStreamingSize()
     }
 }
 
+static streaming_channel_t rx_stream;
+
+static void StreamingHandler(service_t *service, msg_t *msg)
+{
+    if (msg->header.cmd == DEFAULT_CMD)
+    {
+        Luos_ReceiveStreaming(service, msg, &rx_stream);
+    }
+}
+
+void unittest_Streaming_SendStreamingSlices()
+{
+    NEW_TEST_CASE("Send samples looping in the ring buffer");
+    {
+        uint16_t tx_buffer[200] = {0};
+        uint16_t rx_buffer[256] = {0};
+        uint16_t samples[190]   = {0};
+        msg_t tx_msg;
+        tx_msg.header.target      = 2;
+        tx_msg.header.target_mode = SERVICEIDACK;
+        tx_msg.header.cmd         = DEFAULT_CMD;
+        streaming_channel_t tx_stream;
+
+        //  Init default scenario context
+        Init_Context();
+        default_sc.App_2.app->service_cb = StreamingHandler;
+        tx_stream                        = Stream_CreateStreamingChannel(tx_buffer, 200, sizeof(uint16_t));
+        rx_stream                        = Stream_CreateStreamingChannel(rx_buffer, 256, sizeof(uint16_t));
+        for (uint16_t i = 0; i < 190; i++)
+        {
+            samples[i] = i;
+        }
+        // Move the samples at the end of the ring buffer
+        Stream_AddAvailableSampleNB(&tx_stream, 150);
+        Stream_RmvAvailableSampleNB(&tx_stream, 150);
+        Stream_PutSample(&tx_stream, samples, 190);
+
+        NEW_STEP("Verify that all the samples are received in order");
+        Luos_SendStreaming(default_sc.App_1.app, &tx_msg, &tx_stream);
+        TEST_ASSERT_EQUAL(0, Stream_GetAvailableSampleNB(&tx_stream));
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(190, Stream_GetAvailableSampleNB(&rx_stream));
+        memset(samples, 0, sizeof(samples));
+        Stream_GetSample(&rx_stream, samples, 190);
+        for (uint16_t i = 0; i < 190; i++)
+        {
+            TEST_ASSERT_EQUAL(i, samples[i]);
+        }
+    }
+}
+
+void unittest_Streaming_SendTimestampStreaming()
+{
+    NEW_TEST_CASE("Send dated samples of a timed channel");
+    {
+        uint16_t tx_buffer[200] = {0};
+        uint16_t rx_buffer[256] = {0};
+        uint16_t samples[150]   = {0};
+        time_luos_t date        = TimeOD_TimeFrom_s(TimeOD_TimeTo_s(Timestamp_now()) + 1.0);
+        time_luos_t period      = TimeOD_TimeFrom_ms(1.0);
+        msg_t tx_msg;
+        tx_msg.header.target      = 2;
+        tx_msg.header.target_mode = SERVICEIDACK;
+        tx_msg.header.cmd         = DEFAULT_CMD;
+        streaming_channel_t tx_stream;
+
+        //  Init default scenario context
+        Init_Context();
+        default_sc.App_2.app->service_cb = StreamingHandler;
+        tx_stream                        = Stream_CreateStreamingChannel(tx_buffer, 200, sizeof(uint16_t));
+        rx_stream                        = Stream_CreateStreamingChannel(rx_buffer, 256, sizeof(uint16_t));
+        for (uint16_t i = 0; i < 150; i++)
+        {
+            samples[i] = i;
+        }
+        Stream_SetSamplePeriod(&tx_stream, period);
+        Stream_PutTimestampSample(&tx_stream, samples, 100, date);
+        Stream_PutTimestampSample(&tx_stream, &samples[100], 50, TimeOD_TimeFrom_s(TimeOD_TimeTo_s(date) + (100 * TimeOD_TimeTo_s(period))));
+
+        NEW_STEP("Verify that the sender computes the date of each sample");
+        TEST_ASSERT_TRUE(fabs(TimeOD_TimeTo_s(Stream_GetSampleDate(&tx_stream, 0)) - TimeOD_TimeTo_s(date)) < 0.000001);
+        Stream_GetSample(&tx_stream, samples, 10);
+        TEST_ASSERT_TRUE(fabs(TimeOD_TimeTo_s(Stream_GetSampleDate(&tx_stream, 0)) - (TimeOD_TimeTo_s(date) + 0.010)) < 0.000001);
+
+        NEW_STEP("Verify that the receiver gets all the samples with their dates");
+        Luos_SendStreaming(default_sc.App_1.app, &tx_msg, &tx_stream);
+        TEST_ASSERT_EQUAL(0, Stream_GetAvailableSampleNB(&tx_stream));
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(140, Stream_GetAvailableSampleNB(&rx_stream));
+        TEST_ASSERT_TRUE(rx_stream.period_ns == 1000000);
+        for (uint16_t i = 0; i < 140; i++)
+        {
+            // Allow the transmission time between the latency and the date conversions
+            TEST_ASSERT_TRUE(fabs(TimeOD_TimeTo_s(Stream_GetSampleDate(&rx_stream, 0)) - (TimeOD_TimeTo_s(date) + ((10 + i) * 0.001))) < 0.0001);
+            TEST_ASSERT_EQUAL(139 - i, Stream_GetSample(&rx_stream, samples, 1));
+            TEST_ASSERT_EQUAL(10 + i, samples[0]);
+        }
+
+        NEW_STEP("Verify that a timed message too short to hold the period is rejected");
+        tx_msg.header.size = sizeof(uint32_t);
+        Timestamp_EncodeMsgNs(&tx_msg, 0);
+        TEST_ASSERT_EQUAL(PROHIBITED, Luos_ReceiveStreaming(default_sc.App_2.app, &tx_msg, &rx_stream));
+        TEST_ASSERT_EQUAL(0, Stream_GetAvailableSampleNB(&rx_stream));
+    }
+}
+
+static streaming_channel_t credit_stream;
+
+static void CreditHandler(service_t *service, msg_t *msg)
+{
+    Luos_ReceiveStreamingCredit(service, msg, &credit_stream);
+}
+
+void unittest_Streaming_CreditFlowControl()
+{
+    NEW_TEST_CASE("Stream to a receiver smaller than the data");
+    {
+        uint16_t tx_buffer[128] = {0};
+        uint16_t rx_buffer[32]  = {0};
+        uint16_t samples[100]   = {0};
+        uint16_t received       = 0;
+        msg_t tx_msg;
+        tx_msg.header.target      = 2;
+        tx_msg.header.target_mode = SERVICEIDACK;
+        tx_msg.header.cmd         = DEFAULT_CMD;
+
+        //  Init default scenario context
+        Init_Context();
+        default_sc.App_1.app->service_cb = CreditHandler;
+        default_sc.App_2.app->service_cb = StreamingHandler;
+        credit_stream                    = Stream_CreateStreamingChannel(tx_buffer, 128, sizeof(uint16_t));
+        rx_stream                        = Stream_CreateStreamingChannel(rx_buffer, 32, sizeof(uint16_t));
+        for (uint16_t i = 0; i < 100; i++)
+        {
+            samples[i] = i;
+        }
+        Stream_PutSample(&credit_stream, samples, 100);
+
+        NEW_STEP("Verify that a channel without credit is not flow controlled");
+        TEST_ASSERT_FALSE(credit_stream.flow_control);
+        TEST_ASSERT_EQUAL(0xFFFF, Stream_GetCreditSampleNB(&credit_stream));
+
+        NEW_STEP("Verify that the sender only sends the samples the receiver accepts");
+        TEST_ASSERT_EQUAL(SUCCEED, Luos_SendStreamingCredit(default_sc.App_2.app, 1, &rx_stream));
+        Luos_Loop();
+        TEST_ASSERT_TRUE(credit_stream.flow_control);
+        TEST_ASSERT_EQUAL(31, Stream_GetCreditSampleNB(&credit_stream));
+        Luos_SendStreaming(default_sc.App_1.app, &tx_msg, &credit_stream);
+        TEST_ASSERT_EQUAL(69, Stream_GetAvailableSampleNB(&credit_stream));
+        TEST_ASSERT_EQUAL(0, Stream_GetCreditSampleNB(&credit_stream));
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(31, Stream_GetAvailableSampleNB(&rx_stream));
+        TEST_ASSERT_EQUAL(0, Stream_GetFreeSampleNB(&rx_stream));
+
+        NEW_STEP("Verify that nothing is sent without credit left");
+        Luos_SendStreaming(default_sc.App_1.app, &tx_msg, &credit_stream);
+        TEST_ASSERT_EQUAL(69, Stream_GetAvailableSampleNB(&credit_stream));
+
+        NEW_STEP("Verify that the stream runs at the receiver rate without loss");
+        RESET_ASSERT();
+        while (received < 100)
+        {
+            uint16_t nb = Stream_GetAvailableSampleNB(&rx_stream);
+            Stream_GetSample(&rx_stream, &samples[received], nb);
+            received += nb;
+            Luos_SendStreamingCredit(default_sc.App_2.app, 1, &rx_stream);
+            Luos_Loop();
+            Luos_SendStreaming(default_sc.App_1.app, &tx_msg, &credit_stream);
+            Luos_Loop();
+        }
+        TEST_ASSERT_FALSE(IS_ASSERT());
+        TEST_ASSERT_EQUAL(100, received);
+        for (uint16_t i = 0; i < 100; i++)
+        {
+            TEST_ASSERT_EQUAL(i, samples[i]);
+        }
+    }
+}
+
+void unittest_Streaming_OverwriteMode()
+{
+    NEW_TEST_CASE("Put samples in a full channel");
+    {
+        uint16_t tx_buffer[8]   = {0};
+        uint16_t rx_buffer[256] = {0};
+        uint16_t samples[20]    = {0};
+        msg_t tx_msg;
+        tx_msg.header.target      = 2;
+        tx_msg.header.target_mode = SERVICEIDACK;
+        tx_msg.header.cmd         = DEFAULT_CMD;
+        streaming_channel_t tx_stream;
+
+        //  Init default scenario context
+        Init_Context();
+        default_sc.App_2.app->service_cb = StreamingHandler;
+        tx_stream                        = Stream_CreateStreamingChannel(tx_buffer, 8, sizeof(uint16_t));
+        rx_stream                        = Stream_CreateStreamingChannel(rx_buffer, 256, sizeof(uint16_t));
+        for (uint16_t i = 0; i < 20; i++)
+        {
+            samples[i] = i;
+        }
+
+        NEW_STEP("Verify that the oldest samples are overwritten and counted");
+        RESET_ASSERT();
+        Stream_SetOverwriteMode(&tx_stream, true);
+        Stream_PutSample(&tx_stream, samples, 5);
+        Stream_PutSample(&tx_stream, &samples[5], 5);
+        TEST_ASSERT_FALSE(IS_ASSERT());
+        TEST_ASSERT_EQUAL(7, Stream_GetAvailableSampleNB(&tx_stream));
+        TEST_ASSERT_EQUAL(3, tx_stream.dropped);
+        TEST_ASSERT_TRUE(tx_stream.sample_ptr == tx_buffer);
+
+        NEW_STEP("Verify that only the last samples of a put bigger than the channel are kept");
+        Stream_PutSample(&tx_stream, &samples[10], 10);
+        TEST_ASSERT_FALSE(IS_ASSERT());
+        TEST_ASSERT_EQUAL(7, Stream_GetAvailableSampleNB(&tx_stream));
+        TEST_ASSERT_EQUAL(13, tx_stream.dropped);
+        TEST_ASSERT_TRUE(tx_stream.sample_ptr == tx_buffer);
+
+        NEW_STEP("Verify that samples written in place overwrite the oldest ones");
+        Stream_AddAvailableSampleNB(&tx_stream, 2);
+        TEST_ASSERT_FALSE(IS_ASSERT());
+        TEST_ASSERT_EQUAL(15, tx_stream.dropped);
+        TEST_ASSERT_TRUE(tx_stream.sample_ptr == tx_buffer);
+
+        NEW_STEP("Verify that sending the samples reports the overwritten ones");
+        TEST_ASSERT_EQUAL(15, Luos_SendStreaming(default_sc.App_1.app, &tx_msg, &tx_stream));
+        TEST_ASSERT_EQUAL(0, Stream_GetOverwrittenSampleNB(&tx_stream));
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(7, Stream_GetAvailableSampleNB(&rx_stream));
+        TEST_ASSERT_EQUAL(15, rx_buffer[0]);
+    }
+
+    NEW_TEST_CASE("Overwrite samples while they are read");
+    {
+        uint16_t tx_buffer[8] = {0};
+        uint16_t samples[7]   = {0, 1, 2, 3, 4, 5, 6};
+        uint16_t new_data[5]  = {100, 101, 102, 103, 104};
+        uint16_t rx_data[7]   = {0};
+        streaming_channel_t tx_stream;
+
+        //  Init default scenario context
+        Init_Context();
+        tx_stream = Stream_CreateStreamingChannel(tx_buffer, 8, sizeof(uint16_t));
+        Stream_SetOverwriteMode(&tx_stream, true);
+        Stream_PutSample(&tx_stream, samples, 7);
+
+        NEW_STEP("Verify that the producer doesn't move the samples being read");
+        RESET_ASSERT();
+        TEST_ASSERT_EQUAL(7, Stream_GetAvailableSampleNBUntilEndBuffer(&tx_stream));
+        // The consumer reads 4 samples in place when the producer puts 2 new ones
+        memcpy(rx_data, tx_stream.sample_ptr, 4 * sizeof(uint16_t));
+        Stream_PutSample(&tx_stream, new_data, 2);
+        TEST_ASSERT_FALSE(IS_ASSERT());
+        TEST_ASSERT_EQUAL(2, tx_stream.dropped);
+        TEST_ASSERT_TRUE(tx_stream.sample_ptr == tx_buffer);
+        TEST_ASSERT_EQUAL(7, Stream_GetAvailableSampleNB(&tx_stream));
+
+        NEW_STEP("Verify that the consumer skips the overwritten samples once");
+        Stream_RmvAvailableSampleNB(&tx_stream, 4);
+        TEST_ASSERT_FALSE(IS_ASSERT());
+        TEST_ASSERT_EQUAL(5, Stream_GetAvailableSampleNB(&tx_stream));
+        Stream_GetSample(&tx_stream, rx_data, 5);
+        TEST_ASSERT_EQUAL(4, rx_data[0]);
+        TEST_ASSERT_EQUAL(5, rx_data[1]);
+        TEST_ASSERT_EQUAL(6, rx_data[2]);
+        TEST_ASSERT_EQUAL(100, rx_data[3]);
+        TEST_ASSERT_EQUAL(101, rx_data[4]);
+        TEST_ASSERT_EQUAL(2, Stream_GetOverwrittenSampleNB(&tx_stream));
+        TEST_ASSERT_EQUAL(0, Stream_GetOverwrittenSampleNB(&tx_stream));
+
+        NEW_STEP("Verify that the consumer skips more samples than read if needed");
+        // A read of 1 sample has 3 samples replaced
+        Stream_PutSample(&tx_stream, samples, 7);
+        TEST_ASSERT_EQUAL(7, Stream_GetAvailableSampleNB(&tx_stream));
+        Stream_PutSample(&tx_stream, new_data, 3);
+        Stream_RmvAvailableSampleNB(&tx_stream, 1);
+        TEST_ASSERT_FALSE(IS_ASSERT());
+        TEST_ASSERT_EQUAL(3, Stream_GetOverwrittenSampleNB(&tx_stream));
+        TEST_ASSERT_EQUAL(7, Stream_GetAvailableSampleNB(&tx_stream));
+        Stream_GetSample(&tx_stream, rx_data, 7);
+        TEST_ASSERT_EQUAL(3, rx_data[0]);
+        TEST_ASSERT_EQUAL(6, rx_data[3]);
+        TEST_ASSERT_EQUAL(100, rx_data[4]);
+        TEST_ASSERT_EQUAL(102, rx_data[6]);
+    }
+}
+
+void unittest_Streaming_BroadcastChannel()
+{
+    NEW_TEST_CASE("Register readers of a broadcast channel");
+    {
+        uint16_t stream_Buffer[8]  = {0};
+        broadcast_channel_t stream = Stream_CreateBroadcastChannel(stream_Buffer, 8, sizeof(uint16_t));
+        stream_reader_t reader[MAX_STREAM_READER + 1];
+
+        NEW_STEP("Verify that a channel takes a limited number of readers");
+        for (uint8_t i = 0; i < MAX_STREAM_READER; i++)
+        {
+            TEST_ASSERT_EQUAL(SUCCEED, Stream_AddBroadcastReader(&stream, &reader[i], STREAM_READER_OVERRUN));
+        }
+        TEST_ASSERT_EQUAL(FAILED, Stream_AddBroadcastReader(&stream, &reader[MAX_STREAM_READER], STREAM_READER_OVERRUN));
+
+        NEW_STEP("Verify that a removed reader frees its place");
+        TEST_ASSERT_EQUAL(SUCCEED, Stream_RemoveBroadcastReader(&stream, &reader[0]));
+        TEST_ASSERT_EQUAL(MAX_STREAM_READER - 1, stream.reader_nb);
+        TEST_ASSERT_TRUE(stream.reader[0] == &reader[1]);
+        TEST_ASSERT_EQUAL(FAILED, Stream_RemoveBroadcastReader(&stream, &reader[0]));
+        TEST_ASSERT_EQUAL(SUCCEED, Stream_AddBroadcastReader(&stream, &reader[MAX_STREAM_READER], STREAM_READER_OVERRUN));
+    }
+
+    NEW_TEST_CASE("Share samples between a blocking and an overrun reader");
+    {
+        uint16_t stream_Buffer[8]  = {0};
+        uint16_t tx_data[12]       = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+        uint16_t rx_data[12]       = {0};
+        stream_reader_t logger     = {0};
+        stream_reader_t gate       = {0};
+        broadcast_channel_t stream = Stream_CreateBroadcastChannel(stream_Buffer, 8, sizeof(uint16_t));
+        Stream_AddBroadcastReader(&stream, &logger, STREAM_READER_BLOCK);
+        Stream_AddBroadcastReader(&stream, &gate, STREAM_READER_OVERRUN);
+
+        NEW_STEP("Verify that each reader gets all the samples");
+        TEST_ASSERT_EQUAL(6, Stream_BroadcastPutSample(&stream, tx_data, 6));
+        TEST_ASSERT_EQUAL(6, Stream_BroadcastGetAvailableSampleNB(&stream, &logger));
+        TEST_ASSERT_EQUAL(6, Stream_BroadcastGetAvailableSampleNB(&stream, &gate));
+        TEST_ASSERT_EQUAL(6, Stream_BroadcastGetSample(&stream, &logger, rx_data, 12));
+        TEST_ASSERT_EQUAL_MEMORY(tx_data, rx_data, 6 * sizeof(uint16_t));
+
+        NEW_STEP("Verify that an overrun reader loses its oldest samples and counts them");
+        TEST_ASSERT_EQUAL(6, Stream_BroadcastPutSample(&stream, &tx_data[6], 6));
+        TEST_ASSERT_EQUAL(4, gate.overrun_nb);
+        TEST_ASSERT_EQUAL(8, Stream_BroadcastGetSample(&stream, &gate, rx_data, 12));
+        TEST_ASSERT_EQUAL_MEMORY(&tx_data[4], rx_data, 8 * sizeof(uint16_t));
+
+        NEW_STEP("Verify that a blocking reader stops the producer without losing samples");
+        TEST_ASSERT_EQUAL(2, Stream_BroadcastGetFreeSampleNB(&stream));
+        TEST_ASSERT_EQUAL(2, Stream_BroadcastPutSample(&stream, tx_data, 4));
+        TEST_ASSERT_EQUAL(0, logger.overrun_nb);
+        TEST_ASSERT_EQUAL(8, Stream_BroadcastGetSample(&stream, &logger, rx_data, 12));
+        TEST_ASSERT_EQUAL_MEMORY(&tx_data[6], rx_data, 6 * sizeof(uint16_t));
+        TEST_ASSERT_EQUAL_MEMORY(tx_data, &rx_data[6], 2 * sizeof(uint16_t));
+        TEST_ASSERT_EQUAL(2, Stream_BroadcastGetSample(&stream, &gate, rx_data, 12));
+        TEST_ASSERT_EQUAL(4, gate.overrun_nb);
+
+        NEW_STEP("Verify that a removed blocking reader doesn't stop the producer anymore");
+        TEST_ASSERT_EQUAL(4, Stream_BroadcastPutSample(&stream, tx_data, 4));
+        TEST_ASSERT_EQUAL(4, Stream_BroadcastGetFreeSampleNB(&stream));
+        TEST_ASSERT_EQUAL(SUCCEED, Stream_RemoveBroadcastReader(&stream, &logger));
+        TEST_ASSERT_EQUAL(8, Stream_BroadcastGetFreeSampleNB(&stream));
+        TEST_ASSERT_EQUAL(8, Stream_BroadcastPutSample(&stream, &tx_data[4], 8));
+        TEST_ASSERT_EQUAL(0, logger.overrun_nb);
+    }
+}
+
+void unittest_Streaming_SpscChannel()
+{
+    NEW_TEST_CASE("Create a lock free channel");
+    {
+        uint16_t stream_Buffer[8] = {0};
+
+        NEW_STEP("Verify that a ring buffer size not being a power of 2 assert");
+        RESET_ASSERT();
+        Stream_CreateSpscChannel(stream_Buffer, 6, sizeof(uint16_t));
+        TEST_ASSERT_TRUE(IS_ASSERT());
+        RESET_ASSERT();
+
+        NEW_STEP("Verify that a new channel is empty");
+        spsc_channel_t stream = Stream_CreateSpscChannel(stream_Buffer, 8, sizeof(uint16_t));
+        TEST_ASSERT_FALSE(IS_ASSERT());
+        TEST_ASSERT_EQUAL(0, Stream_SpscGetAvailableSampleNB(&stream));
+        TEST_ASSERT_EQUAL(8, Stream_SpscGetFreeSampleNB(&stream));
+    }
+
+    NEW_TEST_CASE("Put and get samples through a lock free channel");
+    {
+        uint16_t stream_Buffer[8] = {0};
+        uint16_t tx_data[10]      = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+        uint16_t rx_data[10]      = {0};
+        spsc_channel_t stream     = Stream_CreateSpscChannel(stream_Buffer, 8, sizeof(uint16_t));
+
+        NEW_STEP("Verify that a full buffer only take the samples it can store");
+        TEST_ASSERT_EQUAL(6, Stream_SpscPutSample(&stream, tx_data, 6));
+        TEST_ASSERT_EQUAL(2, Stream_SpscPutSample(&stream, &tx_data[6], 4));
+        TEST_ASSERT_EQUAL(8, Stream_SpscGetAvailableSampleNB(&stream));
+        TEST_ASSERT_EQUAL(0, Stream_SpscGetFreeSampleNB(&stream));
+
+        NEW_STEP("Verify that samples are read in order, even when the buffer loops");
+        TEST_ASSERT_EQUAL(5, Stream_SpscGetSample(&stream, rx_data, 5));
+        TEST_ASSERT_EQUAL_MEMORY(tx_data, rx_data, 5 * sizeof(uint16_t));
+        TEST_ASSERT_EQUAL(4, Stream_SpscPutSample(&stream, tx_data, 4));
+        TEST_ASSERT_EQUAL(3, Stream_SpscGetAvailableSampleNBUntilEndBuffer(&stream));
+        TEST_ASSERT_EQUAL(7, Stream_SpscGetSample(&stream, rx_data, 10));
+        TEST_ASSERT_EQUAL_MEMORY(&tx_data[5], rx_data, 3 * sizeof(uint16_t));
+        TEST_ASSERT_EQUAL_MEMORY(tx_data, &rx_data[3], 4 * sizeof(uint16_t));
+        TEST_ASSERT_EQUAL(0, Stream_SpscGetSample(&stream, rx_data, 1));
+    }
+
+    NEW_TEST_CASE("Wrap the lock free channel counters");
+    {
+        uint8_t stream_Buffer[4] = {0};
+        uint8_t tx_data[3]       = {1, 2, 3};
+        uint8_t rx_data[3]       = {0};
+        spsc_channel_t stream    = Stream_CreateSpscChannel(stream_Buffer, 4, 1);
+        stream.head              = 0xFFFFFFFF;
+        stream.tail              = 0xFFFFFFFF;
+
+        NEW_STEP("Verify that samples are counted across the counters overflow");
+        TEST_ASSERT_EQUAL(3, Stream_SpscPutSample(&stream, tx_data, 3));
+        TEST_ASSERT_EQUAL(2, stream.head);
+        TEST_ASSERT_EQUAL(3, Stream_SpscGetAvailableSampleNB(&stream));
+        TEST_ASSERT_EQUAL(1, Stream_SpscGetFreeSampleNB(&stream));
+        TEST_ASSERT_EQUAL(3, Stream_SpscGetSample(&stream, rx_data, 3));
+        TEST_ASSERT_EQUAL_MEMORY(tx_data, rx_data, 3);
+    }
+
+    NEW_TEST_CASE("Write and read a lock free channel in place");
+    {
+        uint8_t stream_Buffer[8] = {0};
+        spsc_channel_t stream    = Stream_CreateSpscChannel(stream_Buffer, 8, 1);
+
+        NEW_STEP("Verify that a driver can fill and empty the buffer without copy");
+        TEST_ASSERT_EQUAL(8, Stream_SpscGetFreeSampleNBUntilEndBuffer(&stream));
+        memset(Stream_SpscGetDataPtr(&stream), 0x55, 6);
+        TEST_ASSERT_EQUAL(6, Stream_SpscAddAvailableSampleNB(&stream, 6));
+        TEST_ASSERT_EQUAL(2, Stream_SpscGetFreeSampleNBUntilEndBuffer(&stream));
+        TEST_ASSERT_EQUAL(0x55, *(uint8_t *)Stream_SpscGetSamplePtr(&stream));
+        TEST_ASSERT_EQUAL(2, Stream_SpscRmvAvailableSampleNB(&stream, 4));
+        TEST_ASSERT_TRUE(Stream_SpscGetSamplePtr(&stream) == &stream_Buffer[4]);
+
+        NEW_STEP("Verify that removing more samples than available assert");
+        RESET_ASSERT();
+        Stream_SpscRmvAvailableSampleNB(&stream, 3);
+        TEST_ASSERT_TRUE(IS_ASSERT());
+        RESET_ASSERT();
+    }
+}
+
+typedef struct
+{
+    uint32_t offset;   // Next offset expected
+    uint32_t checksum; // Sum of the bytes received
+    uint8_t chunk_nb;
+    uint8_t end_nb;
+    uint8_t abort_nb;
+} sink_ctx_t;
+
+static void TestSink(void *context, sink_event_t event, const void *data, uint16_t size, uint32_t offset)
+{
+    sink_ctx_t *ctx = (sink_ctx_t *)context;
+    switch (event)
+    {
+        case SINK_CHUNK:
+            TEST_ASSERT_EQUAL(ctx->offset, offset);
+            for (uint16_t i = 0; i < size; i++)
+            {
+                ctx->checksum += ((uint8_t *)data)[i];
+            }
+            ctx->offset += size;
+            ctx->chunk_nb++;
+            break;
+        case SINK_END:
+            TEST_ASSERT_EQUAL(ctx->offset, offset);
+            ctx->end_nb++;
+            break;
+        case SINK_ABORT:
+            ctx->abort_nb++;
+            break;
+    }
+}
+
 void unittest_Luos_ReceiveData()
 {
     NEW_TEST_CASE("Try to send a void message argument");
@@ -135,7 +608,7 @@ void unittest_Luos_ReceiveData()
 
         NEW_STEP("Verify if we assert");
         RESET_ASSERT();
-        TEST_ASSERT_EQUAL(Luos_ReceiveData(NULL, 0, bin_data), -1);
+        TEST_ASSERT_EQUAL(Luos_ReceiveData(NULL, 0, bin_data, sizeof(bin_data)), -1);
         RESET_ASSERT();
     }
 
@@ -147,7 +620,7 @@ void unittest_Luos_ReceiveData()
         service_t *service  = Luos_CreateService(0, VOID_TYPE, "Dummy_App", revision);
         msg_t msg;
         NEW_STEP("Verify function returns -1");
-        Luos_ReceiveData(service, &msg, 0);
+        Luos_ReceiveData(service, &msg, 0, 0);
         TEST_ASSERT_TRUE(IS_ASSERT());
         RESET_ASSERT();
     }
@@ -159,7 +632,7 @@ void unittest_Luos_ReceiveData()
         msg_t msg;
         uint32_t bin_data[64] = {0xDEADBEEF};
         NEW_STEP("Verify if we return an error");
-        TEST_ASSERT_EQUAL(Luos_ReceiveData((service_t *)10, &msg, bin_data), -1);
+        TEST_ASSERT_EQUAL(Luos_ReceiveData((service_t *)10, &msg, bin_data, sizeof(bin_data)), -1);
     }
 
     NEW_TEST_CASE("Test the regular usage");
@@ -170,16 +643,17 @@ void unittest_Luos_ReceiveData()
         service_t *service  = Luos_CreateService(0, VOID_TYPE, "Dummy_App", revision);
         msg_t msg;
         uint8_t bin_data[256] = {0};
+        msg.header.config     = BASE_PROTOCOL;
 
         NEW_STEP("Verify that the first message return 0 meaning message is not completely received");
         // Set first message
         msg.header.size = 256;
         memset(msg.data, 0xAA, 128);
-        TEST_ASSERT_EQUAL(Luos_ReceiveData(service, &msg, bin_data), 0);
+        TEST_ASSERT_EQUAL(Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)), 0);
 
         NEW_STEP("Verify that the second message return 256 byte received");
         msg.header.size = 128;
-        TEST_ASSERT_EQUAL(Luos_ReceiveData(service, &msg, bin_data), 256);
+        TEST_ASSERT_EQUAL(Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)), 256);
 
         NEW_STEP("Check if the data is OK");
         for (int i = 0; i < 256; i++)
@@ -196,19 +670,578 @@ void unittest_Luos_ReceiveData()
         service_t *service  = Luos_CreateService(0, VOID_TYPE, "Dummy_App", revision);
         msg_t msg;
         uint8_t bin_data[256] = {0};
+        msg.header.config     = BASE_PROTOCOL;
 
         NEW_STEP("Verify that the first message return 0 meaning message is not completely received");
         // Set first message
         msg.header.size = 256;
         memset(msg.data, 0xAA, 128);
-        TEST_ASSERT_EQUAL(Luos_ReceiveData(service, &msg, bin_data), 0);
+        TEST_ASSERT_EQUAL(Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)), 0);
 
         NEW_STEP("Verify if we return an error which mean the data reception have been reseted");
-        TEST_ASSERT_EQUAL(Luos_ReceiveData(0, &msg, bin_data), -1);
+        TEST_ASSERT_EQUAL(Luos_ReceiveData(0, &msg, bin_data, sizeof(bin_data)), -1);
 
         NEW_STEP("Verify that the second message return 128 byte received half of the transmitted data because we reset it in the middle");
         msg.header.size = 128;
-        TEST_ASSERT_EQUAL(Luos_ReceiveData(service, &msg, bin_data), 128);
+        TEST_ASSERT_EQUAL(Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)), 128);
+    }
+
+    NEW_TEST_CASE("Receive data from two sources at the same time");
+    {
+        //  Init default scenario context
+        Init_Context();
+        revision_t revision = {.major = 1, .minor = 0, .build = 0};
+        service_t *service  = Luos_CreateService(0, VOID_TYPE, "Dummy_App", revision);
+        msg_t msg_a;
+        msg_t msg_b;
+        uint8_t bin_data_a[256] = {0};
+        uint8_t bin_data_b[384] = {0};
+        msg_a.header.config     = BASE_PROTOCOL;
+        msg_a.header.source     = 2;
+        msg_a.header.cmd        = SET_CMD;
+        msg_b.header.config     = BASE_PROTOCOL;
+        msg_b.header.source     = 3;
+        msg_b.header.cmd        = SET_CMD;
+        memset(msg_a.data, 0xAA, 128);
+        memset(msg_b.data, 0xBB, 128);
+
+        NEW_STEP("Verify that interleaved chunks are not mixed");
+        msg_a.header.size = 256;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveData(service, &msg_a, bin_data_a, sizeof(bin_data_a)));
+        msg_b.header.size = 384;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveData(service, &msg_b, bin_data_b, sizeof(bin_data_b)));
+        msg_b.header.size = 256;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveData(service, &msg_b, bin_data_b, sizeof(bin_data_b)));
+        msg_a.header.size = 128;
+        TEST_ASSERT_EQUAL(256, Luos_ReceiveData(service, &msg_a, bin_data_a, sizeof(bin_data_a)));
+        msg_b.header.size = 128;
+        TEST_ASSERT_EQUAL(384, Luos_ReceiveData(service, &msg_b, bin_data_b, sizeof(bin_data_b)));
+
+        NEW_STEP("Check if the data is OK");
+        for (int i = 0; i < 256; i++)
+        {
+            TEST_ASSERT_EQUAL(0xAA, bin_data_a[i]);
+        }
+        for (int i = 0; i < 384; i++)
+        {
+            TEST_ASSERT_EQUAL(0xBB, bin_data_b[i]);
+        }
+    }
+
+    NEW_TEST_CASE("Detect missing chunks");
+    {
+        //  Init default scenario context
+        Init_Context();
+        revision_t revision = {.major = 1, .minor = 0, .build = 0};
+        service_t *service  = Luos_CreateService(0, VOID_TYPE, "Dummy_App", revision);
+        msg_t msg;
+        uint8_t bin_data[512] = {0};
+        msg.header.config     = BASE_PROTOCOL;
+        msg.header.source     = 2;
+        msg.header.cmd        = SET_CMD;
+        memset(msg.data, 0xAA, 128);
+
+        NEW_STEP("Verify that a missing chunk in the middle of the data return an error once");
+        msg.header.size = 384;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)));
+        msg.header.size = 128;
+        TEST_ASSERT_EQUAL(-1, Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)));
+
+        NEW_STEP("Verify that the chunks following a missing chunk are dropped");
+        msg.header.size = 512;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)));
+        msg.header.size = 256;
+        TEST_ASSERT_EQUAL(-1, Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)));
+        msg.header.size = 128;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)));
+
+        NEW_STEP("Verify that a new data replace a data with a missing end");
+        msg.header.size = 384;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)));
+        msg.header.size = 256;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)));
+        msg.header.size = 256;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)));
+        msg.header.size = 128;
+        TEST_ASSERT_EQUAL(256, Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)));
+    }
+
+    NEW_TEST_CASE("Drop data bigger than the buffer");
+    {
+        //  Init default scenario context
+        Init_Context();
+        revision_t revision = {.major = 1, .minor = 0, .build = 0};
+        service_t *service  = Luos_CreateService(0, VOID_TYPE, "Dummy_App", revision);
+        msg_t msg;
+        uint8_t bin_data[256] = {0};
+        msg.header.config     = BASE_PROTOCOL;
+        msg.header.source     = 2;
+        msg.header.cmd        = SET_CMD;
+        memset(msg.data, 0xAA, 128);
+
+        NEW_STEP("Verify that a data overflowing the buffer return an error once and is not copied");
+        msg.header.size = 384;
+        TEST_ASSERT_EQUAL(-1, Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)));
+        msg.header.size = 256;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)));
+        msg.header.size = 128;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)));
+        for (int i = 0; i < 256; i++)
+        {
+            TEST_ASSERT_EQUAL(0, bin_data[i]);
+        }
+
+        NEW_STEP("Verify that a single message overflowing the buffer is dropped");
+        msg.header.size = 64;
+        TEST_ASSERT_EQUAL(-1, Luos_ReceiveData(service, &msg, bin_data, 32));
+        TEST_ASSERT_EQUAL(0, bin_data[0]);
+
+        NEW_STEP("Verify that the next data fitting in the buffer is received");
+        msg.header.size = 256;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)));
+        msg.header.size = 128;
+        TEST_ASSERT_EQUAL(256, Luos_ReceiveData(service, &msg, bin_data, sizeof(bin_data)));
+    }
+}
+
+void unittest_Luos_ReceiveDataSink()
+{
+    NEW_TEST_CASE("Receive data chunk by chunk into a sink");
+    {
+        //  Init default scenario context
+        Init_Context();
+        revision_t revision = {.major = 1, .minor = 0, .build = 0};
+        service_t *service  = Luos_CreateService(0, VOID_TYPE, "Dummy_App", revision);
+        sink_ctx_t ctx      = {0};
+        msg_t msg;
+        msg.header.config = BASE_PROTOCOL;
+        msg.header.source = 2;
+        msg.header.cmd    = SET_CMD;
+        memset(msg.data, 0x01, 128);
+
+        NEW_STEP("Verify that each chunk is given in order then the end of the data");
+        for (uint32_t size = 1000; size > 128; size -= 128)
+        {
+            msg.header.size = size;
+            TEST_ASSERT_EQUAL(0, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        }
+        msg.header.size = 1000 % 128;
+        TEST_ASSERT_EQUAL(1000, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        TEST_ASSERT_EQUAL(8, ctx.chunk_nb);
+        TEST_ASSERT_EQUAL(1, ctx.end_nb);
+        TEST_ASSERT_EQUAL(1000, ctx.checksum);
+
+        NEW_STEP("Verify that a single message data is given to the sink");
+        memset(&ctx, 0, sizeof(sink_ctx_t));
+        msg.header.size = 10;
+        TEST_ASSERT_EQUAL(10, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        TEST_ASSERT_EQUAL(1, ctx.chunk_nb);
+        TEST_ASSERT_EQUAL(1, ctx.end_nb);
+
+        NEW_STEP("Verify that the sink is told when chunks are missing");
+        memset(&ctx, 0, sizeof(sink_ctx_t));
+        msg.header.size = 512;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        msg.header.size = 256;
+        TEST_ASSERT_EQUAL(-1, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        msg.header.size = 128;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        TEST_ASSERT_EQUAL(1, ctx.chunk_nb);
+        TEST_ASSERT_EQUAL(0, ctx.end_nb);
+        TEST_ASSERT_EQUAL(1, ctx.abort_nb);
+
+        NEW_STEP("Verify that a reset abort the data in reception");
+        memset(&ctx, 0, sizeof(sink_ctx_t));
+        msg.header.size = 512;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        TEST_ASSERT_EQUAL(-1, Luos_ReceiveData(NULL, NULL, NULL, 0));
+        TEST_ASSERT_EQUAL(1, ctx.abort_nb);
+
+        NEW_STEP("Verify that a data which stopped is aborted by the Luos loop");
+        memset(&ctx, 0, sizeof(sink_ctx_t));
+        msg.header.size = 512;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(0, ctx.abort_nb);
+        LuosHAL_ShiftSystick(REASSEMBLY_TIMEOUT_MS + 1);
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(1, ctx.abort_nb);
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(1, ctx.abort_nb);
+
+        NEW_STEP("Verify that the next data start in a free session");
+        memset(&ctx, 0, sizeof(sink_ctx_t));
+        msg.header.size = 384;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        msg.header.size = 256;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        msg.header.size = 128;
+        TEST_ASSERT_EQUAL(384, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        TEST_ASSERT_EQUAL(1, ctx.end_nb);
+        TEST_ASSERT_EQUAL(0, ctx.abort_nb);
+    }
+
+    NEW_TEST_CASE("Receive data bigger than 64KB into a sink");
+    {
+        //  Init default scenario context
+        Init_Context();
+        revision_t revision = {.major = 1, .minor = 0, .build = 0};
+        service_t *service  = Luos_CreateService(0, VOID_TYPE, "Dummy_App", revision);
+        sink_ctx_t ctx      = {0};
+        uint32_t left_size  = 100000;
+        uint16_t chunk_size = 0;
+        msg_t msg;
+        msg.header.source = 2;
+        msg.header.cmd    = SET_CMD;
+
+        NEW_STEP("Verify that bulk chunks then legacy chunks are received");
+        while (left_size > MAX_HEADER_DATA_SIZE)
+        {
+            chunk_size = MAX_DATA_MSG_SIZE - BULK_HEADER_SIZE;
+            memcpy(msg.data, &left_size, BULK_HEADER_SIZE);
+            memset(&msg.data[BULK_HEADER_SIZE], 0x01, chunk_size);
+            msg.header.config = BULK_PROTOCOL;
+            msg.header.size   = MAX_DATA_MSG_SIZE;
+            TEST_ASSERT_EQUAL(0, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+            left_size -= chunk_size;
+        }
+        memset(msg.data, 0x01, MAX_DATA_MSG_SIZE);
+        msg.header.config = BASE_PROTOCOL;
+        while (left_size > MAX_DATA_MSG_SIZE)
+        {
+            msg.header.size = left_size;
+            TEST_ASSERT_EQUAL(0, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+            left_size -= MAX_DATA_MSG_SIZE;
+        }
+        msg.header.size = left_size;
+        TEST_ASSERT_EQUAL(100000, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        TEST_ASSERT_EQUAL(1, ctx.end_nb);
+        TEST_ASSERT_EQUAL(0, ctx.abort_nb);
+        TEST_ASSERT_EQUAL(100000, ctx.checksum);
+
+        NEW_STEP("Verify that a missing bulk chunk is detected");
+        memset(&ctx, 0, sizeof(sink_ctx_t));
+        left_size = 100000;
+        memcpy(msg.data, &left_size, BULK_HEADER_SIZE);
+        msg.header.config = BULK_PROTOCOL;
+        msg.header.size   = MAX_DATA_MSG_SIZE;
+        TEST_ASSERT_EQUAL(0, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        left_size -= 2 * (MAX_DATA_MSG_SIZE - BULK_HEADER_SIZE);
+        memcpy(msg.data, &left_size, BULK_HEADER_SIZE);
+        TEST_ASSERT_EQUAL(-1, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        TEST_ASSERT_EQUAL(1, ctx.abort_nb);
+        Luos_ReceiveData(NULL, NULL, NULL, 0);
+
+        NEW_STEP("Verify that a legacy 65535 bytes data is not taken as a bulk one");
+        memset(&ctx, 0, sizeof(sink_ctx_t));
+        memset(msg.data, 0x01, MAX_DATA_MSG_SIZE);
+        msg.header.config = BASE_PROTOCOL;
+        for (left_size = 0xFFFF; left_size > MAX_DATA_MSG_SIZE; left_size -= MAX_DATA_MSG_SIZE)
+        {
+            msg.header.size = left_size;
+            TEST_ASSERT_EQUAL(0, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        }
+        msg.header.size = left_size;
+        TEST_ASSERT_EQUAL(0xFFFF, Luos_ReceiveDataSink(service, &msg, TestSink, &ctx));
+        TEST_ASSERT_EQUAL(0, ctx.abort_nb);
+        TEST_ASSERT_EQUAL(0xFFFF, ctx.checksum);
+    }
+}
+
+static uint16_t dispatch_order[16]; // Id of the services in the order of their callbacks
+static uint8_t dispatch_nb;
+
+static void OrderHandler(service_t *service, msg_t *msg)
+{
+    if ((msg->header.cmd == DEFAULT_CMD) && (dispatch_nb < 16))
+    {
+        dispatch_order[dispatch_nb++] = service->ll_service->id;
+    }
+}
+
+static void SendToService(service_t *service, uint8_t nb)
+{
+    msg_t tx_msg;
+    tx_msg.header.target      = service->ll_service->id;
+    tx_msg.header.target_mode = SERVICEIDACK;
+    tx_msg.header.cmd         = DEFAULT_CMD;
+    tx_msg.header.size        = 0;
+    for (uint8_t i = 0; i < nb; i++)
+    {
+        Luos_SendMsg(default_sc.App_1.app, &tx_msg);
+    }
+}
+
+void unittest_Luos_PriorityDispatch()
+{
+    NEW_TEST_CASE("Dispatch the messages of higher priority services first");
+    {
+        //  Init default scenario context
+        Init_Context();
+        service_t *low_service   = default_sc.App_2.app;
+        service_t *high_service  = default_sc.App_3.app;
+        low_service->service_cb  = OrderHandler;
+        low_service->priority    = LOW_PRIORITY;
+        high_service->service_cb = OrderHandler;
+        high_service->priority   = HIGH_PRIORITY;
+        dispatch_nb              = 0;
+
+        NEW_STEP("Verify that high priority messages overtake older low priority ones");
+        SendToService(low_service, 3);
+        SendToService(high_service, 3);
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(6, dispatch_nb);
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            TEST_ASSERT_EQUAL(high_service->ll_service->id, dispatch_order[i]);
+            TEST_ASSERT_EQUAL(low_service->ll_service->id, dispatch_order[3 + i]);
+        }
+
+        NEW_STEP("Verify that equal priorities keep the reception order");
+        dispatch_nb            = 0;
+        low_service->priority  = NORMAL_PRIORITY;
+        high_service->priority = NORMAL_PRIORITY;
+        SendToService(low_service, 2);
+        SendToService(high_service, 2);
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(4, dispatch_nb);
+        TEST_ASSERT_EQUAL(low_service->ll_service->id, dispatch_order[0]);
+        TEST_ASSERT_EQUAL(low_service->ll_service->id, dispatch_order[1]);
+        TEST_ASSERT_EQUAL(high_service->ll_service->id, dispatch_order[2]);
+    }
+
+    NEW_TEST_CASE("Dispatch low priority messages under a high priority load");
+    {
+        //  Init default scenario context
+        Init_Context();
+        service_t *low_service   = default_sc.App_2.app;
+        service_t *high_service  = default_sc.App_3.app;
+        low_service->service_cb  = OrderHandler;
+        low_service->priority    = LOW_PRIORITY;
+        high_service->service_cb = OrderHandler;
+        high_service->priority   = HIGH_PRIORITY;
+        dispatch_nb              = 0;
+
+        NEW_STEP("Verify that the low priority message wait at most PRIORITY_STARVATION_LIMIT messages");
+        SendToService(low_service, 1);
+        SendToService(high_service, PRIORITY_STARVATION_LIMIT + 4);
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(PRIORITY_STARVATION_LIMIT + 5, dispatch_nb);
+        for (uint8_t i = 0; i < PRIORITY_STARVATION_LIMIT; i++)
+        {
+            TEST_ASSERT_EQUAL(high_service->ll_service->id, dispatch_order[i]);
+        }
+        TEST_ASSERT_EQUAL(low_service->ll_service->id, dispatch_order[PRIORITY_STARVATION_LIMIT]);
+    }
+}
+
+static uint32_t package_loop_nb[3];
+
+static void PackageInit(void)
+{
+}
+
+static void FreePackageLoop(void)
+{
+    package_loop_nb[0]++;
+}
+
+static void PeriodicPackageLoop(void)
+{
+    package_loop_nb[1]++;
+}
+
+static void HeavyPackageLoop(void)
+{
+    // Run for 2ms, twice its budget
+    LuosHAL_ShiftSystick(2000);
+    package_loop_nb[2]++;
+}
+
+void unittest_Luos_PackageScheduler()
+{
+    NEW_TEST_CASE("Run package loops on time and defer the overrunning ones");
+    {
+        //  Init default scenario context
+        Init_Context();
+        Luos_AddPackage(PackageInit, FreePackageLoop);
+        Luos_AddPeriodicPackage(PackageInit, PeriodicPackageLoop, 10000, 0);
+        Luos_AddPeriodicPackage(PackageInit, HeavyPackageLoop, 0, 1000);
+        memset(package_loop_nb, 0, sizeof(package_loop_nb));
+        // First run init the node
+        Luos_Run();
+        Luos_ResetStatistic();
+
+        NEW_STEP("Verify that each package loop run at its own rate for 100ms");
+        // Each run takes 100us, the stub clock is shifted instead of waiting
+        uint64_t start_date = TimerWheel_Now();
+        for (uint16_t i = 0; (i < 1000) && ((TimerWheel_Now() - start_date) < 100000); i++)
+        {
+            Luos_Run();
+            LuosHAL_ShiftSystick(100);
+        }
+        // The periodic package run each 10ms
+        TEST_ASSERT_TRUE(package_loop_nb[1] >= 9);
+        TEST_ASSERT_TRUE(package_loop_nb[1] <= 11);
+        // The heavy package is deferred by 1ms after each overrun, so it can't use more than 2/3 of the time
+        TEST_ASSERT_TRUE(package_loop_nb[2] <= 34);
+        TEST_ASSERT_TRUE(package_loop_nb[0] > package_loop_nb[2]);
+
+        NEW_STEP("Verify that overruns are reported in the node statistics");
+        TEST_ASSERT_TRUE(default_sc.App_1.app->node_statistics->package_deadline_miss >= package_loop_nb[2]);
+    }
+}
+
+static void UpdateHandler(service_t *service, msg_t *msg)
+{
+    if (msg->header.cmd == GET_CMD)
+    {
+        // Answer directly to the source like most of the applications do
+        msg_t pub_msg;
+        pub_msg.header.target      = msg->header.source;
+        pub_msg.header.target_mode = SERVICEIDACK;
+        pub_msg.header.cmd         = IO_STATE;
+        pub_msg.header.size        = 1;
+        pub_msg.data[0]            = 42;
+        Luos_SendMsg(service, &pub_msg);
+    }
+}
+
+static void AskUpdate(service_t *subscriber, uint32_t period_us)
+{
+    time_luos_t period = TimeOD_TimeFrom_us(period_us);
+    msg_t msg;
+    msg.header.target      = default_sc.App_2.app->ll_service->id;
+    msg.header.target_mode = SERVICEIDACK;
+    TimeOD_TimeToMsg(&period, &msg);
+    msg.header.cmd = UPDATE_PUB;
+    Luos_SendMsg(subscriber, &msg);
+    Luos_Loop();
+    Luos_Loop();
+}
+
+void unittest_Luos_AutoUpdateSubscribers()
+{
+    NEW_TEST_CASE("Auto update of several subscribers");
+    {
+        //  Init default scenario context
+        Init_Context();
+        default_sc.App_2.app->service_cb = UpdateHandler;
+        uint16_t topic;
+        uint64_t start_date;
+
+        NEW_STEP("Verify that subscribers with the same period share a topic");
+        AskUpdate(default_sc.App_1.app, 300);
+        AskUpdate(default_sc.App_3.app, 300);
+        topic = default_sc.App_2.app->auto_refresh[0].topic;
+        TEST_ASSERT_EQUAL(300, default_sc.App_2.app->auto_refresh[1].period_us);
+        TEST_ASSERT_EQUAL(topic, default_sc.App_2.app->auto_refresh[1].topic);
+        TEST_ASSERT_TRUE((topic >= FIRST_UPDATE_TOPIC) && (topic <= LAST_TOPIC));
+        TEST_ASSERT_TRUE(Topic_IsTopicSubscribed(default_sc.App_1.app->ll_service, topic));
+        TEST_ASSERT_TRUE(Topic_IsTopicSubscribed(default_sc.App_3.app->ll_service, topic));
+
+        NEW_STEP("Verify that one publication updates both subscribers");
+        memset(&default_sc.App_1.last_rx_msg, 0, sizeof(msg_t));
+        memset(&default_sc.App_3.last_rx_msg, 0, sizeof(msg_t));
+        start_date = TimerWheel_Now();
+        while ((default_sc.App_1.last_rx_msg.header.cmd != IO_STATE) || (default_sc.App_3.last_rx_msg.header.cmd != IO_STATE))
+        {
+            Luos_Loop();
+            TEST_ASSERT_TRUE(TimerWheel_Now() - start_date < 2000);
+        }
+        TEST_ASSERT_EQUAL(TOPIC, default_sc.App_1.last_rx_msg.header.target_mode);
+        TEST_ASSERT_EQUAL(topic, default_sc.App_1.last_rx_msg.header.target);
+        TEST_ASSERT_EQUAL(default_sc.App_2.app->ll_service->id, default_sc.App_3.last_rx_msg.header.source);
+        TEST_ASSERT_EQUAL(42, default_sc.App_3.last_rx_msg.data[0]);
+
+        NEW_STEP("Verify that a subscriber alone on its period is updated directly");
+        AskUpdate(default_sc.App_3.app, 500);
+        TEST_ASSERT_EQUAL(0, default_sc.App_2.app->auto_refresh[0].topic);
+        TEST_ASSERT_EQUAL(0, default_sc.App_2.app->auto_refresh[1].topic);
+        TEST_ASSERT_FALSE(Topic_IsTopicSubscribed(default_sc.App_1.app->ll_service, topic));
+        TEST_ASSERT_FALSE(Topic_IsTopicSubscribed(default_sc.App_3.app->ll_service, topic));
+        memset(&default_sc.App_3.last_rx_msg, 0, sizeof(msg_t));
+        start_date = TimerWheel_Now();
+        while (default_sc.App_3.last_rx_msg.header.cmd != IO_STATE)
+        {
+            Luos_Loop();
+            TEST_ASSERT_TRUE(TimerWheel_Now() - start_date < 2000);
+        }
+        TEST_ASSERT_EQUAL(SERVICEIDACK, default_sc.App_3.last_rx_msg.header.target_mode);
+        TEST_ASSERT_EQUAL(default_sc.App_3.app->ll_service->id, default_sc.App_3.last_rx_msg.header.target);
+
+        NEW_STEP("Verify that a polling service only reads the updates it subscribed to");
+        AskUpdate(default_sc.App_1.app, 500);
+        topic                            = default_sc.App_2.app->auto_refresh[0].topic;
+        default_sc.App_1.app->service_cb = NULL;
+        default_sc.App_2.app->service_cb = NULL;
+        msg_t *rx_msg                    = NULL;
+        msg_t pub_msg;
+        pub_msg.header.target      = topic;
+        pub_msg.header.target_mode = TOPIC;
+        pub_msg.header.cmd         = IO_STATE;
+        pub_msg.header.size        = 1;
+        pub_msg.data[0]            = 24;
+        // Another service publishes on the same topic
+        Luos_SendMsg(default_sc.App_3.app, &pub_msg);
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(FAILED, Luos_ReadFromService(default_sc.App_1.app, default_sc.App_3.app->ll_service->id, &rx_msg));
+        Luos_SendMsg(default_sc.App_3.app, &pub_msg);
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(FAILED, Luos_ReadMsg(default_sc.App_1.app, &rx_msg));
+        // The publisher we subscribed to
+        pub_msg.data[0] = 42;
+        Luos_SendMsg(default_sc.App_2.app, &pub_msg);
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(SUCCEED, Luos_ReadMsg(default_sc.App_1.app, &rx_msg));
+        TEST_ASSERT_EQUAL(42, rx_msg->data[0]);
+        default_sc.App_2.app->service_cb = UpdateHandler;
+
+        NEW_STEP("Verify that null periods remove the subscribers");
+        AskUpdate(default_sc.App_1.app, 0);
+        AskUpdate(default_sc.App_3.app, 0);
+        for (uint8_t i = 0; i < MAX_UPDATE_SUBSCRIBER; i++)
+        {
+            TEST_ASSERT_EQUAL(0, default_sc.App_2.app->auto_refresh[i].period_us);
+        }
+    }
+}
+
+void unittest_Luos_RunUntilEvent()
+{
+    NEW_TEST_CASE("Wait for an event then run the Luos loop");
+    {
+        //  Init default scenario context
+        Init_Context();
+        msg_t tx_msg;
+        tx_msg.header.target      = 2;
+        tx_msg.header.target_mode = SERVICEIDACK;
+        tx_msg.header.cmd         = DEFAULT_CMD;
+        tx_msg.header.size        = 1;
+        tx_msg.data[0]            = 0x55;
+        memset(&default_sc.App_2.last_rx_msg, 0, sizeof(msg_t));
+
+        NEW_STEP("Verify that we leave on timeout without any event");
+        uint32_t start_date = Luos_GetSystick();
+        Luos_RunUntilEvent(1000);
+        TEST_ASSERT_TRUE((Luos_GetSystick() - start_date) >= 1000);
+
+        NEW_STEP("Verify that a received message is managed without waiting the timeout");
+        Luos_SendMsg(default_sc.App_1.app, &tx_msg);
+        Luos_RunUntilEvent(0xFFFFFFFF);
+        TEST_ASSERT_EQUAL(DEFAULT_CMD, default_sc.App_2.last_rx_msg.header.cmd);
+        TEST_ASSERT_EQUAL(0x55, default_sc.App_2.last_rx_msg.data[0]);
+
+        NEW_STEP("Verify that a message for a polling service doesn't end the wait");
+        msg_t *rx_msg                    = NULL;
+        default_sc.App_2.app->service_cb = NULL;
+        Luos_SendMsg(default_sc.App_1.app, &tx_msg);
+        Luos_Loop();
+        start_date = Luos_GetSystick();
+        Luos_RunUntilEvent(20);
+        TEST_ASSERT_TRUE((Luos_GetSystick() - start_date) >= 20);
+        TEST_ASSERT_EQUAL(SUCCEED, Luos_ReadMsg(default_sc.App_2.app, &rx_msg));
+        TEST_ASSERT_EQUAL(0x55, rx_msg->data[0]);
     }
 }
 
@@ -218,8 +1251,23 @@ int main(int argc, char **argv)
 
     // Big data reception
     UNIT_TEST_RUN(unittest_Luos_ReceiveData);
+    UNIT_TEST_RUN(unittest_Luos_ReceiveDataSink);
+    // Service priorities
+    UNIT_TEST_RUN(unittest_Luos_PriorityDispatch);
+    // Package scheduling
+    UNIT_TEST_RUN(unittest_Luos_PackageScheduler);
+    // Luos auto update
+    UNIT_TEST_RUN(unittest_Luos_AutoUpdateSubscribers);
     // Streaming functions
     UNIT_TEST_RUN(unittest_Streaming_SendStreamingSize);
+    UNIT_TEST_RUN(unittest_Streaming_SendStreamingSlices);
+    UNIT_TEST_RUN(unittest_Streaming_SendTimestampStreaming);
+    UNIT_TEST_RUN(unittest_Streaming_CreditFlowControl);
+    UNIT_TEST_RUN(unittest_Streaming_OverwriteMode);
+    UNIT_TEST_RUN(unittest_Streaming_BroadcastChannel);
+    UNIT_TEST_RUN(unittest_Streaming_SpscChannel);
+    // Event driven loop
+    UNIT_TEST_RUN(unittest_Luos_RunUntilEvent);
 
     UNITY_END();
 }
@@ -3,5 +3,16 @@
 
 // Sreaming functions
 void unittest_Streaming_SendStreamingSize(void);
+void unittest_Streaming_SendStreamingSlices(void);
+void unittest_Streaming_SendTimestampStreaming(void);
+void unittest_Streaming_CreditFlowControl(void);
+void unittest_Streaming_OverwriteMode(void);
+void unittest_Streaming_BroadcastChannel(void);
+void unittest_Streaming_SpscChannel(void);
+void unittest_Luos_ReceiveDataSink(void);
+void unittest_Luos_PriorityDispatch(void);
+void unittest_Luos_PackageScheduler(void);
+void unittest_Luos_AutoUpdateSubscribers(void);
+void unittest_Luos_RunUntilEvent(void);
 
 #endif //MAIN_H
\ No newline at end of file
@@ -35,6 +35,7 @@ int main(int argc, char **argv)
     UNIT_TEST_RUN(unittest_MsgAlloc_PullMsg);
     UNIT_TEST_RUN(unittest_MsgAlloc_PullMsgFromLuosTask);
     UNIT_TEST_RUN(unittest_MsgAlloc_LookAtLuosTask);
+    UNIT_TEST_RUN(unittest_MsgAlloc_PeekLuosTask);
     UNIT_TEST_RUN(unittest_MsgAlloc_ClearMsgFromLuosTasks);
     UNIT_TEST_RUN(unittest_MsgAlloc_PullMsgFromTxTask);
     UNIT_TEST_RUN(unittest_MsgAlloc_PullServiceFromTxTask);
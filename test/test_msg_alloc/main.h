@@ -29,6 +29,7 @@ void unittest_MsgAlloc_LuosTasksNbr(void);
 void unittest_MsgAlloc_PullMsg(void);
 void unittest_MsgAlloc_PullMsgFromLuosTask(void);
 void unittest_MsgAlloc_LookAtLuosTask(void);
+void unittest_MsgAlloc_PeekLuosTask(void);
 void unittest_MsgAlloc_ClearMsgFromLuosTasks(void);
 void unittest_MsgAlloc_PullMsgFromTxTask(void);
 void unittest_MsgAlloc_PullServiceFromTxTask(void);
@@ -1336,6 +1336,54 @@ void unittest_MsgAlloc_LookAtLuosTask()
     }
 }
 
+void unittest_MsgAlloc_PeekLuosTask()
+{
+    NEW_TEST_CASE("Case FAILED");
+    MsgAlloc_Init(NULL);
+    {
+        ll_service_t *oldest_ll_service = (ll_service_t *)0xFF;
+        uint8_t cmd                     = 0xFF;
+        uint16_t size                   = 0xFF;
+
+        luos_tasks_stack_id = 0;
+
+        NEW_STEP("Check function returns FAILED when \"luos tasks stack id\" points to a void message");
+        TEST_ASSERT_EQUAL(FAILED, MsgAlloc_PeekLuosTask(0, &oldest_ll_service, &cmd, &size));
+        NEW_STEP("Check nothing is filled when required task ID points to a void message");
+        TEST_ASSERT_EQUAL((ll_service_t *)0xFF, oldest_ll_service);
+        TEST_ASSERT_EQUAL(0xFF, cmd);
+        TEST_ASSERT_EQUAL(0xFF, size);
+    }
+
+    NEW_TEST_CASE("Case SUCCEED");
+    MsgAlloc_Init(NULL);
+    {
+        msg_t message[MAX_MSG_NB];
+        ll_service_t *oldest_ll_service = NULL;
+        uint8_t cmd                     = 0;
+        uint16_t size                   = 0;
+
+        luos_tasks_stack_id = MAX_MSG_NB;
+        for (uintptr_t i = 0; i < MAX_MSG_NB; i++)
+        {
+            message[i].header.cmd       = (uint8_t)(i + 10);
+            message[i].header.size      = (uint16_t)(i * 3);
+            luos_tasks[i].msg_pt        = &message[i];
+            luos_tasks[i].ll_service_pt = (ll_service_t *)(i + 1);
+        }
+
+        for (uint16_t i = 0; i < MAX_MSG_NB; i++)
+        {
+            NEW_STEP_IN_LOOP("Check function returns SUCCEED", i);
+            TEST_ASSERT_EQUAL(SUCCEED, MsgAlloc_PeekLuosTask(i, &oldest_ll_service, &cmd, &size));
+            NEW_STEP_IN_LOOP("Check service, CMD and SIZE are filled together", i);
+            TEST_ASSERT_EQUAL((ll_service_t *)(uintptr_t)(i + 1), oldest_ll_service);
+            TEST_ASSERT_EQUAL(i + 10, cmd);
+            TEST_ASSERT_EQUAL(i * 3, size);
+        }
+    }
+}
+
 void unittest_MsgAlloc_GetLuosTaskSourceId()
 {
     NEW_TEST_CASE("Case FAILED");
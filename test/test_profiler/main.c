@@ -0,0 +1,115 @@
+#include "main.h"
+#include <stdio.h>
+#include <default_scenario.h>
+
+extern default_scenario_t default_sc;
+
+static void RecordDuration(profiler_probe_t probe, uint16_t index, uint32_t duration_us, uint32_t nb)
+{
+    for (uint32_t i = 0; i < nb; i++)
+    {
+        Profiler_Record(probe, index, Profiler_Start() - ((uint64_t)duration_us * 1000));
+    }
+}
+
+void unittest_Profiler_Record()
+{
+    NEW_TEST_CASE("Record execution times into histograms");
+    {
+        profiler_summary_t summary;
+        Profiler_Init();
+
+        NEW_STEP("Verify that an empty probe have an empty summary");
+        Profiler_GetSummary(PROFILER_ROBUS_HAL, 0, &summary);
+        TEST_ASSERT_EQUAL(0, summary.count);
+        TEST_ASSERT_EQUAL(0, summary.max_us);
+
+        NEW_STEP("Verify min, max and p99 of a probe");
+        RecordDuration(PROFILER_SERVICE_CB, 1, 40, 99);
+        RecordDuration(PROFILER_SERVICE_CB, 1, 3000, 1);
+        Profiler_GetSummary(PROFILER_SERVICE_CB, 1, &summary);
+        TEST_ASSERT_EQUAL(100, summary.count);
+        TEST_ASSERT_TRUE((summary.min_us >= 40) && (summary.min_us < 64));
+        TEST_ASSERT_TRUE((summary.max_us >= 3000) && (summary.max_us < 4096));
+        // The p99 is the upper bound of the [32, 64[ bucket
+        TEST_ASSERT_EQUAL(63, summary.p99_us);
+
+        NEW_STEP("Verify that the p99 never exceed the max");
+        RecordDuration(PROFILER_SERVICE_CB, 1, 3000, 9);
+        Profiler_GetSummary(PROFILER_SERVICE_CB, 1, &summary);
+        TEST_ASSERT_EQUAL(109, summary.count);
+        TEST_ASSERT_EQUAL(summary.max_us, summary.p99_us);
+
+        NEW_STEP("Verify that probes don't share their histograms");
+        Profiler_GetSummary(PROFILER_SERVICE_CB, 0, &summary);
+        TEST_ASSERT_EQUAL(0, summary.count);
+        Profiler_GetSummary(PROFILER_PACKAGE_LOOP, 1, &summary);
+        TEST_ASSERT_EQUAL(0, summary.count);
+
+        NEW_STEP("Verify that out of range indexes are ignored");
+        TEST_ASSERT_NULL(Profiler_GetHistogram(PROFILER_SERVICE_CB, MAX_SERVICE_NUMBER));
+        TEST_ASSERT_NULL(Profiler_GetHistogram(PROFILER_PROBE_NB, 0));
+        RecordDuration(PROFILER_PACKAGE_LOOP, MAX_SERVICE_NUMBER, 5, 1);
+
+        NEW_STEP("Verify that a full bucket keeps the shape of the histogram");
+        RecordDuration(PROFILER_LUOS_LOOP, 0, 80, 70000);
+        RecordDuration(PROFILER_LUOS_LOOP, 0, 3000, 10);
+        Profiler_GetSummary(PROFILER_LUOS_LOOP, 0, &summary);
+        TEST_ASSERT_EQUAL(70010, summary.count);
+        TEST_ASSERT_EQUAL(127, summary.p99_us);
+    }
+}
+
+void unittest_Profiler_Command()
+{
+    NEW_TEST_CASE("Get the profile of a service");
+    {
+        //  Init default scenario context
+        Init_Context();
+        profile_stats_t profile;
+        msg_t msg;
+        msg.header.target      = default_sc.App_2.app->ll_service->id;
+        msg.header.target_mode = SERVICEIDACK;
+        msg.header.cmd         = IO_STATE;
+        msg.header.size        = 1;
+        msg.data[0]            = 1;
+        Luos_SendMsg(default_sc.App_1.app, &msg);
+        Luos_Loop();
+
+        NEW_STEP("Verify that the service answer its profile");
+        msg.header.cmd  = LUOS_PROFILE;
+        msg.header.size = 0;
+        Luos_SendMsg(default_sc.App_1.app, &msg);
+        Luos_Loop();
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(LUOS_PROFILE, default_sc.App_1.last_rx_msg.header.cmd);
+        TEST_ASSERT_EQUAL(sizeof(profile_stats_t), default_sc.App_1.last_rx_msg.header.size);
+        memcpy(profile.unmap, default_sc.App_1.last_rx_msg.data, sizeof(profile_stats_t));
+
+        NEW_STEP("Verify that the profile contains the callback and the loops");
+        profiler_summary_t summary;
+        // App_2 is the second service of the node
+        Profiler_GetSummary(PROFILER_SERVICE_CB, 1, &summary);
+        TEST_ASSERT_TRUE(profile.service_cb.count > 0);
+        TEST_ASSERT_EQUAL(summary.count, profile.service_cb.count);
+        // Services created outside of a package don't have a package loop
+        TEST_ASSERT_EQUAL(0, profile.package_loop.count);
+        for (uint8_t i = 0; i < (PROFILER_PROBE_NB - PROFILER_LUOS_LOOP); i++)
+        {
+            TEST_ASSERT_TRUE(profile.node[i].count > 0);
+            TEST_ASSERT_TRUE(profile.node[i].min_us <= profile.node[i].p99_us);
+            TEST_ASSERT_TRUE(profile.node[i].p99_us <= profile.node[i].max_us);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    // Profiler functions
+    UNIT_TEST_RUN(unittest_Profiler_Record);
+    UNIT_TEST_RUN(unittest_Profiler_Command);
+
+    UNITY_END();
+}
@@ -0,0 +1,8 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+// Profiler functions
+void unittest_Profiler_Record(void);
+void unittest_Profiler_Command(void);
+
+#endif // MAIN_H
@@ -1,9 +1,13 @@
 #include "main.h"
 #include <stdio.h>
+#include <time.h>
+#include <stdlib.h>
 #include <default_scenario.h>
 
 extern default_scenario_t default_sc;
 
+bool RoutingTB_WaitRoutingTable(service_t *service, msg_t *intro_msg);
+
 void unittest_RTFilter_Reset(void)
 {
     NEW_TEST_CASE("Test the services in the result table");
@@ -29,11 +33,11 @@ void unittest_RTFilter_Reset(void)
 
         for (uint8_t i = 0; i < result.result_nbr; i++)
         {
-            TEST_ASSERT_EQUAL(i + 1, result.result_table[i]->id);
-            TEST_ASSERT_EQUAL(VOID_TYPE, result.result_table[i]->type);
+            TEST_ASSERT_EQUAL(i + 1, RTFilter_GetEntry(&result, i)->id);
+            TEST_ASSERT_EQUAL(VOID_TYPE, RTFilter_GetEntry(&result, i)->type);
 
             sprintf(alias, "Dummy_App_%d", i + 1);
-            alias_result = strcmp(alias, result.result_table[i]->alias);
+            alias_result = strcmp(alias, RTFilter_GetEntry(&result, i)->alias);
             TEST_ASSERT_EQUAL(0, alias_result);
         }
     }
@@ -177,7 +181,7 @@ void unittest_RTFilter_ID(void)
         TEST_ASSERT_EQUAL(ExpectedServiceNB, result.result_nbr);
 
         NEW_STEP("Verify that we have the right id");
-        TEST_ASSERT_EQUAL(2, result.result_table[0]->id);
+        TEST_ASSERT_EQUAL(2, RTFilter_GetEntry(&result, 0)->id);
 
         NEW_STEP("Verify that we have no service with id bigger than 3");
         ExpectedServiceNB = 0;
@@ -270,6 +274,413 @@ void unittest_RTFilter_Alias()
         TEST_ASSERT_EQUAL(ExpectedServiceNB, result.result_nbr);
     }
 }
+
+void unittest_RTFilter_Match(void)
+{
+    NEW_TEST_CASE("Test the combined filtering");
+    {
+        //  Init default scenario context
+        Init_Context();
+        revision_t revision = {.major = 1, .minor = 0, .build = 0};
+
+        Luos_CreateService(0, STATE_TYPE, "Custom_App", revision);
+        Luos_CreateService(0, STATE_TYPE, "Dummy_State", revision);
+
+        Luos_Detect(default_sc.App_1.app);
+        do
+        {
+            Luos_Loop();
+        } while (!Luos_IsNodeDetected());
+        //  Init variables
+        search_result_t result;
+        rt_filter_t filter = {.criteria = FILTER_TYPE | FILTER_ALIAS, .type = STATE_TYPE, .alias = "Dummy"};
+
+        NEW_STEP("Verify that all the criteria are applied");
+        RTFilter_Match(RTFilter_Reset(&result), &filter);
+        TEST_ASSERT_EQUAL(1, result.result_nbr);
+        TEST_ASSERT_EQUAL(5, RTFilter_GetEntry(&result, 0)->id);
+
+        NEW_STEP("Verify that the order of the results is kept");
+        filter.criteria = FILTER_ALIAS | FILTER_NODE;
+        filter.node_id  = 1;
+        RTFilter_Match(RTFilter_Reset(&result), &filter);
+        TEST_ASSERT_EQUAL(4, result.result_nbr);
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            TEST_ASSERT_EQUAL(i + 1, RTFilter_GetEntry(&result, i)->id);
+        }
+        TEST_ASSERT_EQUAL(5, RTFilter_GetEntry(&result, 3)->id);
+
+        NEW_STEP("Verify that a filter without criteria keep everything");
+        filter.criteria = 0;
+        RTFilter_Match(RTFilter_Reset(&result), &filter);
+        TEST_ASSERT_EQUAL(5, result.result_nbr);
+    }
+}
+
+void unittest_RTFilter_Refresh(void)
+{
+    NEW_TEST_CASE("Test the memoised research revalidation");
+    {
+        //  Init default scenario context
+        Init_Context();
+        //  Init variables
+        search_result_t result;
+        rt_filter_t filter = {.criteria = FILTER_TYPE, .type = VOID_TYPE};
+        uint32_t generation;
+
+        NEW_STEP("Verify that a cleared result is out of date");
+        memset(&result, 0, sizeof(search_result_t));
+        TEST_ASSERT_FALSE(RTFilter_IsUpToDate(&result));
+
+        NEW_STEP("Verify that a refreshed result is computed only once");
+        RTFilter_Refresh(&result, &filter);
+        TEST_ASSERT_TRUE(RTFilter_IsUpToDate(&result));
+        TEST_ASSERT_EQUAL(3, result.result_nbr);
+        // Hide a service without telling it to the routing table, the memoised result should not see it.
+        RTFilter_GetEntry(&result, 0)->type = STATE_TYPE;
+        RTFilter_Refresh(&result, &filter);
+        TEST_ASSERT_EQUAL(3, result.result_nbr);
+
+        NEW_STEP("Verify that a routing table modification invalidate the result");
+        generation = RoutingTB_GetGeneration();
+        RoutingTB_RemoveOnRoutingTable(3);
+        TEST_ASSERT_NOT_EQUAL(generation, RoutingTB_GetGeneration());
+        TEST_ASSERT_FALSE(RTFilter_IsUpToDate(&result));
+        RTFilter_Refresh(&result, &filter);
+        TEST_ASSERT_EQUAL(1, result.result_nbr);
+        TEST_ASSERT_EQUAL(2, RTFilter_GetEntry(&result, 0)->id);
+
+        NEW_STEP("Verify that erasing the routing table invalidate the result");
+        RoutingTB_Erase();
+        RTFilter_Refresh(&result, NULL);
+        TEST_ASSERT_EQUAL(0, result.result_nbr);
+    }
+}
+
+void unittest_RoutingTB_ReceiveChunk(void)
+{
+    NEW_TEST_CASE("Test the routing table reconstruction from out of order frames");
+    {
+        //  Init default scenario context
+        Init_Context();
+        //  Init variables
+        const uint16_t entry_nb = 30;
+        routing_table_t shared_table[entry_nb];
+        msg_t frames[entry_nb];
+        uint16_t frame_nb = 0;
+
+        memset(shared_table, 0, sizeof(shared_table));
+        RoutingTB_ConvertNodeToRoutingTable(&shared_table[0], Robus_GetNode());
+        for (uint16_t i = 1; i < entry_nb; i++)
+        {
+            shared_table[i].mode = SERVICE;
+            shared_table[i].id   = i;
+            shared_table[i].type = STATE_TYPE;
+            sprintf(shared_table[i].alias, "%c_shared_%d", 'a' + i, i);
+        }
+        for (uint16_t first_entry = 0; first_entry < entry_nb; frame_nb++)
+        {
+            first_entry += RoutingTB_EncodeFrame(&frames[frame_nb], shared_table, first_entry, entry_nb, entry_nb);
+            frames[frame_nb].header.cmd    = RTB_CHUNK;
+            frames[frame_nb].header.source = 1;
+        }
+        TEST_ASSERT_TRUE(frame_nb > 1);
+        RoutingTB_Erase();
+
+        NEW_STEP("Verify that the table is not computed until all the frames are received");
+        for (uint16_t i = frame_nb - 1; i > 0; i--)
+        {
+            RoutingTB_ReceiveChunk(&frames[i]);
+        }
+        TEST_ASSERT_EQUAL(0, RoutingTB_GetLastEntry());
+
+        NEW_STEP("Verify that a repeated frame is ignored");
+        RoutingTB_ReceiveChunk(&frames[frame_nb - 1]);
+        TEST_ASSERT_EQUAL(0, RoutingTB_GetLastEntry());
+
+        NEW_STEP("Verify that the table is complete with the missing frame");
+        RoutingTB_ReceiveChunk(&frames[0]);
+        TEST_ASSERT_EQUAL(entry_nb, RoutingTB_GetLastEntry());
+        TEST_ASSERT_EQUAL(0, memcmp(shared_table, RoutingTB_Get(), sizeof(shared_table)));
+    }
+}
+
+void unittest_RoutingTB_EncodeFrame(void)
+{
+    NEW_TEST_CASE("Test the compact routing table encoding");
+    {
+        //  Init default scenario context
+        Init_Context();
+        //  Init variables
+        const uint16_t entry_nb = 9;
+        routing_table_t local_table[entry_nb];
+        msg_t frame;
+
+        memset(local_table, 0, sizeof(local_table));
+        RoutingTB_ConvertNodeToRoutingTable(&local_table[0], Robus_GetNode());
+        for (uint16_t i = 1; i < entry_nb; i++)
+        {
+            local_table[i].mode   = SERVICE;
+            local_table[i].id     = 10 + i;
+            local_table[i].type   = (i < 5) ? STATE_TYPE : 300;
+            local_table[i].access = (i == 3) ? READ_ONLY_ACCESS : READ_WRITE_ACCESS;
+            sprintf(local_table[i].alias, (i < 7) ? "led" : "led_strip%d", i);
+        }
+
+        NEW_STEP("Verify that the encoded table is much smaller than the raw one");
+        TEST_ASSERT_EQUAL(entry_nb, RoutingTB_EncodeFrame(&frame, local_table, 0, entry_nb, entry_nb));
+        TEST_ASSERT_TRUE(frame.header.size < (entry_nb * sizeof(routing_table_t)) / 4);
+
+        NEW_STEP("Verify that a local routing table frame is decoded at the end of the routing table");
+        frame.header.cmd    = RTB;
+        frame.header.source = 1;
+        RoutingTB_ReceiveEntries(&frame);
+        TEST_ASSERT_EQUAL(4 + entry_nb, RoutingTB_GetLastEntry());
+        TEST_ASSERT_EQUAL(0, memcmp(local_table, &RoutingTB_Get()[4], sizeof(local_table)));
+
+        NEW_STEP("Verify that a frame with an unknown version is ignored");
+        frame.data[0] = 0xFF;
+        RoutingTB_ReceiveEntries(&frame);
+        TEST_ASSERT_EQUAL(4 + entry_nb, RoutingTB_GetLastEntry());
+    }
+}
+
+void unittest_RoutingTB_ReceiveEntries(void)
+{
+    NEW_TEST_CASE("Test the reception of a local routing table in several frames");
+    {
+        //  Init default scenario context
+        Init_Context();
+        //  Init variables
+        const uint16_t entry_nb = 30;
+        routing_table_t local_table[entry_nb];
+        msg_t frames[entry_nb];
+        uint16_t frame_nb = 0;
+
+        memset(local_table, 0, sizeof(local_table));
+        RoutingTB_ConvertNodeToRoutingTable(&local_table[0], Robus_GetNode());
+        for (uint16_t i = 1; i < entry_nb; i++)
+        {
+            local_table[i].mode = SERVICE;
+            local_table[i].id   = 10 + i;
+            local_table[i].type = STATE_TYPE;
+            sprintf(local_table[i].alias, "%c_local_%d", 'a' + i, i);
+        }
+        for (uint16_t first_entry = 0; first_entry < entry_nb; frame_nb++)
+        {
+            first_entry += RoutingTB_EncodeFrame(&frames[frame_nb], local_table, first_entry, entry_nb, entry_nb);
+            frames[frame_nb].header.cmd    = RTB;
+            frames[frame_nb].header.source = 1;
+        }
+        TEST_ASSERT_TRUE(frame_nb > 2);
+
+        NEW_STEP("Verify that a table missing a middle frame is not complete");
+        for (uint16_t i = 0; i < frame_nb; i++)
+        {
+            if (i != 1)
+            {
+                RoutingTB_ReceiveEntries(&frames[i]);
+            }
+        }
+        TEST_ASSERT_EQUAL(4, RoutingTB_GetLastEntry());
+        TEST_ASSERT_EQUAL(NODE, RoutingTB_Get()[4].mode);
+
+        NEW_STEP("Verify that the entries of an incomplete table are dropped when the node doesn't answer");
+        msg_t intro_msg;
+        uint16_t first_id            = 11;
+        intro_msg.header.cmd         = LOCAL_RTB;
+        intro_msg.header.target_mode = NODEIDACK;
+        intro_msg.header.target      = 2;
+        intro_msg.header.size        = sizeof(uint16_t);
+        memcpy(intro_msg.data, &first_id, sizeof(uint16_t));
+        TEST_ASSERT_FALSE(RoutingTB_WaitRoutingTable(default_sc.App_1.app, &intro_msg));
+        TEST_ASSERT_EQUAL(4, RoutingTB_GetLastEntry());
+        for (uint16_t i = 4; i < 4 + entry_nb; i++)
+        {
+            TEST_ASSERT_EQUAL(CLEAR, RoutingTB_Get()[i].mode);
+        }
+        TEST_ASSERT_EQUAL(0, RoutingTB_NodeIDFromID(10 + entry_nb - 1));
+
+        NEW_STEP("Verify that a table missing its first frame is not complete");
+        for (uint16_t i = 1; i < frame_nb; i++)
+        {
+            RoutingTB_ReceiveEntries(&frames[i]);
+        }
+        TEST_ASSERT_EQUAL(4, RoutingTB_GetLastEntry());
+
+        NEW_STEP("Verify that the table sent again is complete");
+        for (uint16_t i = 0; i < frame_nb; i++)
+        {
+            RoutingTB_ReceiveEntries(&frames[i]);
+        }
+        TEST_ASSERT_EQUAL(4 + entry_nb, RoutingTB_GetLastEntry());
+        TEST_ASSERT_EQUAL(0, memcmp(local_table, &RoutingTB_Get()[4], sizeof(local_table)));
+    }
+}
+
+void unittest_RoutingTB_AliasDuplication(void)
+{
+    NEW_TEST_CASE("Test the alias de-duplication during detection");
+    {
+        //  Init default scenario context
+        Init_Context();
+        revision_t revision = {.major = 1, .minor = 0, .build = 0};
+
+        Luos_CreateService(0, STATE_TYPE, "Dummy_App_1", revision);
+        Luos_CreateService(0, STATE_TYPE, "Dummy_App_1", revision);
+        Luos_CreateService(0, STATE_TYPE, "Dummy_App_11", revision);
+
+        Luos_Detect(default_sc.App_1.app);
+        do
+        {
+            Luos_Loop();
+        } while (!Luos_IsNodeDetected());
+
+        NEW_STEP("Verify that the first alias is kept");
+        TEST_ASSERT_EQUAL(1, RoutingTB_IDFromAlias("Dummy_App_1"));
+        NEW_STEP("Verify that duplicated aliases get the first free number");
+        TEST_ASSERT_EQUAL(0, strcmp("Dummy_App_12", RoutingTB_AliasFromId(4)));
+        TEST_ASSERT_EQUAL(0, strcmp("Dummy_App_13", RoutingTB_AliasFromId(5)));
+        TEST_ASSERT_EQUAL(6, RoutingTB_IDFromAlias("Dummy_App_11"));
+    }
+}
+
+static uint64_t unittest_GetTimeNs(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec * 1000000000 + time.tv_nsec;
+}
+
+void unittest_RoutingTB_SetStorage(void)
+{
+    NEW_TEST_CASE("Test the application routing table storage");
+    {
+        //  Init default scenario context
+        Init_Context();
+        //  Init variables
+        uint16_t storage[RTB_STORAGE_SIZE(10) / sizeof(uint16_t)];
+        search_result_t result;
+
+        NEW_STEP("Verify that the routing table is moved into the application storage");
+        TEST_ASSERT_EQUAL(SUCCEED, RoutingTB_SetStorage(storage, sizeof(storage), NULL));
+        TEST_ASSERT_EQUAL((routing_table_t *)storage, RoutingTB_Get());
+        TEST_ASSERT_EQUAL(4, RoutingTB_GetLastEntry());
+        RTFilter_Reset(&result);
+        TEST_ASSERT_EQUAL(3, result.result_nbr);
+        TEST_ASSERT_EQUAL(2, RoutingTB_IDFromAlias("Dummy_App_2"));
+
+        NEW_STEP("Verify that a fixed storage can't grow");
+        TEST_ASSERT_EQUAL(SUCCEED, RoutingTB_Reserve(9));
+        TEST_ASSERT_EQUAL(FAILED, RoutingTB_Reserve(10));
+
+        NEW_STEP("Verify that a too small storage is refused");
+        TEST_ASSERT_EQUAL(FAILED, RoutingTB_SetStorage(storage, RTB_STORAGE_SIZE(4), NULL));
+        TEST_ASSERT_EQUAL((routing_table_t *)storage, RoutingTB_Get());
+
+        NEW_STEP("Verify that we can go back to the default storage");
+        TEST_ASSERT_EQUAL(SUCCEED, RoutingTB_SetStorage(NULL, 0, NULL));
+        TEST_ASSERT_NOT_EQUAL((routing_table_t *)storage, RoutingTB_Get());
+        TEST_ASSERT_EQUAL(3, RoutingTB_IDFromAlias("Dummy_App_3"));
+    }
+}
+
+void unittest_RoutingTB_IndexBenchmark(void)
+{
+    NEW_TEST_CASE("Benchmark the routing table lookups on a big routing table");
+    {
+        const uint16_t node_nb             = 100;
+        const uint16_t service_per_node_nb = 9;
+        routing_table_t *routing_table;
+        uint16_t entry = 0;
+        uint16_t id    = 1;
+        char alias[MAX_ALIAS_SIZE];
+        search_result_t result;
+
+        //  Init default scenario context
+        Init_Context();
+        // Let the routing table grow with the network
+        TEST_ASSERT_EQUAL(SUCCEED, RoutingTB_SetStorage(NULL, 0, realloc));
+        RoutingTB_Erase();
+        TEST_ASSERT_EQUAL(SUCCEED, RoutingTB_Reserve(node_nb * (service_per_node_nb + 1)));
+        routing_table = RoutingTB_Get();
+        for (uint16_t node = 1; node <= node_nb; node++)
+        {
+            routing_table[entry].mode    = NODE;
+            routing_table[entry].node_id = node;
+            entry++;
+            for (uint16_t i = 0; i < service_per_node_nb; i++)
+            {
+                routing_table[entry].mode = SERVICE;
+                routing_table[entry].id   = id;
+                routing_table[entry].type = (node == 50) ? LIGHT_TYPE : STATE_TYPE;
+                sprintf(routing_table[entry].alias, "service_%d", id);
+                entry++;
+                id++;
+            }
+        }
+        RoutingTB_ComputeRoutingTableEntryNB();
+        TEST_ASSERT_EQUAL(node_nb * (service_per_node_nb + 1), RoutingTB_GetLastEntry());
+
+        NEW_STEP("Verify and measure alias, id and node lookups");
+        uint64_t start = unittest_GetTimeNs();
+        for (id = 1; id <= node_nb * service_per_node_nb; id++)
+        {
+            sprintf(alias, "service_%d", id);
+            TEST_ASSERT_EQUAL(id, RoutingTB_IDFromAlias(alias));
+            TEST_ASSERT_EQUAL(0, strcmp(alias, RoutingTB_AliasFromId(id)));
+            TEST_ASSERT_EQUAL(((id - 1) / service_per_node_nb) + 1, RoutingTB_NodeIDFromID(id));
+        }
+        uint64_t duration = unittest_GetTimeNs() - start;
+        printf("[INFO] %d entries: %d alias/id/node lookups in %lu us\n", RoutingTB_GetLastEntry(), 3 * (id - 1), (unsigned long)(duration / 1000));
+
+        NEW_STEP("Verify the filters on more than 255 services");
+        RTFilter_Reset(&result);
+        TEST_ASSERT_FALSE(result.truncated);
+        TEST_ASSERT_EQUAL(node_nb * service_per_node_nb, result.result_nbr);
+        TEST_ASSERT_EQUAL(900, RTFilter_GetEntry(&result, 899)->id);
+        RTFilter_Type(&result, LIGHT_TYPE);
+        TEST_ASSERT_EQUAL(service_per_node_nb, result.result_nbr);
+        TEST_ASSERT_EQUAL(49 * service_per_node_nb + 1, RTFilter_GetEntry(&result, 0)->id);
+
+        NEW_STEP("Verify that a result table too small for the routing table is reported");
+        uint16_t *small_table = malloc(100 * sizeof(uint16_t));
+        RESET_ASSERT();
+        RTFilter_ResetTable(&result, small_table, 100);
+        TEST_ASSERT_FALSE(IS_ASSERT());
+        TEST_ASSERT_TRUE(result.truncated);
+        TEST_ASSERT_EQUAL(100, result.result_nbr);
+        TEST_ASSERT_EQUAL(100, RTFilter_GetEntry(&result, 99)->id);
+        free(small_table);
+
+        NEW_STEP("Verify that a result table sized from the routing table keeps all the services");
+        uint16_t *table = malloc(RoutingTB_GetLastEntry() * sizeof(uint16_t));
+        RTFilter_ResetTable(&result, table, RoutingTB_GetLastEntry());
+        TEST_ASSERT_FALSE(result.truncated);
+        TEST_ASSERT_EQUAL(node_nb * service_per_node_nb, result.result_nbr);
+        RTFilter_Type(&result, LIGHT_TYPE);
+        TEST_ASSERT_EQUAL(service_per_node_nb, result.result_nbr);
+        TEST_ASSERT_TRUE(result.table == table);
+
+        NEW_STEP("Verify the lookups after removing a node");
+        RoutingTB_RemoveNode(2);
+        TEST_ASSERT_EQUAL(0, RoutingTB_IDFromAlias("service_10"));
+        TEST_ASSERT_EQUAL(19, RoutingTB_IDFromAlias("service_19"));
+        TEST_ASSERT_EQUAL(3, RoutingTB_NodeIDFromID(19));
+
+        NEW_STEP("Verify that a refresh keeps the result table");
+        RTFilter_Refresh(&result, NULL);
+        TEST_ASSERT_TRUE(result.table == table);
+        TEST_ASSERT_EQUAL((node_nb - 1) * service_per_node_nb, result.result_nbr);
+        free(table);
+
+        // Go back to the default storage
+        RoutingTB_Erase();
+        TEST_ASSERT_EQUAL(SUCCEED, RoutingTB_SetStorage(NULL, 0, NULL));
+    }
+}
+
 int main(int argc, char **argv)
 {
     UNITY_BEGIN();
@@ -282,6 +693,14 @@ int main(int argc, char **argv)
     UNIT_TEST_RUN(unittest_RTFilter_Service);
     UNIT_TEST_RUN(unittest_RTFilter_Node);
     UNIT_TEST_RUN(unittest_RTFilter_Alias);
+    UNIT_TEST_RUN(unittest_RTFilter_Match);
+    UNIT_TEST_RUN(unittest_RTFilter_Refresh);
+    UNIT_TEST_RUN(unittest_RoutingTB_ReceiveChunk);
+    UNIT_TEST_RUN(unittest_RoutingTB_EncodeFrame);
+    UNIT_TEST_RUN(unittest_RoutingTB_ReceiveEntries);
+    UNIT_TEST_RUN(unittest_RoutingTB_AliasDuplication);
+    UNIT_TEST_RUN(unittest_RoutingTB_SetStorage);
+    UNIT_TEST_RUN(unittest_RoutingTB_IndexBenchmark);
 
     UNITY_END();
 }
@@ -7,5 +7,13 @@ void unittest_RTFilter_InitCheck(void);
 void unittest_RTFilter_Type(void);
 void unittest_RTFilter_Node(void);
 void unittest_RTFilter_Alias(void);
+void unittest_RTFilter_Match(void);
+void unittest_RTFilter_Refresh(void);
+void unittest_RoutingTB_ReceiveChunk(void);
+void unittest_RoutingTB_EncodeFrame(void);
+void unittest_RoutingTB_ReceiveEntries(void);
+void unittest_RoutingTB_AliasDuplication(void);
+void unittest_RoutingTB_SetStorage(void);
+void unittest_RoutingTB_IndexBenchmark(void);
 
 #endif // MAIN_H
\ No newline at end of file
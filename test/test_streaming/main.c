@@ -0,0 +1,178 @@
+#include "main.h"
+#include <stdio.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <default_scenario.h>
+
+#define STRESS_SAMPLE_NB  200000  // Samples sent through the channel
+#define STRESS_BUFFER_NB  64      // Ring buffer size in samples
+#define STRESS_CHUNK_MAX  17      // Maximum samples moved at once
+#define STRESS_TIMEOUT_S  60      // Maximum duration of a stress test
+
+typedef struct
+{
+    spsc_channel_t stream;
+    uint32_t buffer[STRESS_BUFFER_NB];
+    bool in_place;         // Use the pointers instead of copies
+    volatile bool timeout; // The consumer gave up
+} stress_t;
+
+static stress_t stress;
+
+/******************************************************************************
+ * @brief Put consecutive samples in the channel, run by the producer thread
+ * @param arg : Unused
+ * @return None
+ ******************************************************************************/
+static void *Stress_Producer(void *arg)
+{
+    uint32_t chunk[STRESS_CHUNK_MAX];
+    uint32_t sequence = 0;
+    uint16_t size     = 0;
+
+    (void)arg;
+    while ((sequence < STRESS_SAMPLE_NB) && (stress.timeout == false))
+    {
+        // Change the chunk size on each put to cross the ring buffer end everywhere
+        size = (uint16_t)((sequence % STRESS_CHUNK_MAX) + 1);
+        if (size > (STRESS_SAMPLE_NB - sequence))
+        {
+            size = STRESS_SAMPLE_NB - sequence;
+        }
+        if (stress.in_place)
+        {
+            uint32_t *data_ptr = (uint32_t *)Stream_SpscGetDataPtr(&stress.stream);
+            uint16_t free_nb   = Stream_SpscGetFreeSampleNBUntilEndBuffer(&stress.stream);
+            if (size > free_nb)
+            {
+                size = free_nb;
+            }
+            for (uint16_t i = 0; i < size; i++)
+            {
+                data_ptr[i] = sequence + i;
+            }
+            Stream_SpscAddAvailableSampleNB(&stress.stream, size);
+            sequence += size;
+        }
+        else
+        {
+            for (uint16_t i = 0; i < size; i++)
+            {
+                chunk[i] = sequence + i;
+            }
+            sequence += Stream_SpscPutSample(&stress.stream, chunk, size);
+        }
+        if (size == 0)
+        {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/******************************************************************************
+ * @brief Get the samples from the channel and check they are consecutive
+ * @param None
+ * @return Number of samples received in sequence
+ ******************************************************************************/
+static uint32_t Stress_Consumer(void)
+{
+    uint32_t chunk[STRESS_CHUNK_MAX];
+    uint32_t sequence = 0;
+    uint16_t size     = 0;
+    time_t start_date = time(NULL);
+
+    while (sequence < STRESS_SAMPLE_NB)
+    {
+        if ((time(NULL) - start_date) > STRESS_TIMEOUT_S)
+        {
+            stress.timeout = true;
+            break;
+        }
+        // Use another chunk size than the producer
+        size = (uint16_t)((sequence % (STRESS_CHUNK_MAX - 4)) + 1);
+        if (stress.in_place)
+        {
+            uint32_t *sample_ptr = (uint32_t *)Stream_SpscGetSamplePtr(&stress.stream);
+            uint16_t available   = Stream_SpscGetAvailableSampleNBUntilEndBuffer(&stress.stream);
+            if (size > available)
+            {
+                size = available;
+            }
+            memcpy(chunk, sample_ptr, size * sizeof(uint32_t));
+            Stream_SpscRmvAvailableSampleNB(&stress.stream, size);
+        }
+        else
+        {
+            size = Stream_SpscGetSample(&stress.stream, chunk, size);
+        }
+        for (uint16_t i = 0; i < size; i++)
+        {
+            if (chunk[i] != sequence)
+            {
+                // Stop on the first sample lost, duplicated or corrupted
+                stress.timeout = true;
+                return sequence;
+            }
+            sequence++;
+        }
+        if (size == 0)
+        {
+            sched_yield();
+        }
+    }
+    return sequence;
+}
+
+/******************************************************************************
+ * @brief Run a producer thread against the consumer on the main thread
+ * @param in_place : Use the pointers instead of copies
+ * @return Number of samples received in sequence
+ ******************************************************************************/
+static uint32_t Stress_Run(bool in_place)
+{
+    pthread_t producer;
+    uint32_t received = 0;
+
+    memset(&stress, 0, sizeof(stress));
+    stress.stream   = Stream_CreateSpscChannel(stress.buffer, STRESS_BUFFER_NB, sizeof(uint32_t));
+    stress.in_place = in_place;
+    TEST_ASSERT_EQUAL(0, pthread_create(&producer, NULL, Stress_Producer, NULL));
+    received = Stress_Consumer();
+    pthread_join(producer, NULL);
+    return received;
+}
+
+void unittest_Spsc_CopyStress()
+{
+    NEW_TEST_CASE("Share a lock free channel between a producer and a consumer thread");
+    {
+        NEW_STEP("Verify that all the samples are received in sequence");
+        TEST_ASSERT_EQUAL(STRESS_SAMPLE_NB, Stress_Run(false));
+        TEST_ASSERT_FALSE(stress.timeout);
+        TEST_ASSERT_EQUAL(0, Stream_SpscGetAvailableSampleNB(&stress.stream));
+    }
+}
+
+void unittest_Spsc_InPlaceStress()
+{
+    NEW_TEST_CASE("Fill and empty a lock free channel in place from two threads");
+    {
+        NEW_STEP("Verify that all the samples are received in sequence");
+        TEST_ASSERT_EQUAL(STRESS_SAMPLE_NB, Stress_Run(true));
+        TEST_ASSERT_FALSE(stress.timeout);
+        TEST_ASSERT_EQUAL(0, Stream_SpscGetAvailableSampleNB(&stress.stream));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    // Lock free streaming channel functions
+    UNIT_TEST_RUN(unittest_Spsc_CopyStress);
+    UNIT_TEST_RUN(unittest_Spsc_InPlaceStress);
+
+    UNITY_END();
+}
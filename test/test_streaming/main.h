@@ -0,0 +1,8 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+// Lock free streaming channel functions
+void unittest_Spsc_CopyStress(void);
+void unittest_Spsc_InPlaceStress(void);
+
+#endif // MAIN_H
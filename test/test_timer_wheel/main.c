@@ -0,0 +1,195 @@
+#include "main.h"
+#include <stdio.h>
+#include <default_scenario.h>
+
+#define TIMER_NB 64
+
+extern default_scenario_t default_sc;
+
+typedef struct
+{
+    luos_timer_t timer;
+    uint64_t date;       // Expected expiration date
+    uint64_t expired_at; // Date of the last expiration
+    uint32_t count;      // Number of expirations
+} test_timer_t;
+
+static test_timer_t test_timer[TIMER_NB];
+static uint32_t expiration_rank;
+
+static void TimerHandler(void *arg)
+{
+    test_timer_t *test = (test_timer_t *)arg;
+    test->expired_at   = TimerWheel_Now();
+    test->count++;
+    // Save the expiration rank into the expected date to check the order
+    test->date = ((test->date & 0xFFFFFFFFFFFF) | ((uint64_t)expiration_rank++ << 48));
+}
+
+static void StopHandler(void *arg)
+{
+    TimerWheel_Stop((luos_timer_t *)arg);
+}
+
+static void RunWheelUntil(uint64_t date)
+{
+    while (TimerWheel_Now() < date)
+    {
+        TimerWheel_Loop();
+    }
+    TimerWheel_Loop();
+}
+
+void unittest_TimerWheel_Start()
+{
+    NEW_TEST_CASE("Start and stop timers");
+    {
+        //  Init default scenario context
+        Init_Context();
+        memset(test_timer, 0, sizeof(test_timer));
+        uint64_t start_date;
+
+        NEW_STEP("Verify that a timer can't be started without callback");
+        TEST_ASSERT_EQUAL(FAILED, TimerWheel_Start(&test_timer[0].timer, 100, 0, NULL, NULL));
+        TEST_ASSERT_FALSE(TimerWheel_IsRunning(&test_timer[0].timer));
+
+        NEW_STEP("Verify that a one shot timer expire once after its delay");
+        start_date = TimerWheel_Now();
+        TEST_ASSERT_EQUAL(SUCCEED, TimerWheel_Start(&test_timer[0].timer, 500, 0, TimerHandler, &test_timer[0]));
+        TEST_ASSERT_TRUE(TimerWheel_IsRunning(&test_timer[0].timer));
+        TEST_ASSERT_TRUE(TimerWheel_NextEvent() <= 500);
+        RunWheelUntil(start_date + 2000);
+        TEST_ASSERT_EQUAL(1, test_timer[0].count);
+        TEST_ASSERT_TRUE(test_timer[0].expired_at >= start_date + 500);
+        TEST_ASSERT_FALSE(TimerWheel_IsRunning(&test_timer[0].timer));
+        TEST_ASSERT_EQUAL(TIMER_WHEEL_NO_EVENT, TimerWheel_NextEvent());
+
+        NEW_STEP("Verify that a periodic timer expire on each period");
+        start_date = TimerWheel_Now();
+        TimerWheel_Start(&test_timer[1].timer, 100, 100, TimerHandler, &test_timer[1]);
+        RunWheelUntil(start_date + 1050);
+        TEST_ASSERT_EQUAL(10, test_timer[1].count);
+        TEST_ASSERT_TRUE(TimerWheel_IsRunning(&test_timer[1].timer));
+
+        NEW_STEP("Verify that a stopped timer don't expire anymore");
+        TimerWheel_Stop(&test_timer[1].timer);
+        TEST_ASSERT_FALSE(TimerWheel_IsRunning(&test_timer[1].timer));
+        RunWheelUntil(TimerWheel_Now() + 500);
+        TEST_ASSERT_EQUAL(10, test_timer[1].count);
+
+        NEW_STEP("Verify that a periodic timer can be stopped by its own callback");
+        TimerWheel_Start(&test_timer[2].timer, 100, 100, StopHandler, &test_timer[2].timer);
+        RunWheelUntil(TimerWheel_Now() + 500);
+        TEST_ASSERT_FALSE(TimerWheel_IsRunning(&test_timer[2].timer));
+
+        NEW_STEP("Verify that a late periodic timer skip the missed periods");
+        start_date = TimerWheel_Now();
+        test_timer[3].count = 0;
+        TimerWheel_Start(&test_timer[3].timer, 100, 100, TimerHandler, &test_timer[3]);
+        while (TimerWheel_Now() < start_date + 1050)
+            ;
+        TimerWheel_Loop();
+        TEST_ASSERT_EQUAL(1, test_timer[3].count);
+        TEST_ASSERT_TRUE(TimerWheel_NextEvent() <= 100);
+        TimerWheel_Stop(&test_timer[3].timer);
+    }
+}
+
+void unittest_TimerWheel_Order()
+{
+    NEW_TEST_CASE("Expire timers in order on all the wheel levels");
+    {
+        //  Init default scenario context
+        Init_Context();
+        memset(test_timer, 0, sizeof(test_timer));
+        expiration_rank     = 0;
+        uint64_t start_date = TimerWheel_Now();
+        uint32_t delay;
+
+        NEW_STEP("Start timers with delays from 1us to 100ms");
+        for (uint16_t i = 0; i < TIMER_NB; i++)
+        {
+            // Spread delays on the levels and mix them to not start them in order
+            delay = 1 + ((i * 37) % TIMER_NB) * ((i % 2) ? 1570 : 13);
+            TEST_ASSERT_EQUAL(SUCCEED, TimerWheel_Start(&test_timer[i].timer, delay, 0, TimerHandler, &test_timer[i]));
+            // Take the date the wheel computed, the clock may tick between two reads
+            test_timer[i].date = test_timer[i].timer.expiry;
+        }
+        RunWheelUntil(start_date + 110000);
+
+        NEW_STEP("Verify that all timers expired once, not before their date");
+        for (uint16_t i = 0; i < TIMER_NB; i++)
+        {
+            TEST_ASSERT_EQUAL(1, test_timer[i].count);
+            TEST_ASSERT_TRUE(test_timer[i].expired_at >= (test_timer[i].date & 0xFFFFFFFFFFFF));
+        }
+
+        NEW_STEP("Verify that timers expired in the order of their date");
+        for (uint16_t i = 0; i < TIMER_NB; i++)
+        {
+            for (uint16_t j = 0; j < TIMER_NB; j++)
+            {
+                if ((test_timer[i].date & 0xFFFFFFFFFFFF) < (test_timer[j].date & 0xFFFFFFFFFFFF))
+                {
+                    TEST_ASSERT_TRUE((test_timer[i].date >> 48) < (test_timer[j].date >> 48));
+                }
+            }
+        }
+    }
+}
+
+void unittest_TimerWheel_AutoUpdate()
+{
+    NEW_TEST_CASE("Auto update with a sub millisecond period");
+    {
+        //  Init default scenario context
+        Init_Context();
+        time_luos_t period = TimeOD_TimeFrom_us(200);
+        msg_t msg;
+        msg.header.target      = default_sc.App_2.app->ll_service->id;
+        msg.header.target_mode = SERVICEIDACK;
+        TimeOD_TimeToMsg(&period, &msg);
+        msg.header.cmd = UPDATE_PUB;
+
+        NEW_STEP("Verify that the service is updated at the asked period");
+        Luos_SendMsg(default_sc.App_1.app, &msg);
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(200, default_sc.App_2.app->auto_refresh[0].period_us);
+        memset(&default_sc.App_2.last_rx_msg, 0, sizeof(msg_t));
+        uint64_t start_date = TimerWheel_Now();
+        while (default_sc.App_2.last_rx_msg.header.cmd != GET_CMD)
+        {
+            Luos_Loop();
+            TEST_ASSERT_TRUE(TimerWheel_Now() - start_date < 1000);
+        }
+        TEST_ASSERT_EQUAL(default_sc.App_1.app->ll_service->id, default_sc.App_2.last_rx_msg.header.source);
+
+        NEW_STEP("Verify that a null period stop the update");
+        period = TimeOD_TimeFrom_us(0);
+        TimeOD_TimeToMsg(&period, &msg);
+        msg.header.cmd = UPDATE_PUB;
+        Luos_SendMsg(default_sc.App_1.app, &msg);
+        Luos_Loop();
+        TEST_ASSERT_EQUAL(0, default_sc.App_2.app->auto_refresh[0].period_us);
+        memset(&default_sc.App_2.last_rx_msg, 0, sizeof(msg_t));
+        start_date = TimerWheel_Now();
+        while (TimerWheel_Now() - start_date < 1000)
+        {
+            Luos_Loop();
+        }
+        TEST_ASSERT_EQUAL(0, default_sc.App_2.last_rx_msg.header.cmd);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    // Timer wheel functions
+    UNIT_TEST_RUN(unittest_TimerWheel_Start);
+    UNIT_TEST_RUN(unittest_TimerWheel_Order);
+    // Luos auto update
+    UNIT_TEST_RUN(unittest_TimerWheel_AutoUpdate);
+
+    UNITY_END();
+}
@@ -0,0 +1,9 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+// Timer wheel functions
+void unittest_TimerWheel_Start(void);
+void unittest_TimerWheel_Order(void);
+void unittest_TimerWheel_AutoUpdate(void);
+
+#endif // MAIN_H
@@ -1,5 +1,6 @@
 #include "main.h"
 #include <stdio.h>
+#include <math.h>
 #include <default_scenario.h>
 
 extern volatile uint8_t msg_buffer[MSG_BUFFER_SIZE];
@@ -79,6 +80,13 @@ void unittest_Timestamp()
         time_elapsed = TimeOD_TimeFrom_s(TimeOD_TimeTo_s(rx_event_b_timestamp) - TimeOD_TimeTo_s(rx_event_a_timestamp));
         // Verify
         TEST_ASSERT_EQUAL(((TimeOD_TimeTo_ms(time_elapsed) > 1.15) && (TimeOD_TimeTo_ms(time_elapsed) < 1.25)), true);
+
+        NEW_STEP("Timestamps are integer ns");
+        int64_t rx_event_b_ns = 0;
+        memcpy(&rx_event_b_ns, &rx_msg->data[rx_msg->header.size], sizeof(int64_t));
+        TEST_ASSERT_EQUAL(sizeof(int64_t), TIMESTAMP_SIZE);
+        TEST_ASSERT_TRUE(rx_event_b_ns == Timestamp_GetTimestampNs(rx_msg));
+        TEST_ASSERT_TRUE(fabs(TimeOD_TimeTo_ns(rx_event_b_timestamp) - (double)rx_event_b_ns) < 1.0);
     }
 }
 
@@ -0,0 +1,248 @@
+#include "main.h"
+#include <stdio.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <default_scenario.h>
+#include "_timestamp.h"
+
+#define WORKER_MSG_NB  40
+#define WORKER_TIMEOUT 10000 // Maximum time to wait for the workers in ms
+
+typedef enum
+{
+    WORKER_CMD = LUOS_LAST_STD_CMD, // Message counted by the apps
+    ECHO_CMD,                       // Ask for a timestamped answer
+} worker_cmd_t;
+
+typedef struct
+{
+    service_t *service;
+    pthread_t thread[WORKER_MSG_NB];   // Thread running each callback
+    uint16_t sequence[WORKER_MSG_NB];  // Sequence of each message received
+    volatile uint16_t nb;              // Number of messages received
+    volatile bool hold;                // Block the callback to fill the worker queue
+    volatile bool timestamped;         // The answer to ECHO_CMD kept its timestamp
+    volatile int64_t date_ns;          // Date of the answer to ECHO_CMD
+} worker_app_t;
+
+static worker_app_t worker_app[2];
+
+/******************************************************************************
+ * @brief Record the messages received, run by the workers
+ * @param service destination
+ * @param Msg receive
+ * @return None
+ ******************************************************************************/
+static void Worker_MsgHandler(service_t *service, msg_t *msg)
+{
+    worker_app_t *app = (service == worker_app[0].service) ? &worker_app[0] : &worker_app[1];
+
+    while (app->hold)
+    {
+        usleep(100);
+    }
+    if (msg->header.cmd == WORKER_CMD)
+    {
+        if (app->nb < WORKER_MSG_NB)
+        {
+            memcpy(&app->sequence[app->nb], msg->data, sizeof(uint16_t));
+            app->thread[app->nb] = pthread_self();
+        }
+        app->nb++;
+    }
+    else if (msg->header.cmd == ECHO_CMD)
+    {
+        // Answer from this worker with the date received
+        msg_t answer;
+        int64_t date_ns;
+        memcpy(&date_ns, msg->data, sizeof(int64_t));
+        answer.header.target      = msg->header.source;
+        answer.header.target_mode = SERVICEIDACK;
+        answer.header.cmd         = WORKER_CMD;
+        answer.header.size        = sizeof(uint16_t);
+        memset(answer.data, 0, sizeof(uint16_t));
+        Luos_SendTimestampMsg(service, &answer, TimeOD_TimeFrom_ns((double)date_ns));
+    }
+    if (Timestamp_IsTimestampMsg(msg))
+    {
+        app->date_ns     = Timestamp_GetTimestampNs(msg);
+        app->timestamped = true;
+    }
+}
+
+/******************************************************************************
+ * @brief Create 2 services running on workers and detect them
+ * @param None
+ * @return None
+ ******************************************************************************/
+static void Worker_Context(void)
+{
+    RESET_ASSERT();
+    Luos_ServicesClear();
+    RoutingTB_Erase();
+    Luos_Init();
+    Luos_Loop();
+
+    RESET_ASSERT();
+    Luos_Init();
+    memset(worker_app, 0, sizeof(worker_app));
+    revision_t revision   = {.major = 1, .minor = 0, .build = 0};
+    worker_app[0].service = Luos_CreateService(Worker_MsgHandler, VOID_TYPE, "Worker_App_1", revision);
+    worker_app[1].service = Luos_CreateService(Worker_MsgHandler, VOID_TYPE, "Worker_App_2", revision);
+
+    Luos_Detect(worker_app[0].service);
+    do
+    {
+        Luos_Loop();
+    } while (!Luos_IsNodeDetected());
+    Luos_Loop();
+    TEST_ASSERT_FALSE(IS_ASSERT());
+}
+
+/******************************************************************************
+ * @brief Send a counted message from an app to the other
+ * @param source : App sending
+ * @param target : App receiving
+ * @param sequence : Sequence number of the message
+ * @return None
+ ******************************************************************************/
+static void Worker_Send(worker_app_t *source, worker_app_t *target, uint16_t sequence)
+{
+    msg_t msg;
+    msg.header.target      = target->service->ll_service->id;
+    msg.header.target_mode = SERVICEIDACK;
+    msg.header.cmd         = WORKER_CMD;
+    msg.header.size        = sizeof(uint16_t);
+    memcpy(msg.data, &sequence, sizeof(uint16_t));
+    TEST_ASSERT_EQUAL(SUCCEED, Luos_SendMsg(source->service, &msg));
+    Luos_Loop();
+}
+
+/******************************************************************************
+ * @brief Run Luos until both apps received their messages
+ * @param nb_0 : Number of messages app 0 have to receive
+ * @param nb_1 : Number of messages app 1 have to receive
+ * @return None
+ ******************************************************************************/
+static void Worker_Wait(uint16_t nb_0, uint16_t nb_1)
+{
+    uint32_t start_date = LuosHAL_GetSystick();
+    while (((worker_app[0].nb < nb_0) || (worker_app[1].nb < nb_1)) && ((LuosHAL_GetSystick() - start_date) < WORKER_TIMEOUT))
+    {
+        Luos_Loop();
+        usleep(100);
+    }
+    TEST_ASSERT_EQUAL(nb_0, worker_app[0].nb);
+    TEST_ASSERT_EQUAL(nb_1, worker_app[1].nb);
+}
+
+void unittest_Worker_Order()
+{
+    NEW_TEST_CASE("Callbacks of a service run in order");
+    {
+        Worker_Context();
+
+        NEW_STEP("Verify that each service receives its messages in order");
+        for (uint16_t i = 0; i < WORKER_MSG_NB; i++)
+        {
+            Worker_Send(&worker_app[0], &worker_app[1], i);
+            Worker_Send(&worker_app[1], &worker_app[0], i);
+        }
+        Worker_Wait(WORKER_MSG_NB, WORKER_MSG_NB);
+        for (uint16_t i = 0; i < WORKER_MSG_NB; i++)
+        {
+            TEST_ASSERT_EQUAL(i, worker_app[0].sequence[i]);
+            TEST_ASSERT_EQUAL(i, worker_app[1].sequence[i]);
+        }
+    }
+}
+
+void unittest_Worker_Pin()
+{
+    NEW_TEST_CASE("Run the callbacks of a service on a pinned worker");
+    {
+        Worker_Context();
+
+        NEW_STEP("Verify that only existing workers can be pinned");
+        TEST_ASSERT_EQUAL(FAILED, Luos_SetServiceWorker(worker_app[0].service, LUOS_WORKER_NB));
+        TEST_ASSERT_EQUAL(SUCCEED, Luos_SetServiceWorker(worker_app[0].service, 0));
+        TEST_ASSERT_EQUAL(SUCCEED, Luos_SetServiceWorker(worker_app[1].service, 1));
+
+        NEW_STEP("Verify that all the callbacks of a service run on its worker");
+        for (uint16_t i = 0; i < WORKER_MSG_NB; i++)
+        {
+            Worker_Send(&worker_app[0], &worker_app[1], i);
+            Worker_Send(&worker_app[1], &worker_app[0], i);
+        }
+        Worker_Wait(WORKER_MSG_NB, WORKER_MSG_NB);
+        for (uint16_t i = 1; i < WORKER_MSG_NB; i++)
+        {
+            TEST_ASSERT_TRUE(pthread_equal(worker_app[0].thread[0], worker_app[0].thread[i]));
+            TEST_ASSERT_TRUE(pthread_equal(worker_app[1].thread[0], worker_app[1].thread[i]));
+        }
+        TEST_ASSERT_FALSE(pthread_equal(worker_app[0].thread[0], worker_app[1].thread[0]));
+
+        NEW_STEP("Verify that a service can be unpinned");
+        TEST_ASSERT_EQUAL(SUCCEED, Luos_SetServiceWorker(worker_app[0].service, -1));
+        TEST_ASSERT_EQUAL(SUCCEED, Luos_SetServiceWorker(worker_app[1].service, -1));
+    }
+}
+
+void unittest_Worker_FullQueue()
+{
+    NEW_TEST_CASE("Keep the messages of a late worker");
+    {
+        Worker_Context();
+
+        NEW_STEP("Verify that messages are kept while the worker queue is full");
+        worker_app[1].hold = true;
+        for (uint16_t i = 0; i < (2 * LUOS_WORKER_QUEUE_SIZE); i++)
+        {
+            Worker_Send(&worker_app[0], &worker_app[1], i);
+        }
+        TEST_ASSERT_EQUAL(0, worker_app[1].nb);
+        TEST_ASSERT_FALSE(IS_ASSERT());
+
+        NEW_STEP("Verify that they are all given in order when the worker is back");
+        worker_app[1].hold = false;
+        Worker_Wait(0, 2 * LUOS_WORKER_QUEUE_SIZE);
+        for (uint16_t i = 0; i < (2 * LUOS_WORKER_QUEUE_SIZE); i++)
+        {
+            TEST_ASSERT_EQUAL(i, worker_app[1].sequence[i]);
+        }
+    }
+}
+
+void unittest_Worker_TimestampMsg()
+{
+    NEW_TEST_CASE("Send a timestamped message from a worker");
+    {
+        msg_t msg;
+        int64_t date_ns = (int64_t)LuosHAL_GetTimestamp() - 1000000;
+        Worker_Context();
+
+        NEW_STEP("Verify that the timestamp is kept");
+        msg.header.target      = worker_app[1].service->ll_service->id;
+        msg.header.target_mode = SERVICEIDACK;
+        msg.header.cmd         = ECHO_CMD;
+        msg.header.size        = sizeof(int64_t);
+        memcpy(msg.data, &date_ns, sizeof(int64_t));
+        TEST_ASSERT_EQUAL(SUCCEED, Luos_SendMsg(worker_app[0].service, &msg));
+        Worker_Wait(1, 0);
+        TEST_ASSERT_TRUE(worker_app[0].timestamped);
+        TEST_ASSERT_TRUE((worker_app[0].date_ns > (date_ns - 1000000)) && (worker_app[0].date_ns < (date_ns + 1000000)));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    // Service worker functions
+    UNIT_TEST_RUN(unittest_Worker_Order);
+    UNIT_TEST_RUN(unittest_Worker_Pin);
+    UNIT_TEST_RUN(unittest_Worker_FullQueue);
+    UNIT_TEST_RUN(unittest_Worker_TimestampMsg);
+
+    UNITY_END();
+}
@@ -0,0 +1,10 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+// Service worker functions
+void unittest_Worker_Order(void);
+void unittest_Worker_Pin(void);
+void unittest_Worker_FullQueue(void);
+void unittest_Worker_TimestampMsg(void);
+
+#endif // MAIN_H
@@ -120,7 +120,7 @@ void Convert_DataToLuos(service_t *service, char *data)
             while (parameter_jsn != NULL)
             {
                 char *property = (char *)json_getName(parameter_jsn);
-                Convert_JsonToMsg(service, result.result_table[0]->id, result.result_table[0]->type, property, parameter_jsn, &msg, (char *)data);
+                Convert_JsonToMsg(service, RTFilter_GetEntry(&result, 0)->id, RTFilter_GetEntry(&result, 0)->type, property, parameter_jsn, &msg, (char *)data);
                 parameter_jsn = json_getSibling(parameter_jsn);
             }
             // Get next service
@@ -549,6 +549,14 @@ void Convert_JsonToMsg(service_t *service, uint16_t id, luos_type_t type, char *
         Luos_SendMsg(service, msg);
         return;
     }
+    // Luos PROFILE
+    if (property && !strcmp(property, "luos_profile"))
+    {
+        msg->header.cmd  = LUOS_PROFILE;
+        msg->header.size = 0;
+        Luos_SendMsg(service, msg);
+        return;
+    }
     // Parameters
     if (property && !strcmp(property, "parameters"))
     {
@@ -745,16 +753,34 @@ uint16_t Convert_MsgToData(msg_t *msg, char *data)
             {
                 general_stats_t *stat = (general_stats_t *)msg->data;
                 // create the Json content
-                sprintf(data, "\"luos_statistics\":{\"rx_msg_stack\":%d,\"luos_stack\":%d,\"tx_msg_stack\":%d,\"buffer_occupation\":%d,\"msg_drop\":%d,\"loop_ms\":%d,\"max_retry\":%d},",
+                sprintf(data, "\"luos_statistics\":{\"rx_msg_stack\":%d,\"luos_stack\":%d,\"tx_msg_stack\":%d,\"buffer_occupation\":%d,\"msg_drop\":%d,\"loop_ms\":%d,\"deadline_miss\":%d,\"max_retry\":%d},",
                         stat->node_stat.memory.rx_msg_stack_ratio,
                         stat->node_stat.memory.engine_msg_stack_ratio,
                         stat->node_stat.memory.tx_msg_stack_ratio,
                         stat->node_stat.memory.buffer_occupation_ratio,
                         stat->node_stat.memory.msg_drop_number,
                         stat->node_stat.max_loop_time_ms,
+                        stat->node_stat.package_deadline_miss,
                         stat->service_stat.max_retry);
             }
             break;
+        case LUOS_PROFILE:
+            if (msg->header.size == sizeof(profile_stats_t))
+            {
+                profile_stats_t *profile = (profile_stats_t *)msg->data;
+                const char *name[PROFILER_PROBE_NB] = {"callback", "package_loop", "luos_loop", "robus_timeout", "robus_msg_alloc", "robus_interpret", "robus_hal"};
+                profiler_summary_t *summary         = &profile->service_cb;
+                // create the Json content, each probe is [count, min_us, p99_us, max_us]
+                char *data_ptr = data;
+                data_ptr += sprintf(data_ptr, "\"luos_profile\":{");
+                for (uint8_t i = 0; i < PROFILER_PROBE_NB; i++)
+                {
+                    data_ptr += sprintf(data_ptr, "\"%s\":[%lu,%lu,%lu,%lu],", name[i], (unsigned long)summary[i].count, (unsigned long)summary[i].min_us, (unsigned long)summary[i].p99_us, (unsigned long)summary[i].max_us);
+                }
+                // replace the last "," by the end of the profile
+                sprintf(data_ptr - 1, "},");
+            }
+            break;
         case IO_STATE:
             // check size
             if (msg->header.size == sizeof(char))
@@ -931,7 +957,7 @@ void Convert_ExcludedServiceData(service_t *service)
     char json[300];
     search_result_t result;
     RTFilter_ID(RTFilter_Reset(&result), service->ll_service->dead_service_spotted);
-    sprintf(json, "{\"dead_service\":\"%s\"}\n", result.result_table[0]->alias);
+    sprintf(json, "{\"dead_service\":\"%s\"}\n", RTFilter_GetEntry(&result, 0)->alias);
     // Send the message to pipe
     PipeLink_Send(service, json, strlen(json));
 }
@@ -17,7 +17,7 @@ uint8_t DataManager_ServiceIsSensor(luos_type_t type);
 void DataManager_collect(service_t *service)
 {
     msg_t update_msg;
-    search_result_t result;
+    static search_result_t result;
 #ifdef GATE_POLLING
     update_msg.header.cmd         = GET_CMD;
     update_msg.header.target_mode = SERVICEID;
@@ -25,16 +25,16 @@ void DataManager_collect(service_t *service)
 #else
     update_msg.header.target_mode = SERVICEIDACK;
 #endif
-    RTFilter_Reset(&result);
+    RTFilter_Refresh(&result, NULL);
     // ask services to publish datas
-    for (uint8_t i = 0; i < result.result_nbr; i++)
+    for (uint16_t i = 0; i < result.result_nbr; i++)
     {
         // Check if this service is a sensor
-        if ((DataManager_ServiceIsSensor(result.result_table[i]->type)) || (result.result_table[i]->type >= LUOS_LAST_TYPE))
+        if ((DataManager_ServiceIsSensor(RTFilter_GetEntry(&result, i)->type)) || (RTFilter_GetEntry(&result, i)->type >= LUOS_LAST_TYPE))
         {
 #ifdef GATE_POLLING
             // This service is a sensor so create a msg and send it
-            update_msg.header.target = result.result_table[i]->id;
+            update_msg.header.target = RTFilter_GetEntry(&result, i)->id;
             Luos_SendMsg(service, &update_msg);
     #ifdef GATE_TIMEOUT
             // Get the current number of message available
@@ -49,7 +49,7 @@ void DataManager_collect(service_t *service)
     #endif
 #else
             // This service is a sensor so create a msg to enable auto update
-            update_msg.header.target = result.result_table[i]->id;
+            update_msg.header.target = RTFilter_GetEntry(&result, i)->id;
             TimeOD_TimeToMsg(&update_time, &update_msg);
             update_msg.header.cmd = UPDATE_PUB;
             Luos_SendMsg(service, &update_msg);
@@ -90,7 +90,7 @@ void DataManager_RunPipeOnly(service_t *service)
             PipeLink_SetDirectPipeSend((void *)pointer);
             continue;
         }
-        if (Luos_ReceiveData(service, data_msg, data_cmd) > 0)
+        if (Luos_ReceiveData(service, data_msg, data_cmd, GATE_BUFF_SIZE) > 0)
         {
             // We finish to receive this data, execute the received command
             Convert_DataToLuos(service, data_cmd);
@@ -129,9 +129,10 @@ void DataManager_Format(service_t *service)
     msg_t *data_msg      = 0;
     uint8_t data_ok      = false;
     uint8_t boot_data_ok = false;
-    search_result_t result;
+    static search_result_t result;
 
-    RTFilter_Reset(&result);
+    // Only scan the routing table again if it changed
+    RTFilter_Refresh(&result, NULL);
 
     if ((Luos_NbrAvailableMsg() > 0))
     {
@@ -142,7 +143,7 @@ void DataManager_Format(service_t *service)
         int i = 0;
         while (i < result.result_nbr)
         {
-            if (Luos_ReadFromService(service, result.result_table[i]->id, &data_msg) == SUCCEED)
+            if (Luos_ReadFromService(service, RTFilter_GetEntry(&result, i)->id, &data_msg) == SUCCEED)
             {
                 // check if this is an assert
                 if (data_msg->header.cmd == ASSERT)
@@ -181,7 +182,7 @@ void DataManager_Format(service_t *service)
                         // This message is a command from pipe
                         static char data_cmd[GATE_BUFF_SIZE];
                         // Convert the received data into Luos commands
-                        if (Luos_ReceiveData(service, data_msg, data_cmd) > 0)
+                        if (Luos_ReceiveData(service, data_msg, data_cmd, GATE_BUFF_SIZE) > 0)
                         {
                             // We finish to receive this data, execute the received command
                             if (data_msg->header.cmd == SET_CMD)
@@ -196,7 +197,7 @@ void DataManager_Format(service_t *service)
                 // get the source of this message
                 // Create service description
                 char *alias;
-                alias = result.result_table[i]->alias;
+                alias = RTFilter_GetEntry(&result, i)->alias;
                 LUOS_ASSERT(alias != 0);
                 data_ok = true;
                 data_ptr += Convert_StartServiceData(data_ptr, alias);
@@ -78,13 +78,13 @@ void Gate_Loop(void)
                     // This is the first time we perform a convertion
     #ifdef GATE_REFRESH_AUTOSCALE
                     // Evaluate the time needed to convert all the data of this configuration and update refresh rate
-                    search_result_t result;
-                    RTFilter_Reset(&result);
+                    static search_result_t result;
+                    RTFilter_Refresh(&result, NULL);
                     // find the biggest id
-                    if (result.result_table[result.result_nbr - 1]->id)
+                    if (RTFilter_GetEntry(&result, result.result_nbr - 1)->id)
                     {
                         // update time is related to the biggest id
-                        update_time = TimeOD_TimeFrom_s((float)result.result_table[result.result_nbr - 1]->id * 0.001);
+                        update_time = TimeOD_TimeFrom_s((float)RTFilter_GetEntry(&result, result.result_nbr - 1)->id * 0.001);
                     }
                     else
                     {
@@ -10,6 +10,7 @@
  ******************************************************************************/
 #define MAX_ASSERT_NUMBER  3
 #define MAX_TOTAL_MSG_SIZE 135
+#define RTB_CHUNK_ENTRY_NB 8 // Routing table entries sent to the pipe at once
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -31,7 +32,10 @@ uint8_t assert_buf_size[MAX_ASSERT_NUMBER] = {0};
 void DataManager_SendRoutingTB(service_t *service)
 {
     search_result_t result;
-    uint8_t data[MAX_RTB_ENTRY * sizeof(routing_table_t)] = {0};
+    uint8_t data[sizeof(header_t) + RTB_CHUNK_ENTRY_NB * sizeof(routing_table_t)] = {0};
+    uint16_t entry_nb  = RoutingTB_GetLastEntry();
+    uint16_t chunk_nb  = 0;
+    uint16_t data_size = sizeof(header_t);
 
     RTFilter_Service(RTFilter_Reset(&result), service);
     // store the address of the RoutingTB
@@ -40,14 +44,25 @@ void DataManager_SendRoutingTB(service_t *service)
     msg.header.config      = BASE_PROTOCOL;
     msg.header.target      = DEFAULTID;
     msg.header.target_mode = SERVICEID;
-    msg.header.source      = result.result_table[0]->id;
+    msg.header.source      = RTFilter_GetEntry(&result, 0)->id;
     msg.header.cmd         = RTB;
-    msg.header.size        = RoutingTB_GetLastEntry() * sizeof(routing_table_t);
+    msg.header.size        = entry_nb * sizeof(routing_table_t);
+    // Check header size overflow
+    LUOS_ASSERT(((uint32_t)entry_nb * sizeof(routing_table_t)) <= 0xFFFF);
 
+    // The pipe forwards a byte stream, send the header with the first entries then the next ones chunk by chunk
     memcpy(data, msg.stream, sizeof(header_t));
-    memcpy(&data[sizeof(header_t)], routing_table, msg.header.size);
-
-    PipeLink_Send(service, data, msg.header.size + sizeof(header_t));
+    for (uint16_t entry = 0; entry < entry_nb; entry += chunk_nb)
+    {
+        chunk_nb = ((entry_nb - entry) > RTB_CHUNK_ENTRY_NB) ? RTB_CHUNK_ENTRY_NB : (entry_nb - entry);
+        memcpy(&data[data_size], &routing_table[entry], chunk_nb * sizeof(routing_table_t));
+        PipeLink_Send(service, data, data_size + chunk_nb * sizeof(routing_table_t));
+        data_size = 0;
+    }
+    if (entry_nb == 0)
+    {
+        PipeLink_Send(service, data, data_size);
+    }
 }
 /******************************************************************************
  * @brief extract the command value for the pipe messages
@@ -112,6 +127,14 @@ void DataManager_GetPipeMsg(service_t *service, msg_t *data_msg)
             msg.header.size        = 0;
             Luos_SendMsg(service, &msg);
             break;
+        case LUOS_PROFILE:
+            // extract service that we want the execution time profile
+            msg.header.target      = (data_msg->data[8] << 8) + data_msg->data[7];
+            msg.header.target_mode = SERVICEID;
+            msg.header.cmd         = LUOS_PROFILE;
+            msg.header.size        = 0;
+            Luos_SendMsg(service, &msg);
+            break;
         case LUOS_REVISION:
             // extract service that we want the luos revision
             msg.header.target      = (data_msg->data[8] << 8) + data_msg->data[7];
@@ -168,14 +191,15 @@ void DataManager_GetServiceMsg(service_t *service)
 {
     // loop into services.
     msg_t *data_msg;
-    search_result_t result;
-    uint8_t i = 0;
+    static search_result_t result;
+    uint16_t i = 0;
 
-    RTFilter_Reset(&result);
+    // Only scan the routing table again if it changed
+    RTFilter_Refresh(&result, NULL);
     while (i < result.result_nbr)
     {
         // pull available messages
-        if (Luos_ReadFromService(service, result.result_table[i]->id, &data_msg) == SUCCEED)
+        if (Luos_ReadFromService(service, RTFilter_GetEntry(&result, i)->id, &data_msg) == SUCCEED)
         {
             // drop the messages that are destined to pipe
             if (data_msg->header.target == PipeLink_GetId())
@@ -55,9 +55,12 @@ void PipeLink_Send(service_t *service, void *data, uint32_t size)
 uint16_t PipeLink_Find(service_t *service)
 {
     search_result_t result;
-    uint8_t localhost = false;
+    uint8_t localhost  = false;
+    rt_filter_t filter = {.criteria = FILTER_TYPE | FILTER_NODE,
+                          .type     = PIPE_TYPE,
+                          .node_id  = RoutingTB_NodeIDFromID(service->ll_service->id)};
     // search a pipe type in localhost
-    RTFilter_Node(RTFilter_Type(RTFilter_Reset(&result), PIPE_TYPE), RoutingTB_NodeIDFromID(service->ll_service->id));
+    RTFilter_Match(RTFilter_Reset(&result), &filter);
 
     if (result.result_nbr > 0)
     {
@@ -70,7 +73,7 @@ uint16_t PipeLink_Find(service_t *service)
         RTFilter_Type(RTFilter_Reset(&result), PIPE_TYPE);
     }
     // keep pipe_id
-    pipe_id = result.result_table[0]->id;
+    pipe_id = RTFilter_GetEntry(&result, 0)->id;
 
     if (pipe_id > 0)
     {